@@ -3,7 +3,8 @@ using Trixi
 using OrdinaryDiffEq
 
 # The function to create the simulation state needs to be named `init_simstate`
-function init_simstate()
+# The optional keyword arguments set the floating point types of the solver and the solution
+function init_simstate(; RealT = Float64, uEltype = RealT)
 
     ###############################################################################
     # semidiscretization of the linear advection equation
@@ -12,7 +13,7 @@ function init_simstate()
     equations = LinearScalarAdvectionEquation1D(advection_velocity)
 
     # Create DG solver with polynomial degree = 3 and (local) Lax-Friedrichs/Rusanov flux as surface flux
-    solver = DGSEM(polydeg=3, surface_flux=flux_lax_friedrichs)
+    solver = DGSEM(RealT=RealT, polydeg=3, surface_flux=flux_lax_friedrichs)
 
     coordinates_min = -1.0 # minimum coordinate
     coordinates_max =  1.0 # maximum coordinate
@@ -23,7 +24,8 @@ function init_simstate()
                     n_cells_max=30_000) # set maximum capacity of tree data structure
 
     # A semidiscretization collects data structures and functions for the spatial discretization
-    semi = SemidiscretizationHyperbolic(mesh, equations, initial_condition_convergence_test, solver)
+    semi = SemidiscretizationHyperbolic(mesh, equations, initial_condition_convergence_test, solver,
+                                        uEltype=uEltype)
 
 
 
@@ -53,8 +53,10 @@ header_files = [joinpath(dirname(dirname(@__DIR__)), "src", "trixi.h")]
 
 # Name of the files that include the initialization functions:
 # - `init.c` contains `trixi_initialize`/`trixi_finalize` for API compatibility
+# - `signals.c` contains the thread that waits for preemption signals
 # - the other file contains the `init_julia`/`shutdown_julia` functions from PackageCompiler
-julia_init_c_file = ["init.c", PackageCompiler.default_julia_init()]
+julia_init_c_file = ["init.c", joinpath(dirname(dirname(@__DIR__)), "src", "signals.c"),
+                     PackageCompiler.default_julia_init()]
 
 # Extract version from `Project.toml`
 project_toml = joinpath(package_or_project_dir, "Project.toml")
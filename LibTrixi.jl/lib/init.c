@@ -3,6 +3,8 @@
 #include <string.h>
 #include <julia_init.h>
 
+#include "../../src/signals.h"
+
 // Track initialization/finalization status to prevent unhelpful errors
 static int is_initialized = 0;
 static int is_finalized = 0;
@@ -33,6 +35,9 @@ void trixi_initialize(const char * project_directory__unused,
       printf("trixi_initialize: 'depot_path' is non-null but will not be used\n");
     }
 
+    // Start waiting for preemption signals ahead of Julia's signal listener
+    start_signal_thread();
+
     // Init Julia (do not pass command line arguments)
     int argc = 0;
     char** argv = NULL;
@@ -1,15 +1,31 @@
 module LibTrixi
 
-using OrdinaryDiffEq: OrdinaryDiffEq, step!, check_error, DiscreteCallback
+using OrdinaryDiffEq: OrdinaryDiffEq, step!, check_error, DiscreteCallback, u_modified!,
+                      add_tstop!, init, CallbackSet, ODEProblem, reinit!, set_t!
 using Trixi: Trixi, summary_callback, mesh_equations_solver_cache, ndims, nelements,
              nelementsglobal, ndofs, ndofsglobal, nvariables, nnodes, wrap_array,
              eachelement, cons2prim, get_node_vars, eachnode
 using MPI: MPI, run_init_hooks, set_default_error_handler_return
+using HDF5: HDF5, h5open, create_group, create_dataset, datatype, dataspace, attributes
+using Mmap: Mmap
+using Serialization: Serialization
 using Pkg
 
 export trixi_initialize_simulation,
        trixi_initialize_simulation_cfptr,
        trixi_initialize_simulation_jl
+export trixi_initialize_simulation_f32,
+       trixi_initialize_simulation_f32_cfptr,
+       trixi_initialize_simulation_f32_jl
+export trixi_reinitialize,
+       trixi_reinitialize_cfptr,
+       trixi_reinitialize_jl
+export trixi_set_initial_state,
+       trixi_set_initial_state_cfptr,
+       trixi_set_initial_state_jl
+export trixi_get_setup_time,
+       trixi_get_setup_time_cfptr,
+       trixi_get_setup_time_jl
 export trixi_finalize_simulation,
        trixi_finalize_simulation_cfptr,
        trixi_finalize_simulation_jl
@@ -19,9 +35,60 @@ export trixi_calculate_dt,
 export trixi_is_finished,
        trixi_is_finished_cfptr,
        trixi_is_finished_jl
+export trixi_is_preempted,
+       trixi_is_preempted_cfptr,
+       trixi_is_preempted_jl
 export trixi_step,
        trixi_step_cfptr,
        trixi_step_jl
+export trixi_scheduler_run,
+       trixi_scheduler_run_cfptr,
+       trixi_scheduler_run_jl
+export trixi_set_polydeg,
+       trixi_set_polydeg_cfptr,
+       trixi_set_polydeg_jl
+export trixi_set_amr_autotuning,
+       trixi_set_amr_autotuning_cfptr,
+       trixi_set_amr_autotuning_jl
+export trixi_get_amr_interval,
+       trixi_get_amr_interval_cfptr,
+       trixi_get_amr_interval_jl
+export trixi_set_straggler_watchdog,
+       trixi_set_straggler_watchdog_cfptr,
+       trixi_set_straggler_watchdog_jl
+export trixi_set_preemption,
+       trixi_set_preemption_cfptr,
+       trixi_set_preemption_jl
+export trixi_set_health_check,
+       trixi_set_health_check_cfptr,
+       trixi_set_health_check_jl
+export trixi_get_health_status,
+       trixi_get_health_status_cfptr,
+       trixi_get_health_status_jl
+export trixi_set_energy_accounting,
+       trixi_set_energy_accounting_cfptr,
+       trixi_set_energy_accounting_jl
+export trixi_get_energy_stats,
+       trixi_get_energy_stats_cfptr,
+       trixi_get_energy_stats_jl
+export trixi_place_numa,
+       trixi_place_numa_cfptr,
+       trixi_place_numa_jl
+export trixi_get_numa_placement,
+       trixi_get_numa_placement_cfptr,
+       trixi_get_numa_placement_jl
+export trixi_set_deferred_teardown,
+       trixi_set_deferred_teardown_cfptr,
+       trixi_set_deferred_teardown_jl
+export trixi_collect_garbage,
+       trixi_collect_garbage_cfptr,
+       trixi_collect_garbage_jl
+export trixi_set_background_compilation,
+       trixi_set_background_compilation_cfptr,
+       trixi_set_background_compilation_jl
+export trixi_create_ensemble,
+       trixi_create_ensemble_cfptr,
+       trixi_create_ensemble_jl
 export trixi_ndims,
        trixi_ndims_cfptr,
        trixi_ndims_jl
@@ -43,6 +110,9 @@ export trixi_ndofselement,
 export trixi_nvariables,
        trixi_nvariables_cfptr,
        trixi_nvariables_jl
+export trixi_nmembers,
+       trixi_nmembers_cfptr,
+       trixi_nmembers_jl
 export trixi_nnodes,
        trixi_nnodes_cfptr,
        trixi_nnodes_jl
@@ -55,12 +125,45 @@ export trixi_load_node_weights,
 export trixi_load_primitive_vars,
        trixi_load_primitive_vars_cfptr,
        trixi_load_primitive_vars_jl
+export trixi_load_primitive_vars_f32,
+       trixi_load_primitive_vars_f32_cfptr
+export trixi_load_member_primitive_vars,
+       trixi_load_member_primitive_vars_cfptr,
+       trixi_load_member_primitive_vars_jl
+export trixi_store_member_conservative_vars,
+       trixi_store_member_conservative_vars_cfptr,
+       trixi_store_member_conservative_vars_jl
 export trixi_load_element_averaged_primitive_vars,
        trixi_load_element_averaged_primitive_vars_cfptr,
        trixi_load_element_averaged_primitive_vars_jl
+export trixi_load_element_averaged_primitive_vars_f32,
+       trixi_load_element_averaged_primitive_vars_f32_cfptr
+export trixi_define_output_variable,
+       trixi_define_output_variable_cfptr,
+       trixi_define_output_variable_jl
+export trixi_define_output_variable_callback,
+       trixi_define_output_variable_callback_cfptr,
+       trixi_define_output_variable_callback_jl
+export trixi_load_variable,
+       trixi_load_variable_cfptr,
+       trixi_load_variable_jl
+export trixi_set_element_ordering,
+       trixi_set_element_ordering_cfptr,
+       trixi_set_element_ordering_jl
+export trixi_foreach_element_block,
+       trixi_foreach_element_block_cfptr,
+       trixi_foreach_element_block_jl
 export trixi_register_data,
        trixi_register_data_cfptr,
        trixi_register_data_jl
+export trixi_register_data_f32,
+       trixi_register_data_f32_cfptr
+export trixi_set_buffer_storage,
+       trixi_set_buffer_storage_cfptr,
+       trixi_set_buffer_storage_jl
+export trixi_allocate_data,
+       trixi_allocate_data_cfptr,
+       trixi_allocate_data_jl
 export trixi_version_library,
        trixi_version_library_cfptr,
        trixi_version_library_jl
@@ -82,15 +185,51 @@ export trixi_version_julia_extended,
 export trixi_get_t8code_forest,
        trixi_get_t8code_forest_cfptr,
        trixi_get_t8code_forest_jl
+export trixi_set_allocator,
+       trixi_set_allocator_cfptr,
+       trixi_set_allocator_jl
 export trixi_eval_julia,
        trixi_eval_julia_cfptr,
        trixi_eval_julia_jl
 export trixi_get_simulation_time,
        trixi_get_simulation_time_cfptr,
        trixi_get_simulation_time_jl
+export trixi_save_vtkhdf,
+       trixi_save_vtkhdf_cfptr,
+       trixi_save_vtkhdf_jl
+export trixi_set_output_aggregation,
+       trixi_set_output_aggregation_cfptr,
+       trixi_set_output_aggregation_jl
+export trixi_set_shm_publication,
+       trixi_set_shm_publication_cfptr,
+       trixi_set_shm_publication_jl
+export trixi_create_nesting,
+       trixi_create_nesting_cfptr,
+       trixi_create_nesting_jl
+export trixi_nesting_interpolate,
+       trixi_nesting_interpolate_cfptr,
+       trixi_nesting_interpolate_jl
+export trixi_nesting_feedback,
+       trixi_nesting_feedback_cfptr,
+       trixi_nesting_feedback_jl
+export trixi_finalize_nesting,
+       trixi_finalize_nesting_cfptr,
+       trixi_finalize_nesting_jl
+export trixi_transfer_solution,
+       trixi_transfer_solution_cfptr,
+       trixi_transfer_solution_jl
+export trixi_set_log_sink,
+       trixi_set_log_sink_cfptr,
+       trixi_set_log_sink_jl
+export trixi_log_message,
+       trixi_log_message_cfptr,
+       trixi_log_message_jl
 
 export SimulationState, store_simstate, load_simstate, delete_simstate!
-export LibTrixiDataRegistry
+export LibTrixiDataRegistry, LibTrixiDataRegistryF32
+export semidiscretize_threaded, setup_phase
+export EnsembleEquations
+export Nesting, store_nesting, load_nesting, delete_nesting!
 
 
 # global storage of name and version information of loaded packages
@@ -143,7 +282,30 @@ const _version_libtrixi = begin
 end
 
 
+include("logging.jl")
+include("watchdog.jl")
+include("preemption.jl")
+include("healthcheck.jl")
+include("energy.jl")
+include("numa.jl")
+include("outputvariables.jl")
+include("elementordering.jl")
+include("storage.jl")
+include("sharedmemory.jl")
+include("teardown.jl")
+include("compilation.jl")
+include("setup.jl")
 include("simulationstate.jl")
+include("vtkhdf.jl")
+include("pointlocation.jl")
+include("nesting.jl")
+include("transfer.jl")
+include("scheduler.jl")
+include("polydeg.jl")
+include("autotune.jl")
+include("precision.jl")
+include("ensemble.jl")
+include("reinitialize.jl")
 include("api_c.jl")
 include("api_jl.jl")
 
@@ -171,6 +333,11 @@ function __init__()
     if show_debug_output()
         MPI.set_default_error_handler_return()
     end
+    # Stop calling the log sink of the host before Julia shuts down
+    atexit(() -> set_log_sink!(nothing))
+    # Release simulations with deferred teardown while MPI is still available (hooks run in
+    # reverse order, thus still with the log sink)
+    atexit(collect_garbage_at_exit)
 end
 
 end # module LibTrixi
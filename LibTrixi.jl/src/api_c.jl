@@ -188,6 +188,86 @@ function trixi_initialize_simulation(libelixir::String)
 end
 
 
+"""
+    trixi_initialize_simulation_f32(libelixir::Cstring, geometry_f64::Cint)::Cint
+
+Initialize a new simulation like [`trixi_initialize_simulation`](@ref), but store the
+solution in single precision (`Float32`).
+
+If `geometry_f64` is nonzero, the DGSEM basis and the geometric data derived from it are
+kept in double precision (mixed precision), otherwise they are converted to single
+precision as well. Use the `_f32` variants of the data access functions to exchange single
+precision data without conversion on the C side.
+
+The libelixir sets up the simulation directly in the requested precision if its function
+`init_simstate` accepts the keyword arguments `RealT` (basis and geometry) and `uEltype`
+(solution), e.g., `init_simstate(; RealT = Float64, uEltype = RealT)`. Otherwise, the
+simulation is set up in double precision first and then converted with
+[`set_precision`](@ref), which temporarily needs the memory of both setups and does not
+apply to data that the libelixir computes in double precision outside the solver.
+"""
+function trixi_initialize_simulation_f32 end
+
+Base.@ccallable function trixi_initialize_simulation_f32(libelixir::Cstring,
+                                                         geometry_f64::Cint)::Cint
+    # Create string from Cstring
+    filename = unsafe_string(libelixir)
+
+    # Create new simulation state and store in global dict
+    simstate = trixi_initialize_simulation_f32_jl(filename, geometry_f64 != 0)
+    simstate_handle = store_simstate(simstate)
+
+    # Return handle for usage/storage on C side
+    return simstate_handle
+end
+
+trixi_initialize_simulation_f32_cfptr() =
+    @cfunction(trixi_initialize_simulation_f32, Cint, (Cstring, Cint,))
+
+
+"""
+    trixi_get_setup_time(simstate_handle::Cint, phase::Cstring)::Cdouble
+
+Return the wall time in seconds of the initialization phase `phase` of the simulation, or
+`NaN` if no such phase was recorded. With MPI, this is the time on the calling rank.
+
+The phases recorded by [`trixi_initialize_simulation`](@ref) are `libelixir` (loading the
+libelixir), `init_simstate` (running its setup function), `background_compilation` (waiting
+for [`trixi_set_background_compilation`](@ref)), and `total`. Libelixirs that use
+[`semidiscretize_threaded`](@ref) add `initial_condition` and `initial_amr`, and further
+phases can be timed with [`setup_phase`](@ref). The phases listed here and `mesh` are also
+logged at the end of the setup, with the maximum time of all ranks.
+"""
+function trixi_get_setup_time end
+
+Base.@ccallable function trixi_get_setup_time(simstate_handle::Cint,
+                                              phase::Cstring)::Cdouble
+    simstate = load_simstate(simstate_handle)
+    return trixi_get_setup_time_jl(simstate, unsafe_string(phase))
+end
+
+trixi_get_setup_time_cfptr() = @cfunction(trixi_get_setup_time, Cdouble, (Cint, Cstring,))
+
+
+# Convenience function when using this directly from Julia
+function trixi_initialize_simulation_f32(libelixir::String, geometry_f64::Bool)
+    # Convert string to byte array
+    bytes = Vector{UInt8}(libelixir)
+
+    # Make it a proper, NULL-terminated C-style char array
+    push!(bytes, '\0')
+
+    # Call `trixi_initialize_simulation_f32` above with a raw pointer to the bytes array,
+    # which needs to be protected from garbage collection
+    GC.@preserve bytes begin
+        simstate_handle = trixi_initialize_simulation_f32(Cstring(pointer(bytes)),
+                                                          Cint(geometry_f64))
+    end
+
+    return simstate_handle
+end
+
+
 """
     trixi_is_finished(simstate_handle::Cint)::Cint
 
@@ -205,6 +285,23 @@ end
 trixi_is_finished_cfptr() = @cfunction(trixi_is_finished, Cint, (Cint,))
 
 
+"""
+    trixi_is_preempted(simstate_handle::Cint)::Cint
+
+Return `1` if the simulation was stopped early due to preemption (see
+[`trixi_set_preemption`](@ref)), and `0` otherwise.
+"""
+function trixi_is_preempted end
+
+Base.@ccallable function trixi_is_preempted(simstate_handle::Cint)::Cint
+    simstate = load_simstate(simstate_handle)
+    is_preempted = trixi_is_preempted_jl(simstate)
+    return is_preempted ? 1 : 0
+end
+
+trixi_is_preempted_cfptr() = @cfunction(trixi_is_preempted, Cint, (Cint,))
+
+
 """
     trixi_step(simstate_handle::Cint)::Cvoid
 
@@ -222,10 +319,523 @@ end
 trixi_step_cfptr() = @cfunction(trixi_step, Cvoid, (Cint,))
 
 
+"""
+    trixi_scheduler_run(nhandles::Cint, handles::Ptr{Cint}, sync_interval::Cdouble,
+                        coupling::Ptr{Cvoid}, userdata::Ptr{Cvoid})::Cvoid
+
+Advance the `nhandles` simulations given in `handles` until all of them are finished.
+
+Each simulation is advanced with its own time step to common synchronization times, which
+are `sync_interval` apart. At every synchronization time, the C function `coupling` is
+called as `coupling(time, userdata)` (unless it is a null pointer) and may, e.g., exchange
+data between the simulations. Between synchronization times, the simulations are advanced
+concurrently on Julia threads if possible, see [`run_scheduler`](@ref).
+"""
+function trixi_scheduler_run end
+
+Base.@ccallable function trixi_scheduler_run(nhandles::Cint, handles::Ptr{Cint},
+                                             sync_interval::Cdouble,
+                                             coupling::Ptr{Cvoid},
+                                             userdata::Ptr{Cvoid})::Cvoid
+    simstates = [load_simstate(handle) for handle in unsafe_wrap(Array, handles, nhandles)]
+
+    if coupling == C_NULL
+        trixi_scheduler_run_jl(simstates, sync_interval)
+    else
+        coupling_jl = t -> ccall(coupling, Cvoid, (Cdouble, Ptr{Cvoid}), t, userdata)
+        trixi_scheduler_run_jl(simstates, sync_interval, coupling_jl)
+    end
+
+    return nothing
+end
+
+trixi_scheduler_run_cfptr() =
+    @cfunction(trixi_scheduler_run, Cvoid,
+               (Cint, Ptr{Cint}, Cdouble, Ptr{Cvoid}, Ptr{Cvoid},))
+
+
+"""
+    trixi_set_polydeg(simstate_handle::Cint, polydeg::Cint)::Cvoid
+
+Change the polynomial degree of the DGSEM solver to `polydeg`.
+
+Basis, solver cache, and time integrator are rebuilt for the new degree, and the solution
+is projected to the new basis (see [`set_polydeg`](@ref)). All registered data vectors are
+removed from the registry, since they may depend on the old nodes: host memory is no longer
+referenced, and pointers returned by [`trixi_allocate_data`](@ref) become invalid. Data
+has to be registered or allocated again at the same indices, otherwise [`trixi_step`](@ref)
+fails. The handle remains valid.
+With MPI, this function has to be called collectively.
+"""
+function trixi_set_polydeg end
+
+Base.@ccallable function trixi_set_polydeg(simstate_handle::Cint, polydeg::Cint)::Cvoid
+    simstate = load_simstate(simstate_handle)
+    simstate_new = trixi_set_polydeg_jl(simstate, polydeg)
+
+    # Keep the handle, but let it and all nestings refer to the rebuilt simulation state
+    replace_simstate!(simstate_handle, simstate_new)
+    replace_nested_simstate!(simstate, simstate_new)
+
+    return nothing
+end
+
+trixi_set_polydeg_cfptr() = @cfunction(trixi_set_polydeg, Cvoid, (Cint, Cint,))
+
+
+"""
+    trixi_set_amr_autotuning(simstate_handle::Cint, min_interval::Cint,
+                             max_interval::Cint, target_overhead::Cdouble)::Cvoid
+
+Tune the interval of the AMR callback online within `[min_interval, max_interval]`, or
+restore the fixed interval of the simulation setup if `min_interval` is not positive.
+
+After each adaptation, the interval is doubled if the mesh did not change, increased by one
+if the adaptation time amortized over the interval exceeds `target_overhead` times the
+regular step time, and decreased by one otherwise. Every change is reported as a log
+message, and the current interval is returned by [`trixi_get_amr_interval`](@ref). See
+[`AMRAutotuner`](@ref) for details. The time integrator is recreated for this, but the
+handle remains valid. With MPI, this function has to be called collectively.
+"""
+function trixi_set_amr_autotuning end
+
+Base.@ccallable function trixi_set_amr_autotuning(simstate_handle::Cint,
+                                                  min_interval::Cint, max_interval::Cint,
+                                                  target_overhead::Cdouble)::Cvoid
+    simstate = load_simstate(simstate_handle)
+    simstate_new = trixi_set_amr_autotuning_jl(simstate, min_interval, max_interval,
+                                               target_overhead)
+
+    # Keep the handle, but let it and all nestings refer to the new simulation state
+    replace_simstate!(simstate_handle, simstate_new)
+    replace_nested_simstate!(simstate, simstate_new)
+
+    return nothing
+end
+
+trixi_set_amr_autotuning_cfptr() =
+    @cfunction(trixi_set_amr_autotuning, Cvoid, (Cint, Cint, Cint, Cdouble,))
+
+
+"""
+    trixi_get_amr_interval(simstate_handle::Cint)::Cint
+
+Return the current interval (in steps) of the AMR callback, which changes over time if
+[`trixi_set_amr_autotuning`](@ref) is enabled.
+"""
+function trixi_get_amr_interval end
+
+Base.@ccallable function trixi_get_amr_interval(simstate_handle::Cint)::Cint
+    simstate = load_simstate(simstate_handle)
+    return trixi_get_amr_interval_jl(simstate)
+end
+
+trixi_get_amr_interval_cfptr() = @cfunction(trixi_get_amr_interval, Cint, (Cint,))
+
+
+"""
+    trixi_set_straggler_watchdog(simstate_handle::Cint, interval::Cint,
+                                 threshold::Cdouble, report::Ptr{Cvoid},
+                                 userdata::Ptr{Cvoid})::Cvoid
+
+Enable a watchdog that detects slow ranks (stragglers), or disable it if `interval` is not
+positive.
+
+During each step, the time spent on computation is measured on every rank. Every `interval`
+steps, these compute times are gathered on the root rank without blocking. Ranks whose
+compute time exceeds `threshold` times the median are reported on the root rank by calling
+the C function `report` as `report(rank, compute_time, median_time, userdata)`. If `report`
+is a null pointer, a line is printed instead. See [`StragglerWatchdog`](@ref) for details.
+"""
+function trixi_set_straggler_watchdog end
+
+Base.@ccallable function trixi_set_straggler_watchdog(simstate_handle::Cint,
+                                                      interval::Cint, threshold::Cdouble,
+                                                      report::Ptr{Cvoid},
+                                                      userdata::Ptr{Cvoid})::Cvoid
+    simstate = load_simstate(simstate_handle)
+
+    if report == C_NULL
+        trixi_set_straggler_watchdog_jl(simstate, interval, threshold)
+    else
+        function report_jl(rank, compute_time, median_time)
+            ccall(report, Cvoid, (Cint, Cdouble, Cdouble, Ptr{Cvoid}),
+                  rank, compute_time, median_time, userdata)
+        end
+        trixi_set_straggler_watchdog_jl(simstate, interval, threshold, report_jl)
+    end
+
+    return nothing
+end
+
+trixi_set_straggler_watchdog_cfptr() =
+    @cfunction(trixi_set_straggler_watchdog, Cvoid,
+               (Cint, Cint, Cdouble, Ptr{Cvoid}, Ptr{Cvoid},))
+
+
+"""
+    trixi_set_preemption(simstate_handle::Cint, walltime_budget::Cdouble,
+                         handle_signals::Cint, checkpoint_directory::Cstring)::Cvoid
+
+Stop the simulation with a checkpoint before it is preempted or runs out of wall time.
+
+After each step, all ranks check whether `handle_signals` is nonzero and `SIGTERM` or
+`SIGUSR1` was received on any rank, or whether the next step would exceed the wall-time
+budget of `walltime_budget` seconds (counted from this call, ignored if not positive). If
+so, a restart file and the mesh are written to `checkpoint_directory`, and
+[`trixi_is_finished`](@ref) as well as [`trixi_is_preempted`](@ref) return `1` from then on.
+While any simulation handles signals, these two signals are received by a thread of the C
+library instead of terminating the process. Finalizing the simulation hands them back to
+Julia. See [`Preemption`](@ref) and [`watch_signals!`](@ref) for details.
+
+With MPI, this function has to be called collectively.
+"""
+function trixi_set_preemption end
+
+Base.@ccallable function trixi_set_preemption(simstate_handle::Cint,
+                                              walltime_budget::Cdouble,
+                                              handle_signals::Cint,
+                                              checkpoint_directory::Cstring)::Cvoid
+    simstate = load_simstate(simstate_handle)
+    directory = unsafe_string(checkpoint_directory)
+
+    trixi_set_preemption_jl(simstate, walltime_budget, directory, handle_signals != 0)
+
+    return nothing
+end
+
+trixi_set_preemption_cfptr() =
+    @cfunction(trixi_set_preemption, Cvoid, (Cint, Cdouble, Cint, Cstring,))
+
+
+"""
+    trixi_set_health_check(simstate_handle::Cint, interval::Cint, action::Cint,
+                           n_report::Cint)::Cvoid
+
+Check the solution for non-finite values and, if the equations define them, for
+non-positive density and pressure every `interval` steps, or disable the check if `interval`
+is not positive. The first `n_report` (at least one) offending elements of each rank are
+logged with their coordinates. Depending on `action`, the simulation then continues (`0`),
+is stopped (`1`), or is rolled back to the solution before the offending step and stopped
+(`2`). A stopped simulation is reported as finished by [`trixi_is_finished`](@ref), and the
+reason is returned by [`trixi_get_health_status`](@ref). See [`HealthCheck`](@ref) for
+details.
+
+With MPI, this function has to be called collectively.
+"""
+function trixi_set_health_check end
+
+Base.@ccallable function trixi_set_health_check(simstate_handle::Cint, interval::Cint,
+                                                action::Cint, n_report::Cint)::Cvoid
+    simstate = load_simstate(simstate_handle)
+    trixi_set_health_check_jl(simstate, interval, action, n_report)
+    return nothing
+end
+
+trixi_set_health_check_cfptr() =
+    @cfunction(trixi_set_health_check, Cvoid, (Cint, Cint, Cint, Cint,))
+
+
+"""
+    trixi_get_health_status(simstate_handle::Cint)::Cint
+
+Return the status found by the first failed health check (see
+[`trixi_set_health_check`](@ref)): `3` for non-finite values, `2` for non-positive density,
+`1` for non-positive pressure, and `0` if all checks passed or the check is disabled. With
+MPI, the most severe status of all ranks is returned on every rank.
+"""
+function trixi_get_health_status end
+
+Base.@ccallable function trixi_get_health_status(simstate_handle::Cint)::Cint
+    simstate = load_simstate(simstate_handle)
+    return trixi_get_health_status_jl(simstate)
+end
+
+trixi_get_health_status_cfptr() = @cfunction(trixi_get_health_status, Cint, (Cint,))
+
+
+"""
+    trixi_set_energy_accounting(simstate_handle::Cint, enabled::Cint)::Cvoid
+
+Enable or disable energy accounting for [`trixi_step`](@ref).
+
+If enabled, the energy consumed during each step is measured with the RAPL counters of the
+Linux powercap interface (`/sys/class/powercap`). The counters cover whole CPU packages, so
+they are read by one rank per compute node. If they are not readable on all nodes, no
+energy is recorded and [`trixi_get_energy_stats`](@ref) reports them as unavailable.
+Enabling the accounting again resets the statistics. The statistics are also reported in
+the summary output when the simulation is finalized. With MPI, this function has to be
+called collectively by all ranks.
+"""
+function trixi_set_energy_accounting end
+
+Base.@ccallable function trixi_set_energy_accounting(simstate_handle::Cint,
+                                                     enabled::Cint)::Cvoid
+    simstate = load_simstate(simstate_handle)
+    trixi_set_energy_accounting_jl(simstate, enabled != 0)
+    return nothing
+end
+
+trixi_set_energy_accounting_cfptr() =
+    @cfunction(trixi_set_energy_accounting, Cvoid, (Cint, Cint,))
+
+
+"""
+    trixi_get_energy_stats(simstate_handle::Cint, energy::Ptr{Cdouble},
+                           energy_per_step::Ptr{Cdouble},
+                           energy_per_dof_update::Ptr{Cdouble})::Cint
+
+Return energy consumption since energy accounting was enabled.
+
+The energy in joules consumed on all nodes during all steps, the energy per step, and the
+energy per update of a single degree of freedom (based on the global number of degrees of
+freedom) are stored in `energy`, `energy_per_step`, and `energy_per_dof_update`. Returns
+`1` if energy counters are available and `0` otherwise, in which case all values are NaN.
+With MPI, this function has to be called collectively by all ranks.
+"""
+function trixi_get_energy_stats end
+
+Base.@ccallable function trixi_get_energy_stats(simstate_handle::Cint, energy::Ptr{Cdouble},
+                                                energy_per_step::Ptr{Cdouble},
+                                                energy_per_dof_update::Ptr{Cdouble})::Cint
+    simstate = load_simstate(simstate_handle)
+    stats = trixi_get_energy_stats_jl(simstate)
+
+    unsafe_store!(energy, stats.energy)
+    unsafe_store!(energy_per_step, stats.energy_per_step)
+    unsafe_store!(energy_per_dof_update, stats.energy_per_dof_update)
+
+    return stats.available ? 1 : 0
+end
+
+trixi_get_energy_stats_cfptr() =
+    @cfunction(trixi_get_energy_stats, Cint,
+               (Cint, Ptr{Cdouble}, Ptr{Cdouble}, Ptr{Cdouble},))
+
+
+"""
+    trixi_place_numa(simstate_handle::Cint)::Cvoid
+
+Place the solution, the stage vectors of the time integrator, and the solver cache on the
+NUMA nodes of the threads that process them.
+
+The memory pages are moved with the same partition of elements over threads as used by
+the threaded loops of Trixi.jl, which is equivalent to initializing them in parallel (first
+touch). This should be called right after the simulation is initialized, and again if
+arrays are reallocated, e.g., after AMR. Threads have to be pinned to cores for a lasting
+effect. On systems without NUMA support, nothing is done. See [`place_numa!`](@ref) for
+details.
+"""
+function trixi_place_numa end
+
+Base.@ccallable function trixi_place_numa(simstate_handle::Cint)::Cvoid
+    simstate = load_simstate(simstate_handle)
+    trixi_place_numa_jl(simstate)
+    return nothing
+end
+
+trixi_place_numa_cfptr() = @cfunction(trixi_place_numa, Cvoid, (Cint,))
+
+
+"""
+    trixi_get_numa_placement(simstate_handle::Cint, nnodes::Cint, pages::Ptr{Cint},
+                             local_fraction::Ptr{Cdouble})::Cint
+
+Return the number of NUMA nodes holding memory pages of the simulation on this rank.
+
+For the arrays considered by [`trixi_place_numa`](@ref), the number of pages on each of
+the first `nnodes` NUMA nodes is stored in `pages`, and the fraction of pages that reside
+on the node of the thread processing them is stored in `local_fraction`. Call with
+`nnodes = 0` to query the number of nodes first. Without NUMA support, `0` is returned and
+the fraction is NaN.
+"""
+function trixi_get_numa_placement end
+
+Base.@ccallable function trixi_get_numa_placement(simstate_handle::Cint, nnodes::Cint,
+                                                  pages::Ptr{Cint},
+                                                  local_fraction::Ptr{Cdouble})::Cint
+    simstate = load_simstate(simstate_handle)
+    placement = trixi_get_numa_placement_jl(simstate)
+
+    for node in 1:min(nnodes, length(placement.pages_per_node))
+        unsafe_store!(pages, placement.pages_per_node[node], node)
+    end
+    unsafe_store!(local_fraction, placement.local_fraction)
+
+    return length(placement.pages_per_node)
+end
+
+trixi_get_numa_placement_cfptr() =
+    @cfunction(trixi_get_numa_placement, Cint, (Cint, Cint, Ptr{Cint}, Ptr{Cdouble},))
+
+
+"""
+    trixi_set_deferred_teardown(enabled::Cint, batch_size::Cint)::Cvoid
+
+Defer the teardown of finalized simulations if `enabled` is nonzero, or free the memory
+whenever a simulation is finalized (default).
+
+With deferred teardown, [`trixi_finalize_simulation`](@ref) still releases the handle
+immediately, but the explicit finalization of p4est meshes and the full garbage collection
+are postponed until `batch_size` simulations have been finalized (never, if `batch_size`
+is not positive) or [`trixi_collect_garbage`](@ref) is called. This avoids a full garbage
+collection per simulation when many short simulations are run. Pending teardowns are
+processed when the mode is changed and by `trixi_finalize`. With MPI, this function has to
+be called collectively. See [`DeferredTeardown`](@ref) for details.
+"""
+function trixi_set_deferred_teardown end
+
+Base.@ccallable function trixi_set_deferred_teardown(enabled::Cint,
+                                                     batch_size::Cint)::Cvoid
+    trixi_set_deferred_teardown_jl(enabled != 0, batch_size)
+    return nothing
+end
+
+trixi_set_deferred_teardown_cfptr() =
+    @cfunction(trixi_set_deferred_teardown, Cvoid, (Cint, Cint,))
+
+
+"""
+    trixi_collect_garbage()::Cvoid
+
+Process all pending teardowns of finalized simulations and run a full garbage collection.
+
+This is the point at which the memory of simulations finalized with deferred teardown (see
+[`trixi_set_deferred_teardown`](@ref)) is freed. With MPI, this function has to be called
+collectively.
+"""
+function trixi_collect_garbage end
+
+Base.@ccallable function trixi_collect_garbage()::Cvoid
+    trixi_collect_garbage_jl()
+    return nothing
+end
+
+trixi_collect_garbage_cfptr() = @cfunction(trixi_collect_garbage, Cvoid, ())
+
+
+"""
+    trixi_set_background_compilation(trace_directory::Cstring)::Cvoid
+
+Compile the methods needed by a simulation on a background thread while it is set up by
+[`trixi_initialize_simulation`](@ref), or disable this if `trace_directory` is empty.
+
+The signatures of these methods are only known after a libelixir has run once, therefore
+they are recorded in a trace file per libelixir in `trace_directory`. Subsequent setups of
+the same libelixir, also in later runs of the host program, then compile the recorded
+signatures while the mesh, initial condition, and initial refinement are built, such that
+the first step does not have to wait for compilation. This requires Julia to run with more
+than one thread. See [`BackgroundCompilation`](@ref) for details.
+"""
+function trixi_set_background_compilation end
+
+Base.@ccallable function trixi_set_background_compilation(trace_directory::Cstring)::Cvoid
+    trixi_set_background_compilation_jl(unsafe_string(trace_directory))
+    return nothing
+end
+
+trixi_set_background_compilation_cfptr() =
+    @cfunction(trixi_set_background_compilation, Cvoid, (Cstring,))
+
+
+"""
+    trixi_create_ensemble(simstate_handle::Cint, nmembers::Cint)::Cint
+
+Create an ensemble of `nmembers` copies of the given simulation and return a handle to it.
+
+All members share the mesh and the solver cache and are advanced together by a single call
+to `trixi_step`, using a common time step. The conservative variables are stored with the
+member index innermost, such that each kernel evaluation processes all members at once (see
+[`EnsembleEquations`](@ref)). Initially, all members hold the current solution of the given
+simulation, which remains valid and independent of the ensemble. Individual member states
+can be set with [`trixi_store_member_conservative_vars`](@ref) and inspected with
+[`trixi_load_member_primitive_vars`](@ref). Of the callbacks of the given simulation, only
+the step size callback is used for the ensemble. The ensemble is released with
+`trixi_finalize_simulation`. Both simulations may be finalized in any order, their common
+mesh is released with the last of them.
+"""
+function trixi_create_ensemble end
+
+Base.@ccallable function trixi_create_ensemble(simstate_handle::Cint,
+                                               nmembers::Cint)::Cint
+    simstate = load_simstate(simstate_handle)
+    simstate_ensemble = trixi_create_ensemble_jl(simstate, nmembers)
+
+    return store_simstate(simstate_ensemble)
+end
+
+trixi_create_ensemble_cfptr() = @cfunction(trixi_create_ensemble, Cint, (Cint, Cint,))
+
+
+"""
+    trixi_reinitialize(simstate_handle::Cint, t0::Cdouble, tend::Cdouble)::Cvoid
+
+Restart the simulation at time `t0` from the initial condition of the libelixir, with final
+time `tend`.
+
+Mesh, solver cache, and time integrator are reused, such that only the initial condition is
+evaluated, which makes this much cheaper than finalizing the simulation and initializing it
+again, e.g., in parameter sweeps. If the time span changes, the time integrator is
+recreated, but mesh and solver cache are still reused. Step counters, time step,
+callbacks, and the preemption state are reset as after initialization. The current mesh is
+kept, i.e., after AMR the initial condition is evaluated on the adapted mesh. See
+[`reinitialize!`](@ref) for details.
+With MPI, this function has to be called collectively.
+"""
+function trixi_reinitialize end
+
+Base.@ccallable function trixi_reinitialize(simstate_handle::Cint, t0::Cdouble,
+                                            tend::Cdouble)::Cvoid
+    simstate = load_simstate(simstate_handle)
+    trixi_reinitialize_jl(simstate, t0, tend)
+    return nothing
+end
+
+trixi_reinitialize_cfptr() =
+    @cfunction(trixi_reinitialize, Cvoid, (Cint, Cdouble, Cdouble,))
+
+
+"""
+    trixi_set_initial_state(simstate_handle::Cint, t0::Cdouble, tend::Cdouble,
+                            data::Ptr{Cdouble})::Cvoid
+
+Restart the simulation at time `t0` from the conservative variables in `data`, with final
+time `tend`.
+
+Works like [`trixi_reinitialize`](@ref), but instead of evaluating the initial condition,
+the solution is copied from `data`, which holds all conservative variables of a degree of
+freedom contiguously, in the element order set by [`trixi_set_element_ordering`](@ref). It
+has to be of size ndofs * nvariables. Not supported for ensembles, see
+[`trixi_store_member_conservative_vars`](@ref) instead, and for simulations with an AMR
+callback that adapts the initial condition, since this would overwrite `data`.
+"""
+function trixi_set_initial_state end
+
+Base.@ccallable function trixi_set_initial_state(simstate_handle::Cint, t0::Cdouble,
+                                                 tend::Cdouble,
+                                                 data::Ptr{Cdouble})::Cvoid
+    simstate = load_simstate(simstate_handle)
+
+    # convert C to Julia array
+    size = trixi_ndofs_jl(simstate) * trixi_nvariables_jl(simstate)
+    data_jl = unsafe_wrap(Array, data, size)
+
+    trixi_set_initial_state_jl(simstate, t0, tend, data_jl)
+    return nothing
+end
+
+trixi_set_initial_state_cfptr() =
+    @cfunction(trixi_set_initial_state, Cvoid, (Cint, Cdouble, Cdouble, Ptr{Cdouble},))
+
+
 """
     trixi_finalize_simulation(simstate_handle::Cint)::Cvoid
 
 Finalize a simulation and attempt to free the underlying memory.
+
+The handle is released immediately. By default, a full garbage collection is run to free
+the memory. If deferred teardown is enabled with [`trixi_set_deferred_teardown`](@ref),
+this is postponed to the next batch or to [`trixi_collect_garbage`](@ref).
 """
 function trixi_finalize_simulation end
 
@@ -234,10 +844,11 @@ Base.@ccallable function trixi_finalize_simulation(simstate_handle::Cint)::Cvoid
     simstate = load_simstate(simstate_handle)
     trixi_finalize_simulation_jl(simstate)
 
-    # Remove all references to simulation state and call garbage collection
+    # Remove all references to simulation state and call garbage collection, possibly
+    # deferred
     simstate = nothing
     delete_simstate!(simstate_handle)
-    GC.gc()
+    collect_finalized!()
 
     return nothing
 end
@@ -372,6 +983,21 @@ end
 trixi_nvariables_cfptr() = @cfunction(trixi_nvariables, Cint, (Cint,))
 
 
+"""
+    trixi_nmembers(simstate_handle::Cint)::Cint
+
+Return number of ensemble members (`1` for simulations that are not an ensemble).
+"""
+function trixi_nmembers end
+
+Base.@ccallable function trixi_nmembers(simstate_handle::Cint)::Cint
+    simstate = load_simstate(simstate_handle)
+    return trixi_nmembers_jl(simstate)
+end
+
+trixi_nmembers_cfptr() = @cfunction(trixi_nmembers, Cint, (Cint,))
+
+
 """
     trixi_nnodes(simstate_handle::Cint)::Cint
 
@@ -462,8 +1088,266 @@ trixi_load_primitive_vars_cfptr() =
 
 
 """
-    trixi_register_data(data::Ptr{Cdouble}, size::Cint, index::Cint,
-                        simstate_handle::Cint)::Cvoid
+    trixi_load_primitive_vars_f32(simstate_handle::Cint, variable_id::Cint,
+                                  data::Ptr{Cfloat})::Cvoid
+
+Load primitive variable in single precision, see [`trixi_load_primitive_vars`](@ref).
+"""
+function trixi_load_primitive_vars_f32 end
+
+Base.@ccallable function trixi_load_primitive_vars_f32(simstate_handle::Cint,
+                                                       variable_id::Cint,
+                                                       data::Ptr{Cfloat})::Cvoid
+    simstate = load_simstate(simstate_handle)
+
+    # convert C to Julia array
+    size = trixi_ndofs_jl(simstate)
+    data_jl = unsafe_wrap(Array, data, size)
+
+    trixi_load_primitive_vars_jl(simstate, variable_id, data_jl)
+    return nothing
+end
+
+trixi_load_primitive_vars_f32_cfptr() =
+    @cfunction(trixi_load_primitive_vars_f32, Cvoid, (Cint, Cint, Ptr{Cfloat}))
+
+
+"""
+    trixi_load_member_primitive_vars(simstate_handle::Cint, member::Cint,
+                                     variable_id::Cint, data::Ptr{Cdouble})::Cvoid
+
+Load primitive variable of a single ensemble member.
+
+The values for the primitive variable at position `variable_id` of ensemble member `member`
+(starting at `1`) at every degree of freedom are stored in the given array `data`. Here,
+`variable_id` refers to the variables of a single member.
+
+The given array has to be of correct size (ndofs) and memory has to be allocated beforehand.
+"""
+function trixi_load_member_primitive_vars end
+
+Base.@ccallable function trixi_load_member_primitive_vars(simstate_handle::Cint,
+                                                          member::Cint, variable_id::Cint,
+                                                          data::Ptr{Cdouble})::Cvoid
+    simstate = load_simstate(simstate_handle)
+
+    # convert C to Julia array
+    size = trixi_ndofs_jl(simstate)
+    data_jl = unsafe_wrap(Array, data, size)
+
+    trixi_load_member_primitive_vars_jl(simstate, member, variable_id, data_jl)
+    return nothing
+end
+
+trixi_load_member_primitive_vars_cfptr() =
+    @cfunction(trixi_load_member_primitive_vars, Cvoid, (Cint, Cint, Cint, Ptr{Cdouble}))
+
+
+"""
+    trixi_store_member_conservative_vars(simstate_handle::Cint, member::Cint,
+                                         data::Ptr{Cdouble})::Cvoid
+
+Set the conservative variables of a single ensemble member.
+
+The given array `data` holds the conservative variables of ensemble member `member`
+(starting at `1`) in the same layout as the solution of a single simulation, i.e., all
+variables of a degree of freedom are stored contiguously. It has to be of size
+ndofs * nvariables / nmembers.
+"""
+function trixi_store_member_conservative_vars end
+
+Base.@ccallable function trixi_store_member_conservative_vars(simstate_handle::Cint,
+                                                              member::Cint,
+                                                              data::Ptr{Cdouble})::Cvoid
+    simstate = load_simstate(simstate_handle)
+
+    # convert C to Julia array
+    size = trixi_ndofs_jl(simstate) * trixi_nvariables_jl(simstate) ÷
+           trixi_nmembers_jl(simstate)
+    data_jl = unsafe_wrap(Array, data, size)
+
+    trixi_store_member_conservative_vars_jl(simstate, member, data_jl)
+    return nothing
+end
+
+trixi_store_member_conservative_vars_cfptr() =
+    @cfunction(trixi_store_member_conservative_vars, Cvoid, (Cint, Cint, Ptr{Cdouble}))
+
+
+"""
+    trixi_define_output_variable(simstate_handle::Cint, name::Cstring,
+                                 expression::Cstring)::Cint
+
+Define an output variable that is computed node-wise from the conservative variables.
+
+The string `expression` is Julia code that evaluates to a function
+`(u, equations) -> value`, where `u` holds the conservative variables at a single node,
+e.g., `"Trixi.entropy"`. It is compiled once, after which the variable can be loaded with
+[`trixi_load_variable`](@ref) using the returned handle. Defining a variable with an
+existing `name` replaces the previous definition and returns the same handle.
+"""
+function trixi_define_output_variable end
+
+Base.@ccallable function trixi_define_output_variable(simstate_handle::Cint, name::Cstring,
+                                                      expression::Cstring)::Cint
+    simstate = load_simstate(simstate_handle)
+    return trixi_define_output_variable_jl(simstate, unsafe_string(name),
+                                           unsafe_string(expression))
+end
+
+trixi_define_output_variable_cfptr() =
+    @cfunction(trixi_define_output_variable, Cint, (Cint, Cstring, Cstring,))
+
+
+"""
+    trixi_define_output_variable_callback(simstate_handle::Cint, name::Cstring,
+                                          func::Ptr{Cvoid}, userdata::Ptr{Cvoid})::Cint
+
+Define an output variable that is computed node-wise by a C function.
+
+Same as [`trixi_define_output_variable`](@ref), but the value at each node is computed as
+`func(u, nvariables, userdata)`, where `u` points to the `nvariables` conservative variables
+at the node. If Julia runs with multiple threads, `func` is called concurrently and must be
+thread-safe.
+"""
+function trixi_define_output_variable_callback end
+
+Base.@ccallable function trixi_define_output_variable_callback(simstate_handle::Cint,
+                                                               name::Cstring,
+                                                               func::Ptr{Cvoid},
+                                                               userdata::Ptr{Cvoid})::Cint
+    simstate = load_simstate(simstate_handle)
+    return trixi_define_output_variable_callback_jl(simstate, unsafe_string(name), func,
+                                                    userdata)
+end
+
+trixi_define_output_variable_callback_cfptr() =
+    @cfunction(trixi_define_output_variable_callback, Cint,
+               (Cint, Cstring, Ptr{Cvoid}, Ptr{Cvoid},))
+
+
+"""
+    trixi_load_variable(simstate_handle::Cint, variable_handle::Cint,
+                        data::Ptr{Cdouble})::Cvoid
+
+Load user-defined output variable.
+
+The values of the output variable `variable_handle`, as returned by
+[`trixi_define_output_variable`](@ref), at every degree of freedom are computed in a single
+pass over the solution and stored in the given array `data`, in the same order as in
+[`trixi_load_primitive_vars`](@ref).
+
+The given array has to be of correct size (ndofs) and memory has to be allocated beforehand.
+"""
+function trixi_load_variable end
+
+Base.@ccallable function trixi_load_variable(simstate_handle::Cint, variable_handle::Cint,
+                                             data::Ptr{Cdouble})::Cvoid
+    simstate = load_simstate(simstate_handle)
+
+    # convert C to Julia array
+    size = trixi_ndofs_jl(simstate)
+    data_jl = unsafe_wrap(Array, data, size)
+
+    trixi_load_variable_jl(simstate, variable_handle, data_jl)
+    return nothing
+end
+
+trixi_load_variable_cfptr() =
+    @cfunction(trixi_load_variable, Cvoid, (Cint, Cint, Ptr{Cdouble},))
+
+
+"""
+    trixi_set_element_ordering(simstate_handle::Cint, nelements::Cint,
+                               ordering::Ptr{Cint})::Cvoid
+
+Set the order in which elements are stored in all data exchanged with the host.
+
+The data of the `i`-th local element in Trixi's order is stored at position `ordering[i]`
+(starting at 1) in all arrays loaded from or stored into the simulation, e.g., by
+[`trixi_load_primitive_vars`](@ref) or [`trixi_load_element_averaged_primitive_vars`](@ref).
+The permutation is applied directly when copying the data, i.e., without an extra pass.
+`nelements` has to be the number of local elements. If `ordering` is a null pointer,
+Trixi's order is restored.
+
+The ordering is only valid as long as the mesh does not change. After the mesh was
+changed, e.g., by AMR, data can only be exchanged after the ordering was set again. Blocks
+streamed by [`trixi_foreach_element_block`](@ref) always use Trixi's order.
+
+Registered data vectors are read by the libelixir in Trixi's order and are not permuted.
+Therefore, an ordering cannot be set while data with one value per element or per degree of
+freedom is registered, and such data cannot be registered while an ordering is set (see
+[`check_registered_element_data`](@ref)).
+"""
+function trixi_set_element_ordering end
+
+Base.@ccallable function trixi_set_element_ordering(simstate_handle::Cint, nelements::Cint,
+                                                    ordering::Ptr{Cint})::Cvoid
+    simstate = load_simstate(simstate_handle)
+
+    # convert C to Julia array
+    if ordering == C_NULL
+        ordering_jl = nothing
+    else
+        ordering_jl = unsafe_wrap(Array, ordering, nelements)
+    end
+
+    trixi_set_element_ordering_jl(simstate, ordering_jl)
+    return nothing
+end
+
+trixi_set_element_ordering_cfptr() =
+    @cfunction(trixi_set_element_ordering, Cvoid, (Cint, Cint, Ptr{Cint},))
+
+
+"""
+    trixi_foreach_element_block(simstate_handle::Cint, block_size::Cint, nvars::Cint,
+                                variable_ids::Ptr{Cint}, callback::Ptr{Cvoid},
+                                userdata::Ptr{Cvoid})::Cvoid
+
+Stream primitive variables in blocks of elements to a callback.
+
+The elements are processed in blocks of at most `block_size` elements. For each block, the
+primitive variables at the `nvars` positions given in `variable_ids` are stored in a small
+buffer, which is reused for all blocks, and the C function `callback` is called as
+`callback(element_offset, nelements, data, userdata)`. Here, `element_offset` is the
+number of elements preceding the block and `nelements` is the number of elements in the
+block. For the `k`-th requested variable (zero-based), the values at all degrees of freedom
+of the block are stored contiguously at `data + k * nelements * ndofselement`, in the same
+order as in [`trixi_load_primitive_vars`](@ref).
+
+The buffer is only valid during the callback. Compared to loading complete arrays, only
+`block_size * ndofselement * nvars` values of extra memory are required.
+"""
+function trixi_foreach_element_block end
+
+Base.@ccallable function trixi_foreach_element_block(simstate_handle::Cint,
+                                                     block_size::Cint, nvars::Cint,
+                                                     variable_ids::Ptr{Cint},
+                                                     callback::Ptr{Cvoid},
+                                                     userdata::Ptr{Cvoid})::Cvoid
+    simstate = load_simstate(simstate_handle)
+
+    # convert C to Julia array
+    variable_ids_jl = unsafe_wrap(Array, variable_ids, nvars)
+
+    function callback_jl(element_offset, nelements, data)
+        ccall(callback, Cvoid, (Cint, Cint, Ptr{Cdouble}, Ptr{Cvoid}),
+              element_offset, nelements, pointer(data), userdata)
+    end
+
+    trixi_foreach_element_block_jl(simstate, block_size, variable_ids_jl, callback_jl)
+    return nothing
+end
+
+trixi_foreach_element_block_cfptr() =
+    @cfunction(trixi_foreach_element_block, Cvoid,
+               (Cint, Cint, Cint, Ptr{Cint}, Ptr{Cvoid}, Ptr{Cvoid},))
+
+
+"""
+    trixi_register_data(data::Ptr{Cdouble}, size::Cint, index::Cint,
+                        simstate_handle::Cint)::Cvoid
 
 Store data vector in current simulation's registry.
 
@@ -493,6 +1377,83 @@ trixi_register_data_cfptr() =
     @cfunction(trixi_register_data, Cvoid, (Cint, Cint, Cint, Ptr{Cdouble},))
 
 
+"""
+    trixi_register_data_f32(simstate_handle::Cint, index::Cint, size::Cint,
+                            data::Ptr{Cfloat})::Cvoid
+
+Store single precision data vector in current simulation's registry, see
+[`trixi_register_data`](@ref). The registry object has to be of type
+`LibTrixiDataRegistryF32`.
+"""
+function trixi_register_data_f32 end
+
+Base.@ccallable function trixi_register_data_f32(simstate_handle::Cint, index::Cint,
+                                                 size::Cint, data::Ptr{Cfloat})::Cvoid
+    simstate = load_simstate(simstate_handle)
+
+    # convert C to Julia array
+    data_jl = unsafe_wrap(Array, data, size)
+
+    trixi_register_data_jl(simstate, index, data_jl)
+    return nothing
+end
+
+trixi_register_data_f32_cfptr() =
+    @cfunction(trixi_register_data_f32, Cvoid, (Cint, Cint, Cint, Ptr{Cfloat},))
+
+
+"""
+    trixi_set_buffer_storage(simstate_handle::Cint, directory::Cstring,
+                             access_hint::Cint)::Cvoid
+
+Place buffers managed by the library in file-backed memory maps in `directory`, or in
+regular memory if `directory` is empty.
+
+This applies to all buffers allocated afterwards, i.e., data vectors allocated with
+[`trixi_allocate_data`](@ref). Pointing `directory` to node-local NVMe lets rarely used data
+exceed the DRAM of a node, since it is paged out to the file by the operating system. The
+files are removed right after mapping. The `access_hint` (`0`: normal, `1`: sequential,
+`2`: random, `3`: will be needed soon) is passed to `madvise` for every buffer. See
+[`BufferStorage`](@ref) for details.
+"""
+function trixi_set_buffer_storage end
+
+Base.@ccallable function trixi_set_buffer_storage(simstate_handle::Cint,
+                                                  directory::Cstring,
+                                                  access_hint::Cint)::Cvoid
+    simstate = load_simstate(simstate_handle)
+    trixi_set_buffer_storage_jl(simstate, unsafe_string(directory), access_hint)
+    return nothing
+end
+
+trixi_set_buffer_storage_cfptr() =
+    @cfunction(trixi_set_buffer_storage, Cvoid, (Cint, Cstring, Cint,))
+
+
+"""
+    trixi_allocate_data(simstate_handle::Cint, index::Cint, size::Cint)::Ptr{Cdouble}
+
+Allocate a zero-initialized data vector of length `size` in the buffer storage of the
+simulation (see [`trixi_set_buffer_storage`](@ref)), store it in the registry at `index`,
+and return a pointer to it.
+
+In contrast to [`trixi_register_data`](@ref), the memory is owned by the library. The
+pointer remains valid as long as the vector is stored in the registry, i.e., until another
+vector is stored at `index` or the simulation is finalized.
+"""
+function trixi_allocate_data end
+
+Base.@ccallable function trixi_allocate_data(simstate_handle::Cint, index::Cint,
+                                             size::Cint)::Ptr{Cdouble}
+    simstate = load_simstate(simstate_handle)
+    data = trixi_allocate_data_jl(simstate, index, size)
+    return pointer(data)
+end
+
+trixi_allocate_data_cfptr() =
+    @cfunction(trixi_allocate_data, Ptr{Cdouble}, (Cint, Cint, Cint,))
+
+
 """
     trixi_get_simulation_time(simstate_handle::Cint)::Cdouble
 
@@ -538,6 +1499,33 @@ trixi_load_element_averaged_primitive_vars_cfptr() =
     @cfunction(trixi_load_element_averaged_primitive_vars, Cvoid, (Cint, Cint, Ptr{Cdouble}))
 
 
+"""
+    trixi_load_element_averaged_primitive_vars_f32(simstate_handle::Cint,
+                                                   variable_id::Cint,
+                                                   data::Ptr{Cfloat})::Cvoid
+
+Load element averages for primitive variable in single precision, see
+[`trixi_load_element_averaged_primitive_vars`](@ref).
+"""
+function trixi_load_element_averaged_primitive_vars_f32 end
+
+Base.@ccallable function trixi_load_element_averaged_primitive_vars_f32(
+        simstate_handle::Cint, variable_id::Cint, data::Ptr{Cfloat})::Cvoid
+    simstate = load_simstate(simstate_handle)
+
+    # convert C to Julia array
+    size = trixi_nelements_jl(simstate)
+    data_jl = unsafe_wrap(Array, data, size)
+
+    trixi_load_element_averaged_primitive_vars_jl(simstate, variable_id, data_jl)
+    return nothing
+end
+
+trixi_load_element_averaged_primitive_vars_f32_cfptr() =
+    @cfunction(trixi_load_element_averaged_primitive_vars_f32, Cvoid,
+               (Cint, Cint, Ptr{Cfloat}))
+
+
 """
     trixi_get_t8code_forest(simstate_handle::Cint)::Ptr{Trixi.t8_forest}
 
@@ -557,9 +1545,302 @@ end
 trixi_get_t8code_forest_cfptr() =
     @cfunction(trixi_get_t8code_forest, Ptr{Trixi.t8_forest}, (Cint,))
 
+############################################################################################
+# Simulation output                                                                        #
+############################################################################################
+"""
+    trixi_save_vtkhdf(simstate_handle::Cint, filename::Cstring)::Cvoid
+
+Write current solution to a VTKHDF file.
+
+The primitive variables are written as point data of an unstructured grid with one
+high-order Lagrange cell per DG element, such that the file can be opened directly in
+ParaView without any postprocessing. With MPI, each rank contributes one piece of the grid
+and the function has to be called collectively by all ranks.
+"""
+function trixi_save_vtkhdf end
+
+Base.@ccallable function trixi_save_vtkhdf(simstate_handle::Cint, filename::Cstring)::Cvoid
+    simstate = load_simstate(simstate_handle)
+    trixi_save_vtkhdf_jl(simstate, unsafe_string(filename))
+    return nothing
+end
+
+trixi_save_vtkhdf_cfptr() = @cfunction(trixi_save_vtkhdf, Cvoid, (Cint, Cstring,))
+
+
+"""
+    trixi_set_output_aggregation(simstate_handle::Cint, enabled::Cint)::Cvoid
+
+Enable or disable node-aggregated output.
+
+If enabled, [`trixi_save_vtkhdf`](@ref) collects the data of all ranks on a compute node
+(i.e., ranks that can share memory) on one aggregator rank per node. Only the aggregators
+write to the file, each one a single contiguous piece, which reduces the number of I/O
+requests and the load on the metadata servers of parallel file systems. Without an
+MPI-enabled HDF5 library, the first aggregator writes the pieces of all nodes.
+"""
+function trixi_set_output_aggregation end
+
+Base.@ccallable function trixi_set_output_aggregation(simstate_handle::Cint,
+                                                      enabled::Cint)::Cvoid
+    simstate = load_simstate(simstate_handle)
+    trixi_set_output_aggregation_jl(simstate, enabled != 0)
+    return nothing
+end
+
+trixi_set_output_aggregation_cfptr() =
+    @cfunction(trixi_set_output_aggregation, Cvoid, (Cint, Cint,))
+
+
+"""
+    trixi_set_shm_publication(simstate_handle::Cint, name::Cstring, interval::Cint,
+                              nvars::Cint, variable_ids::Ptr{Cint},
+                              nslots::Cint)::Cvoid
+
+Publish snapshots of the primitive variables `variable_ids` to a POSIX shared-memory
+segment every `interval` steps, or disable publication if `interval` is not positive.
+
+The segment is named `name` with a single rank and `name.<rank>` with several ranks, and
+holds a ring of `nslots` snapshots. Processes on the same compute node read them without
+copies using the consumer library declared in `trixi_shm.h`, which detects snapshots that
+are overwritten while they are read. The current solution is published right away, and the
+segment is removed when the simulation is finalized. See [`SharedMemoryPublisher`](@ref)
+for details.
+"""
+function trixi_set_shm_publication end
+
+Base.@ccallable function trixi_set_shm_publication(simstate_handle::Cint, name::Cstring,
+                                                   interval::Cint, nvars::Cint,
+                                                   variable_ids::Ptr{Cint},
+                                                   nslots::Cint)::Cvoid
+    simstate = load_simstate(simstate_handle)
+
+    # convert C to Julia array
+    variable_ids_jl = unsafe_wrap(Array, variable_ids, nvars)
+
+    trixi_set_shm_publication_jl(simstate, unsafe_string(name), interval, variable_ids_jl,
+                                 nslots)
+    return nothing
+end
+
+trixi_set_shm_publication_cfptr() =
+    @cfunction(trixi_set_shm_publication, Cvoid, (Cint, Cstring, Cint, Cint, Ptr{Cint},
+                                                  Cint,))
+
+############################################################################################
+# Nesting                                                                                  #
+############################################################################################
+"""
+    trixi_create_nesting(parent_handle::Cint, child_handle::Cint,
+                         relaxation_width::Cdouble, feedback_weight::Cdouble)::Cint
+
+Couple the simulation `child_handle` to the simulation `parent_handle`, whose domain
+contains the child domain, and return a handle to the resulting [`Nesting`](@ref).
+
+All point-location and interpolation operators between both meshes are precomputed here.
+They are rebuilt automatically only if the mesh of either simulation changes. Both
+simulations must have the same number of dimensions and variables. With MPI, this function
+has to be called collectively by all ranks.
+"""
+function trixi_create_nesting end
+
+Base.@ccallable function trixi_create_nesting(parent_handle::Cint, child_handle::Cint,
+                                              relaxation_width::Cdouble,
+                                              feedback_weight::Cdouble)::Cint
+    parent_simstate = load_simstate(parent_handle)
+    child_simstate = load_simstate(child_handle)
+
+    nesting = trixi_create_nesting_jl(parent_simstate, child_simstate, relaxation_width,
+                                      feedback_weight)
+    return store_nesting(nesting)
+end
+
+trixi_create_nesting_cfptr() =
+    @cfunction(trixi_create_nesting, Cint, (Cint, Cint, Cdouble, Cdouble,))
+
+
+"""
+    trixi_nesting_interpolate(nesting_handle::Cint)::Cvoid
+
+Relax the child solution in the relaxation zone towards the interpolated parent solution
+(parent-to-child). The child solution is modified in place.
+"""
+function trixi_nesting_interpolate end
+
+Base.@ccallable function trixi_nesting_interpolate(nesting_handle::Cint)::Cvoid
+    nesting = load_nesting(nesting_handle)
+    trixi_nesting_interpolate_jl(nesting)
+    return nothing
+end
+
+trixi_nesting_interpolate_cfptr() = @cfunction(trixi_nesting_interpolate, Cvoid, (Cint,))
+
+
+"""
+    trixi_nesting_feedback(nesting_handle::Cint)::Cvoid
+
+Blend the parent solution inside the child domain with the interpolated child solution
+(child-to-parent). The parent solution is modified in place.
+"""
+function trixi_nesting_feedback end
+
+Base.@ccallable function trixi_nesting_feedback(nesting_handle::Cint)::Cvoid
+    nesting = load_nesting(nesting_handle)
+    trixi_nesting_feedback_jl(nesting)
+    return nothing
+end
+
+trixi_nesting_feedback_cfptr() = @cfunction(trixi_nesting_feedback, Cvoid, (Cint,))
+
+
+"""
+    trixi_finalize_nesting(nesting_handle::Cint)::Cvoid
+
+Release a nesting. The coupled simulations are not affected.
+"""
+function trixi_finalize_nesting end
+
+Base.@ccallable function trixi_finalize_nesting(nesting_handle::Cint)::Cvoid
+    nesting = load_nesting(nesting_handle)
+    trixi_finalize_nesting_jl(nesting)
+
+    nesting = nothing
+    delete_nesting!(nesting_handle)
+
+    return nothing
+end
+
+trixi_finalize_nesting_cfptr() = @cfunction(trixi_finalize_nesting, Cvoid, (Cint,))
+
+
+"""
+    trixi_transfer_solution(src_handle::Cint, dst_handle::Cint,
+                            l2_projection::Cint)::Cvoid
+
+Transfer the solution of one simulation to another one on a different mesh.
+
+The solution of the simulation `src_handle` is evaluated on the mesh of the simulation
+`dst_handle`, which may differ in resolution, mesh type, polynomial degree, and
+partitioning, and overwrites its solution. If `l2_projection` is zero, the solution is
+interpolated to the nodes of the destination, otherwise it is L2-projected onto the
+destination basis using Gauss points in each destination element. The destination domain
+has to be covered by the source domain. The simulation time of the destination is not
+changed.
+
+Both simulations need the same equations. With MPI, this function has to be called
+collectively by all ranks. See [`transfer_solution!`](@ref) for details.
+"""
+function trixi_transfer_solution end
+
+Base.@ccallable function trixi_transfer_solution(src_handle::Cint, dst_handle::Cint,
+                                                 l2_projection::Cint)::Cvoid
+    simstate_src = load_simstate(src_handle)
+    simstate_dst = load_simstate(dst_handle)
+    trixi_transfer_solution_jl(simstate_src, simstate_dst, l2_projection != 0)
+    return nothing
+end
+
+trixi_transfer_solution_cfptr() =
+    @cfunction(trixi_transfer_solution, Cvoid, (Cint, Cint, Cint,))
+
 ############################################################################################
 # Auxiliary
 ############################################################################################
+"""
+    trixi_set_log_sink(sink::Ptr{Cvoid}, userdata::Ptr{Cvoid}, min_level::Cint,
+                       rank_stride::Cint, json::Cint)::Cvoid
+
+Route all output of libtrixi and of the simulation callbacks through the C function `sink`,
+or restore printing to `stdout` if `sink` is a null pointer.
+
+Messages with a level of at least `min_level` (`0`: debug, `1`: info, `2`: warning,
+`3`: error) are passed as `sink(level, message, userdata)` with a null-terminated
+`message`, which is only valid during the call. Only ranks that are a multiple of
+`rank_stride` emit messages, i.e., with `rank_stride = 0` only the root rank does. If `json`
+is nonzero, each message is a single-line JSON object that holds level, rank, wall time,
+message text, and further structured fields.
+
+The standard output of the process is not redirected. Instead, the analysis and alive
+callbacks of simulations initialized while the sink is set emit structured records rather
+than printing, and the timer summary is logged when such a simulation is finalized (see
+[`log_callback_output`](@ref)). The sink is removed by `trixi_finalize` at the latest. The
+sink is never called concurrently, but it may be called from different threads if
+[`trixi_scheduler_run`](@ref) advances simulations concurrently. See [`LogSink`](@ref) for
+details.
+"""
+function trixi_set_log_sink end
+
+Base.@ccallable function trixi_set_log_sink(sink::Ptr{Cvoid}, userdata::Ptr{Cvoid},
+                                            min_level::Cint, rank_stride::Cint,
+                                            json::Cint)::Cvoid
+    if sink == C_NULL
+        trixi_set_log_sink_jl(nothing)
+    else
+        function write_jl(level, message)
+            ccall(sink, Cvoid, (Cint, Cstring, Ptr{Cvoid}), level, message, userdata)
+        end
+        trixi_set_log_sink_jl(write_jl, min_level, rank_stride, json != 0)
+    end
+
+    return nothing
+end
+
+trixi_set_log_sink_cfptr() =
+    @cfunction(trixi_set_log_sink, Cvoid, (Ptr{Cvoid}, Ptr{Cvoid}, Cint, Cint, Cint,))
+
+
+"""
+    trixi_log_message(level::Cint, message::Cstring)::Cvoid
+
+Emit `message` with the given `level` through the log sink set by
+[`trixi_set_log_sink`](@ref), or print it if no sink is set.
+"""
+function trixi_log_message end
+
+Base.@ccallable function trixi_log_message(level::Cint, message::Cstring)::Cvoid
+    trixi_log_message_jl(level, unsafe_string(message))
+    return nothing
+end
+
+trixi_log_message_cfptr() = @cfunction(trixi_log_message, Cvoid, (Cint, Cstring,))
+
+
+"""
+    trixi_set_allocator(alloc::Ptr{Cvoid}, free::Ptr{Cvoid}, userdata::Ptr{Cvoid})::Cvoid
+
+Allocate the memory of library-managed buffers with the C functions `alloc` and `free` of
+the host, or with Julia's allocator again if `alloc` is a null pointer.
+
+Memory is requested as `ptr = alloc(size, userdata)` with `size` in bytes and has to be
+suitably aligned for double precision values (64 bytes are recommended for
+vectorization). It is released as `free(ptr, userdata)` when the buffer is garbage
+collected, which may happen on any thread, also after `trixi_finalize_simulation`. Both
+functions thus have to be thread-safe and remain valid until `trixi_finalize`. The
+allocator applies to buffers allocated afterwards, i.e., data vectors allocated with
+[`trixi_allocate_data`](@ref), unless a file-backed buffer storage is set (see
+[`trixi_set_buffer_storage`](@ref)). See [`HostAllocator`](@ref) for details.
+"""
+function trixi_set_allocator end
+
+Base.@ccallable function trixi_set_allocator(alloc::Ptr{Cvoid}, free::Ptr{Cvoid},
+                                             userdata::Ptr{Cvoid})::Cvoid
+    if alloc == C_NULL
+        trixi_set_allocator_jl(nothing)
+    else
+        if free == C_NULL
+            error("host allocator requires a free function")
+        end
+        trixi_set_allocator_jl(HostAllocator(alloc, free, userdata))
+    end
+
+    return nothing
+end
+
+trixi_set_allocator_cfptr() =
+    @cfunction(trixi_set_allocator, Cvoid, (Ptr{Cvoid}, Ptr{Cvoid}, Ptr{Cvoid},))
+
+
 """
     trixi_eval_julia(code::Cstring)::Cvoid
 
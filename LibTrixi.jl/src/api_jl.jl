@@ -2,66 +2,371 @@
 # Simulation control                                                                       #
 ############################################################################################
 
-function trixi_initialize_simulation_jl(filename)
-    # Load elixir with simulation setup
-    Base.include(Main, abspath(filename))
+function trixi_initialize_simulation_jl(filename; RealT = Float64, uEltype = RealT)
+    # Record the wall time of each initialization phase
+    setup_start = time_ns()
+    setup_timings[] = Pair{String, Float64}[]
+
+    simstate = try
+        # Compile methods recorded for this elixir in the background while it sets up the
+        # mesh
+        compilation_task = start_background_compilation(filename)
+
+        # Load elixir with simulation setup
+        setup_phase(() -> Base.include(Main, abspath(filename)), "libelixir")
+
+        # Initialize simulation state
+        # Note: we need `invokelatest` here since the function is dynamically upon `include`
+        # Note: `invokelatest` is not exported until Julia v1.9, thus we call it through
+        # `Base`
+        simstate = setup_phase(() -> invoke_init_simstate(RealT, uEltype),
+                               "init_simstate")
+
+        finish_background_compilation(compilation_task, filename, simstate)
+
+        # Report the output of the callbacks as structured records
+        if !isnothing(log_sink[])
+            simstate = log_callback_output(simstate)
+        end
+        record_setup_phase!("total", (time_ns() - setup_start) * 1.0e-9)
+
+        simstate.setup_timings = setup_timings[]
+        simstate
+    finally
+        setup_timings[] = nothing
+    end
+
+    report_setup_timings(simstate)
+
+    log_debug("Simulation state initialized")
+
+    return simstate
+end
+
 
-    # Initialize simulation state
-    # Note: we need `invokelatest` here since the function is dynamically upon `include`
-    # Note: `invokelatest` is not exported until Julia v1.9, thus we call it through `Base`
-    simstate = Base.invokelatest(Main.init_simstate)
+# Call `init_simstate` of the libelixir. Floating point types other than the default are
+# only passed if the libelixir accepts them as keyword arguments.
+function invoke_init_simstate(RealT, uEltype)
+    init_simstate = Base.invokelatest(getproperty, Main, :init_simstate)
 
-    if show_debug_output()
-        println("Simulation state initialized")
+    if (RealT, uEltype) != (Float64, Float64) &&
+       Base.invokelatest(hasmethod, init_simstate, Tuple{}, (:RealT, :uEltype))
+        return Base.invokelatest(init_simstate; RealT, uEltype)
+    end
+
+    return Base.invokelatest(init_simstate)
+end
+
+
+function trixi_initialize_simulation_f32_jl(filename, geometry_f64)
+    RealT = geometry_f64 ? Float64 : Float32
+    simstate = trixi_initialize_simulation_jl(filename; RealT, uEltype = Float32)
+
+    # Libelixirs without precision keywords are set up in double precision and converted
+    _, _, solver, _ = mesh_equations_solver_cache(simstate.semi)
+    if eltype(simstate.integrator.u) != Float32 || real(solver) != RealT
+        simstate = set_precision(simstate, RealT, Float32)
+        log_debug("Simulation state switched to Float32 (geometry: ", RealT, ")")
     end
 
     return simstate
 end
 
 
+function trixi_get_setup_time_jl(simstate, phase)
+    index = findfirst(timing -> first(timing) == phase, simstate.setup_timings)
+    return isnothing(index) ? NaN : last(simstate.setup_timings[index])
+end
+
+
+function trixi_reinitialize_jl(simstate, t0, t_end)
+    reinitialize!(simstate, t0, t_end)
+
+    log_debug("Simulation reinitialized for time span ", (t0, t_end))
+
+    return nothing
+end
+
+
+function trixi_set_initial_state_jl(simstate, t0, t_end, data)
+    reinitialize!(simstate, t0, t_end, data)
+
+    log_debug("Simulation reinitialized from host data for time span ", (t0, t_end))
+
+    return nothing
+end
+
+
 function trixi_is_finished_jl(simstate)
-    # Return true if current time is approximately the final time
-    return isapprox(simstate.integrator.t, simstate.integrator.sol.prob.tspan[2])
+    # Return true if the simulation was preempted or stopped by the health check, or if the
+    # current time is approximately the final time
+    return is_preempted(simstate) || is_unhealthy(simstate) ||
+           isapprox(simstate.integrator.t, simstate.integrator.sol.prob.tspan[2])
+end
+
+
+function trixi_is_preempted_jl(simstate)
+    return is_preempted(simstate)
 end
 
 
 function trixi_step_jl(simstate)
+    check_registry(simstate.registry)
+
+    watchdog = simstate.watchdog
+    energy_meter = simstate.energy_meter
+    health = simstate.health_check
+    step_start = time_ns()
+    if !isnothing(watchdog)
+        wait_start = mpi_wait_time_ns()
+    end
+    if !isnothing(energy_meter)
+        n_dofs = trixi_ndofsglobal_jl(simstate)
+        start_energy_measurement!(energy_meter)
+    end
+    if !isnothing(health)
+        backup_solution!(health, simstate.integrator, simstate.buffer_storage)
+    end
+
     step!(simstate.integrator)
 
-    ret = check_error(simstate.integrator)
+    if !isnothing(energy_meter)
+        finish_energy_measurement!(energy_meter, n_dofs)
+    end
+
+    # Check the solution and whether preemption is imminent, before the integrator might
+    # fail on a broken solution; both checks share a single reduction
+    step_time = time_ns() - step_start
+    check_step!(simstate, step_time)
+
+    # A simulation stopped by the health check is considered finished instead of failed
+    if !is_unhealthy(simstate)
+        ret = check_error(simstate.integrator)
+
+        if ret != :Success
+            error("integrator failed to perform time step, return code: ", ret)
+        end
+    end
+
+    # Keep track of mesh changes such that derived data can be rebuilt when needed
+    if amr_was_applied(simstate.integrator)
+        simstate.mesh_epoch += 1
+    end
+
+    publisher = simstate.shm_publisher
+    if !isnothing(publisher) && simstate.integrator.iter % publisher.interval == 0
+        publish!(simstate)
+    end
+
+    if !isnothing(watchdog)
+        record_step!(watchdog, step_time, mpi_wait_time_ns() - wait_start)
+    end
+
+    tuner = amr_autotuner(simstate)
+    if !isnothing(tuner)
+        record_step!(tuner, simstate.integrator, step_time)
+    end
+
+    return nothing
+end
+
+
+function trixi_scheduler_run_jl(simstates, sync_interval, coupling = t -> nothing)
+    run_scheduler(simstates, sync_interval, coupling)
+
+    log_debug("Scheduler finished ", length(simstates), " simulations")
+
+    return nothing
+end
+
+
+function trixi_set_polydeg_jl(simstate, polydeg)
+    simstate_new = set_polydeg(simstate, polydeg)
+
+    log_debug("Polynomial degree set to ", polydeg)
+
+    return simstate_new
+end
+
+
+function trixi_set_amr_autotuning_jl(simstate, min_interval, max_interval,
+                                    target_overhead = 0.1)
+    if min_interval > 0
+        simstate_new = set_amr_autotuning(simstate, min_interval, max_interval,
+                                          target_overhead)
+    else
+        simstate_new = set_amr_autotuning(simstate, nothing)
+    end
+
+    log_debug("AMR autotuning ", min_interval > 0 ? "enabled" : "disabled")
 
-    if ret != :Success
-        error("integrator failed to perform time step, return code: ", ret)
+    return simstate_new
+end
+
+
+function trixi_get_amr_interval_jl(simstate)
+    tuner = amr_autotuner(simstate)
+    isnothing(tuner) || return tuner.interval
+
+    return original_amr_callback(simstate.integrator).affect!.interval
+end
+
+
+function trixi_set_straggler_watchdog_jl(simstate, interval, threshold,
+                                         report = report_straggler)
+    if !isnothing(simstate.watchdog)
+        finalize_watchdog!(simstate.watchdog)
+    end
+
+    if interval > 0
+        simstate.watchdog = StragglerWatchdog(interval, threshold, report)
+    else
+        simstate.watchdog = nothing
+    end
+
+    log_debug("Straggler watchdog ", interval > 0 ? "enabled" : "disabled")
+
+    return nothing
+end
+
+
+function trixi_set_preemption_jl(simstate, walltime_budget, output_directory,
+                                 handle_signals = false)
+    if !isnothing(simstate.preemption)
+        unwatch_signals!(simstate.preemption)
+    end
+    simstate.preemption = Preemption(walltime_budget, output_directory, handle_signals)
+
+    log_debug("Preemption enabled with checkpoint directory ", output_directory)
+
+    return nothing
+end
+
+
+function trixi_set_health_check_jl(simstate, interval, action = HEALTH_STOP,
+                                   n_report = 5)
+    if interval > 0
+        simstate.health_check = HealthCheck(interval, action, n_report)
+    else
+        simstate.health_check = nothing
+    end
+
+    log_debug("Health check ", interval > 0 ? "enabled" : "disabled")
+
+    return nothing
+end
+
+
+function trixi_get_health_status_jl(simstate)
+    health = simstate.health_check
+    return isnothing(health) ? HEALTH_OK : health.status
+end
+
+
+function trixi_set_energy_accounting_jl(simstate, enabled)
+    simstate.energy_meter = enabled ? EnergyMeter() : nothing
+
+    log_debug("Energy accounting ", enabled ? "enabled" : "disabled")
+
+    return nothing
+end
+
+
+function trixi_get_energy_stats_jl(simstate)
+    if isnothing(simstate.energy_meter)
+        error("energy accounting is not enabled")
+    end
+
+    return energy_stats(simstate.energy_meter)
+end
+
+
+function trixi_place_numa_jl(simstate)
+    place_numa!(simstate)
+    return nothing
+end
+
+
+function trixi_get_numa_placement_jl(simstate)
+    pages_per_node, local_fraction = numa_placement(simstate)
+    return (; pages_per_node, local_fraction)
+end
+
+
+function trixi_set_deferred_teardown_jl(enabled, batch_size = 0)
+    # release everything that is still pending before changing the mode
+    if !isnothing(deferred_teardown[])
+        collect_garbage!()
     end
 
+    deferred_teardown[] = enabled ? DeferredTeardown(batch_size) : nothing
+
+    log_debug("Deferred teardown ", enabled ? "enabled" : "disabled")
+
     return nothing
 end
 
 
+function trixi_collect_garbage_jl()
+    collect_garbage!()
+    return nothing
+end
+
+
+function trixi_set_background_compilation_jl(trace_directory)
+    if isnothing(trace_directory) || isempty(trace_directory)
+        background_compilation[] = nothing
+    else
+        background_compilation[] = BackgroundCompilation(trace_directory)
+    end
+
+    log_debug("Background compilation ",
+              isnothing(background_compilation[]) ? "disabled" : "enabled")
+
+    return nothing
+end
+
+
+function trixi_create_ensemble_jl(simstate, n_members)
+    simstate_ensemble = create_ensemble(simstate, n_members)
+
+    log_debug("Ensemble with ", n_members, " members created")
+
+    return simstate_ensemble
+end
+
+
 function trixi_finalize_simulation_jl(simstate)
-    # Run summary callback one final time
+    # Run summary callback one final time, or log the timers instead of printing them
     for cb in simstate.integrator.opts.callback.discrete_callbacks
         if cb isa DiscreteCallback{<:Any, typeof(summary_callback)}
-            cb()
+            isnothing(log_sink[]) ? cb() : log_timer_summary()
         end
     end
+    if !isnothing(simstate.energy_meter)
+        log_energy_summary(simstate.energy_meter)
+    end
 
-    # In course of garbage collection, MPI might get finalized before t8code related
-    # objects. This can lead to crashes because t8code allocates MPI related objects, e.g.
-    # shared memory arrays.
-    # T8code.jl implements manual ref counting to deal with this issue.
-    # For p4est the workaround is to finalize P4estMeshes explicitly in advance.
-    # x-ref: https://github.com/DLR-AMR/t8code/issues/1295
-    # x-ref: https://github.com/trixi-framework/libtrixi/pull/215#discussion_r1843676330
-    mesh, _, _, _ = mesh_equations_solver_cache(simstate.semi)
-    if mesh isa Trixi.P4estMesh
-        finalize(mesh)
+    if !isnothing(simstate.shm_publisher)
+        close_publisher!(simstate.shm_publisher)
+    end
+
+    # Leave signals to Julia again once no simulation handles them anymore
+    if !isnothing(simstate.preemption)
+        unwatch_signals!(simstate.preemption)
     end
 
-    if show_debug_output()
-        println("Simulation state finalized")
+    # P4est meshes have to be finalized before MPI, see `release_mesh!`
+    mesh, _, _, _ = mesh_equations_solver_cache(simstate.semi)
+    release_mesh!(mesh)
+
+    # Do not leave pending MPI requests behind
+    if !isnothing(simstate.watchdog)
+        finalize_watchdog!(simstate.watchdog)
     end
 
+    log_debug("Simulation state finalized")
+
     return nothing
 end
 
@@ -118,6 +423,11 @@ function trixi_nvariables_jl(simstate)
 end
 
 
+function trixi_nmembers_jl(simstate)
+    return nmembers(simstate)
+end
+
+
 function trixi_nnodes_jl(simstate)
     _, _, solver, _ = mesh_equations_solver_cache(simstate.semi)
     return nnodes(solver)
@@ -153,10 +463,13 @@ function trixi_load_primitive_vars_jl(simstate, variable_id, data)
     node_cis = CartesianIndices(ntuple(i -> n_nodes_per_dim, n_dims))
     node_lis = LinearIndices(node_cis)
 
+    # elements are stored in the order requested by the host
+    positions = element_positions(simstate)
+
     for element in eachelement(solver, cache)
         for node_ci in node_cis
             node_vars = get_node_vars(u, equations, solver, node_ci, element)
-            node_index = (element-1) * n_nodes + node_lis[node_ci]
+            node_index = host_dof_index(positions, element, node_lis[node_ci], n_nodes)
             data[node_index] = cons2prim(node_vars, equations)[variable_id]
         end
     end
@@ -165,6 +478,38 @@ function trixi_load_primitive_vars_jl(simstate, variable_id, data)
 end
 
 
+function trixi_load_member_primitive_vars_jl(simstate, member, variable_id, data)
+    n_members = nmembers(simstate)
+    if n_members == 1
+        return trixi_load_primitive_vars_jl(simstate, variable_id, data)
+    end
+
+    _, equations, _, _ = mesh_equations_solver_cache(simstate.semi)
+    equations_member = equations.equations
+    n_variables = nvariables(equations_member)
+    n_nodes = trixi_ndofselement_jl(simstate)
+    u = member_conservative_vars(simstate, member)
+    positions = element_positions(simstate)
+
+    Trixi.@threaded for element in eachindex(positions)
+        for node in 1:n_nodes
+            dof = (element - 1) * n_nodes + node
+            node_vars = Trixi.SVector(ntuple(v -> u[v, dof], Val(n_variables)))
+            data[host_dof_index(positions, element, node, n_nodes)] =
+                cons2prim(node_vars, equations_member)[variable_id]
+        end
+    end
+
+    return nothing
+end
+
+
+function trixi_store_member_conservative_vars_jl(simstate, member, data)
+    store_member_conservative_vars!(simstate, member, data)
+    return nothing
+end
+
+
 function trixi_load_element_averaged_primitive_vars_jl(simstate, variable_id, data)
     mesh, equations, solver, cache = mesh_equations_solver_cache(simstate.semi)
     n_nodes = nnodes(solver)
@@ -176,6 +521,9 @@ function trixi_load_element_averaged_primitive_vars_jl(simstate, variable_id, da
     # all permutations of nodes indices for arbitrary dimension
     node_cis = CartesianIndices(ntuple(i -> n_nodes, n_dims))
 
+    # elements are stored in the order requested by the host
+    positions = element_positions(simstate)
+
     for element in eachelement(solver, cache)
 
         # compute mean value using nodal dg values and quadrature
@@ -194,7 +542,77 @@ function trixi_load_element_averaged_primitive_vars_jl(simstate, variable_id, da
         u_mean = u_mean / 2^n_dims
 
         # write to provided array
-        data[element] = u_mean
+        data[positions[element]] = u_mean
+    end
+
+    return nothing
+end
+
+
+function trixi_define_output_variable_jl(simstate, name, func_or_expression)
+    index = define_output_variable!(simstate, name, func_or_expression)
+    log_debug("Output variable ", name, " defined with index ", index)
+    return index
+end
+
+
+function trixi_define_output_variable_callback_jl(simstate, name, func, userdata)
+    return trixi_define_output_variable_jl(simstate, name, COutputFunction(func, userdata))
+end
+
+
+function trixi_load_variable_jl(simstate, variable_handle, data)
+    load_output_variable!(data, simstate, variable_handle)
+    return nothing
+end
+
+
+function trixi_set_element_ordering_jl(simstate, positions)
+    set_element_ordering!(simstate, positions)
+    log_debug("Element ordering ", isnothing(positions) ? "reset" : "set")
+    return nothing
+end
+
+
+function trixi_foreach_element_block_jl(simstate, block_size, variable_ids, f)
+    mesh, equations, solver, cache = mesh_equations_solver_cache(simstate.semi)
+    n_nodes_per_dim = nnodes(solver)
+    n_dims = ndims(mesh)
+    n_nodes = n_nodes_per_dim^n_dims
+    n_elements = nelements(solver, cache)
+    n_variables = length(variable_ids)
+
+    if block_size < 1
+        error("block size must be positive: ", block_size)
+    end
+
+    u_ode = simstate.integrator.u
+    u = wrap_array(u_ode, mesh, equations, solver, cache)
+
+    # all permutations of nodes indices for arbitrary dimension
+    node_cis = CartesianIndices(ntuple(i -> n_nodes_per_dim, n_dims))
+    node_lis = LinearIndices(node_cis)
+
+    # buffer is reused for all blocks, layout is (n_nodes, n_block_elements, n_variables)
+    buffer = Vector{Float64}(undef, n_nodes * block_size * n_variables)
+
+    for first_element in 1:block_size:n_elements
+        n_block_elements = min(block_size, n_elements - first_element + 1)
+        data = reshape(view(buffer, 1:(n_nodes * n_block_elements * n_variables)),
+                       n_nodes, n_block_elements, n_variables)
+
+        for block_element in 1:n_block_elements
+            element = first_element + block_element - 1
+            for node_ci in node_cis
+                node_vars = get_node_vars(u, equations, solver, node_ci, element)
+                prim = cons2prim(node_vars, equations)
+                for (v, variable_id) in enumerate(variable_ids)
+                    data[node_lis[node_ci], block_element, v] = prim[variable_id]
+                end
+            end
+        end
+
+        f(first_element - 1, n_block_elements, data)
     end
 
     return nothing
@@ -202,14 +620,43 @@ end
 
 
 function trixi_register_data_jl(simstate, index, data)
+    check_registry_eltype(simstate.registry, eltype(data))
+    if !isnothing(simstate.element_ordering)
+        check_registered_element_data(data, simstate)
+    end
+
     simstate.registry[index] = data
-    if show_debug_output()
-        println("New data vector registered at index ", index)
+    log_debug("New data vector registered at index ", index)
+    return nothing
+end
+
+
+function trixi_set_buffer_storage_jl(simstate, directory, access_hint = ACCESS_NORMAL)
+    if isempty(directory)
+        simstate.buffer_storage = nothing
+    else
+        simstate.buffer_storage = BufferStorage(directory, access_hint)
     end
+
+    log_debug("Buffer storage set to ", isempty(directory) ? "memory" : directory)
+
     return nothing
 end
 
 
+function trixi_allocate_data_jl(simstate, index, size)
+    check_registry_eltype(simstate.registry, Float64)
+    if !isnothing(simstate.element_ordering)
+        check_registered_element_data(1:size, simstate)
+    end
+
+    data = allocate_buffer(simstate.buffer_storage, Float64, size)
+    simstate.registry[index] = data
+    log_debug("New data vector of size ", size, " allocated at index ", index)
+    return data
+end
+
+
 function trixi_get_simulation_time_jl(simstate)
     return simstate.integrator.t
 end
@@ -220,9 +667,122 @@ function trixi_get_t8code_forest_jl(simstate)
     return mesh.forest.pointer
 end
 
+############################################################################################
+# Simulation output                                                                        #
+############################################################################################
+function trixi_save_vtkhdf_jl(simstate, filename)
+    save_vtkhdf(filename, simstate; aggregate = simstate.aggregate_output)
+    log_debug("Solution written to VTKHDF file ", filename)
+    return nothing
+end
+
+
+function trixi_set_output_aggregation_jl(simstate, enabled)
+    simstate.aggregate_output = enabled
+    log_debug("Node-aggregated output ", enabled ? "enabled" : "disabled")
+    return nothing
+end
+
+
+function trixi_set_shm_publication_jl(simstate, name, interval, variable_ids, n_slots = 2)
+    if !isnothing(simstate.shm_publisher)
+        close_publisher!(simstate.shm_publisher)
+        simstate.shm_publisher = nothing
+    end
+
+    if interval > 0
+        _, equations, _, _ = mesh_equations_solver_cache(simstate.semi)
+        if equations isa EnsembleEquations
+            error("shared memory publication of ensembles is not supported")
+        end
+        for variable_id in variable_ids
+            if !(1 <= variable_id <= nvariables(equations))
+                error("variable ", variable_id, " does not exist, number of variables: ",
+                      nvariables(equations))
+            end
+        end
+
+        simstate.shm_publisher = SharedMemoryPublisher(name, interval, variable_ids,
+                                                       n_slots)
+
+        # consumers can start right away with the current solution
+        publish!(simstate)
+    end
+
+    log_debug("Shared memory publication ", interval > 0 ? "enabled" : "disabled")
+
+    return nothing
+end
+
+############################################################################################
+# Nesting                                                                                  #
+############################################################################################
+function trixi_create_nesting_jl(parent_simstate, child_simstate, relaxation_width,
+                                 feedback_weight)
+    nesting = Nesting(parent_simstate, child_simstate, relaxation_width, feedback_weight)
+
+    log_debug("Nesting initialized")
+
+    return nesting
+end
+
+
+function trixi_nesting_interpolate_jl(nesting)
+    nesting_interpolate!(nesting)
+    return nothing
+end
+
+
+function trixi_nesting_feedback_jl(nesting)
+    nesting_feedback!(nesting)
+    return nothing
+end
+
+
+function trixi_finalize_nesting_jl(nesting)
+    log_debug("Nesting finalized")
+
+    return nothing
+end
+
+
+function trixi_transfer_solution_jl(simstate_src, simstate_dst, l2_projection = false)
+    transfer_solution!(simstate_dst, simstate_src; l2_projection)
+    return nothing
+end
+
+############################################################################################
+# Logging
+############################################################################################
+function trixi_set_log_sink_jl(write, min_level = LOG_INFO, rank_stride = 0, json = false)
+    if isnothing(write)
+        set_log_sink!(nothing)
+    else
+        set_log_sink!(write, min_level, rank_stride, json)
+    end
+
+    log_debug("Log sink ", isnothing(write) ? "removed" : "set")
+
+    return nothing
+end
+
+
+function trixi_log_message_jl(level, message)
+    log_message(level, message; source = "host")
+    return nothing
+end
+
+
 ############################################################################################
 # Auxiliary
 ############################################################################################
+function trixi_set_allocator_jl(allocator)
+    host_allocator[] = allocator
+    log_debug("Host allocator ", isnothing(allocator) ? "removed" : "set")
+    return nothing
+end
+
+
 function trixi_eval_julia_jl(code)
     expr = Meta.parse(code)
     return Base.eval(Main, expr)
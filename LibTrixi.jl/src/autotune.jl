@@ -0,0 +1,186 @@
+"""
+    AMRAutotuner
+
+Online tuning of the AMR interval within `[min_interval, max_interval]`. The cost of the
+regular steps and of each adaptation are measured, and after every adaptation the interval
+is adjusted as follows:
+- if the mesh did not change, the adaptation was wasted and the interval is doubled,
+- if the adaptation overhead amortized over the interval exceeds `target_overhead` (as a
+  fraction of the regular step cost), the interval is increased by one,
+- otherwise, the interval is decreased by one to follow the solution more closely.
+The interval thus settles at the smallest interval whose adaptation overhead is within the
+target. All ranks use the maximum of the measured times, such that they agree on the
+interval.
+"""
+mutable struct AMRAutotuner
+    min_interval::Int
+    max_interval::Int
+    target_overhead::Float64
+    interval::Int
+    last_adaptation::Int            # accepted steps at the last adaptation
+    step_time::Float64              # time of regular steps since last adaptation (seconds)
+    n_steps::Int                    # number of regular steps since last adaptation
+    adaptation_time::Float64        # duration of the last adaptation (seconds)
+    n_adaptations::Int
+
+    function AMRAutotuner(interval, min_interval, max_interval, target_overhead,
+                          last_adaptation)
+        if !(1 <= min_interval <= max_interval)
+            error("invalid AMR interval bounds: [", min_interval, ", ", max_interval, "]")
+        end
+        if target_overhead <= 0
+            error("target overhead must be positive: ", target_overhead)
+        end
+
+        return new(min_interval, max_interval, target_overhead,
+                   clamp(interval, min_interval, max_interval), last_adaptation, 0.0, 0,
+                   0.0, 0)
+    end
+end
+
+
+# Affect of the AMR callback that is called at the interval chosen by `tuner`. The original
+# callback is kept such that it can be rebuilt and restored.
+struct AutotunedAMR{CallbackType}
+    amr_callback::CallbackType
+    tuner::AMRAutotuner
+end
+
+function (autotuned::AutotunedAMR)(integrator)
+    tuner = autotuned.tuner
+    n_dofs = length(integrator.u)
+
+    adaptation_start = time_ns()
+    has_changed = autotuned.amr_callback.affect!(integrator)
+    adaptation_time = (time_ns() - adaptation_start) * 1.0e-9
+
+    changed = has_changed === true || length(integrator.u) != n_dofs
+    update_interval!(tuner, adaptation_time, changed)
+    tuner.last_adaptation = integrator.stats.naccept
+
+    return nothing
+end
+
+function autotuned_amr_callback(amr_callback, tuner)
+    condition = (u, t, integrator) -> integrator.stats.naccept - tuner.last_adaptation >=
+                                      tuner.interval
+    initialize = (c, u, t, integrator) -> u_modified!(integrator, false)
+    return DiscreteCallback(condition, AutotunedAMR(amr_callback, tuner); initialize,
+                            save_positions = (false, false))
+end
+
+# The adaptation itself is timed by the callback, i.e., it is subtracted here again
+function record_step!(tuner::AMRAutotuner, integrator, step_time_ns)
+    step_time = step_time_ns * 1.0e-9
+    if tuner.last_adaptation == integrator.stats.naccept
+        step_time -= tuner.adaptation_time
+    end
+
+    tuner.step_time += max(step_time, 0.0)
+    tuner.n_steps += 1
+
+    return nothing
+end
+
+
+function update_interval!(tuner::AMRAutotuner, adaptation_time, changed)
+    step_time = tuner.step_time / max(tuner.n_steps, 1)
+    if Trixi.mpi_isparallel()
+        times = MPI.Allreduce([adaptation_time, step_time], max, Trixi.mpi_comm())
+        adaptation_time, step_time = times
+        changed = MPI.Allreduce(Int(changed), max, Trixi.mpi_comm()) > 0
+    end
+
+    overhead = adaptation_time / max(tuner.interval * step_time, eps())
+    interval = tuner.interval
+    if !changed
+        interval = min(2 * interval, tuner.max_interval)
+    elseif overhead > tuner.target_overhead
+        interval = min(interval + 1, tuner.max_interval)
+    else
+        interval = max(interval - 1, tuner.min_interval)
+    end
+
+    if interval != tuner.interval && Trixi.mpi_isroot()
+        log_message(LOG_INFO,
+                    string("AMR interval changed from ", tuner.interval, " to ", interval,
+                           " (adaptation overhead ", round(100 * overhead, digits = 1),
+                           "%, mesh ", changed ? "changed" : "unchanged", ")");
+                    source = "autotune", interval, previous_interval = tuner.interval,
+                    overhead, changed, adaptation_time, step_time)
+    end
+
+    tuner.interval = interval
+    tuner.adaptation_time = adaptation_time
+    tuner.step_time = 0.0
+    tuner.n_steps = 0
+    tuner.n_adaptations += 1
+
+    return nothing
+end
+
+
+# Index of the AMR callback of `integrator`, either Trixi's or an autotuned one
+function amr_callback_index(integrator)
+    return findfirst(integrator.opts.callback.discrete_callbacks) do cb
+        cb isa DiscreteCallback{<:Any, <:Trixi.AMRCallback} ||
+            cb isa DiscreteCallback{<:Any, <:AutotunedAMR}
+    end
+end
+
+# Autotuner of `simstate` or `nothing` if the AMR interval is not tuned
+function amr_autotuner(simstate)
+    for cb in simstate.integrator.opts.callback.discrete_callbacks
+        if cb isa DiscreteCallback{<:Any, <:AutotunedAMR}
+            return cb.affect!.tuner
+        end
+    end
+
+    return nothing
+end
+
+
+"""
+    set_amr_autotuning(simstate, min_interval, max_interval, target_overhead)
+    set_amr_autotuning(simstate, nothing)
+
+Return a new [`SimulationState`](@ref) in which the interval of the AMR callback of
+`simstate` is tuned online by an [`AMRAutotuner`](@ref), starting from the current interval,
+or in which the original AMR callback is restored. Since the interval of Trixi's AMR
+callback is fixed, the time integrator is recreated at the current time with the AMR
+callback replaced, while semidiscretization and all other callbacks are reused.
+"""
+function set_amr_autotuning(simstate, min_interval, max_interval, target_overhead)
+    integrator = simstate.integrator
+    amr_callback = original_amr_callback(integrator)
+
+    tuner = AMRAutotuner(amr_callback.affect!.interval, min_interval, max_interval,
+                         target_overhead, integrator.stats.naccept)
+
+    return replace_amr_callback(simstate, autotuned_amr_callback(amr_callback, tuner))
+end
+
+function set_amr_autotuning(simstate, ::Nothing)
+    amr_callback = original_amr_callback(simstate.integrator)
+    return replace_amr_callback(simstate, reuse_callback(amr_callback))
+end
+
+function original_amr_callback(integrator)
+    index = amr_callback_index(integrator)
+    if isnothing(index)
+        error("AMR autotuning requires an AMR callback")
+    end
+
+    cb = integrator.opts.callback.discrete_callbacks[index]
+    return cb.affect! isa AutotunedAMR ? cb.affect!.amr_callback : cb
+end
+
+function replace_amr_callback(simstate, amr_callback)
+    integrator = simstate.integrator
+    index = amr_callback_index(integrator)
+    callbacks = map(enumerate(integrator.opts.callback.discrete_callbacks)) do (i, cb)
+        return i == index ? amr_callback : reuse_callback(cb)
+    end
+
+    return replace_callbacks(simstate, callbacks)
+end
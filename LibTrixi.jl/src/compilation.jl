@@ -0,0 +1,151 @@
+"""
+    BackgroundCompilation(trace_directory)
+
+Settings for compiling the methods used by a simulation on a background thread while it is
+set up. The concrete types of semidiscretization, time integrator, and simulation state are
+only known after the libelixir has run, thus the signatures of the methods run by the first
+steps and by the API kernels are recorded in a trace file per libelixir in
+`trace_directory`. When the same libelixir is set up again, e.g., in a later run of the
+host program, the recorded signatures are compiled on a background task while the
+libelixir builds mesh, initial condition, and initial refinement on the calling thread.
+Signatures with types defined by the libelixir itself cannot be restored before it is loaded
+and are skipped. Background compilation requires more than one Julia thread.
+"""
+struct BackgroundCompilation
+    trace_directory::String
+
+    function BackgroundCompilation(trace_directory)
+        if isempty(trace_directory)
+            error("trace directory must not be empty")
+        end
+
+        mkpath(trace_directory)
+
+        return new(trace_directory)
+    end
+end
+
+# Background compilation settings, disabled if `nothing`
+const background_compilation = Ref{Union{Nothing, BackgroundCompilation}}(nothing)
+
+
+# The types in a trace depend on the Julia version and the versions of the loaded packages;
+# traces of other package versions fail to load or only lead to unused compilations
+function trace_file(compilation::BackgroundCompilation, filename)
+    key = string(hash((abspath(filename), VERSION)), base = 16)
+    return joinpath(compilation.trace_directory, "trace_" * key * ".jls")
+end
+
+# Signatures of the methods run by the first steps and by the most common API kernels
+function trace_signatures(simstate)
+    S = typeof(simstate)
+    integrator = simstate.integrator
+    u = typeof(integrator.u)
+    data = Vector{Cdouble}
+
+    return Any[Tuple{typeof(step!), typeof(integrator)},
+               Tuple{typeof(Trixi.rhs!), u, u, typeof(simstate.semi), typeof(integrator.t)},
+               Tuple{typeof(trixi_step_jl), S},
+               Tuple{typeof(trixi_calculate_dt_jl), S},
+               Tuple{typeof(trixi_is_finished_jl), S},
+               Tuple{typeof(trixi_get_simulation_time_jl), S},
+               Tuple{typeof(trixi_load_primitive_vars_jl), S, Cint, data},
+               Tuple{typeof(trixi_load_element_averaged_primitive_vars_jl), S, Cint, data}]
+end
+
+
+# Each signature is serialized on its own, such that the others can still be restored if
+# one of them refers to types that do not exist yet
+function save_trace(path, signatures)
+    entries = map(signatures) do signature
+        io = IOBuffer()
+        Serialization.serialize(io, signature)
+        return take!(io)
+    end
+
+    # replace the trace atomically, other ranks or processes might be reading it
+    temp_path, io = mktemp(dirname(path); cleanup = false)
+    try
+        Serialization.serialize(io, entries)
+    finally
+        close(io)
+    end
+    mv(temp_path, path; force = true)
+
+    return nothing
+end
+
+function load_trace(path)
+    isfile(path) || return Any[]
+
+    entries = try
+        open(Serialization.deserialize, path)
+    catch err
+        log_debug("Trace ", path, " could not be read: ", err)
+        return Any[]
+    end
+
+    signatures = Any[]
+    for entry in entries
+        try
+            push!(signatures, Serialization.deserialize(IOBuffer(entry)))
+        catch
+            # types defined by the libelixir, which is not loaded yet
+        end
+    end
+
+    return signatures
+end
+
+
+"""
+    start_background_compilation(filename)
+
+Start compiling the signatures recorded for the libelixir `filename` on a background task if
+[`BackgroundCompilation`](@ref) is enabled and a trace exists. Return the task or `nothing`.
+"""
+function start_background_compilation(filename)
+    compilation = background_compilation[]
+    isnothing(compilation) && return nothing
+
+    if Threads.nthreads() == 1
+        log_debug("Background compilation skipped, Julia runs with a single thread")
+        return nothing
+    end
+
+    signatures = load_trace(trace_file(compilation, filename))
+    isempty(signatures) && return nothing
+
+    log_debug("Compiling ", length(signatures), " signatures in the background")
+
+    return Threads.@spawn count(precompile, signatures)
+end
+
+"""
+    finish_background_compilation(task, filename, simstate)
+
+Wait for the background compilation `task` (if any) to finish, and record the signatures of
+`simstate` in the trace of the libelixir `filename` for the next setup.
+"""
+function finish_background_compilation(task, filename, simstate)
+    compilation = background_compilation[]
+    isnothing(compilation) && return nothing
+
+    if !isnothing(task)
+        n_compiled = setup_phase("background_compilation") do
+            try
+                return fetch(task)
+            catch err
+                log_debug("Background compilation failed: ", err)
+                return 0
+            end
+        end
+        log_debug("Background compilation of ", n_compiled, " signatures finished")
+    end
+
+    if Trixi.mpi_isroot()
+        save_trace(trace_file(compilation, filename), trace_signatures(simstate))
+    end
+
+    return nothing
+end
@@ -0,0 +1,93 @@
+"""
+    ElementOrdering
+
+Host-defined order of the local elements: `positions[element]` is the position (starting at
+1) of the data of `element` in all arrays exchanged with the host. The ordering is only
+valid for the mesh epoch it was set for, i.e., it has to be set again after the mesh has
+changed, e.g., due to AMR.
+"""
+struct ElementOrdering
+    positions::Vector{Int}
+    mesh_epoch::Int
+end
+
+
+"""
+    set_element_ordering!(simstate, positions)
+    set_element_ordering!(simstate, nothing)
+
+Use the host-defined element order `positions` (see [`ElementOrdering`](@ref)) for all data
+exported from or imported into `simstate`, or restore Trixi's element order. The
+permutation is validated once and then applied directly in the copy loops.
+
+Registered data vectors are read by the libelixir in Trixi's element order and cannot be
+permuted without detaching them from the host memory. Therefore, an ordering is rejected
+while element data is registered, see [`check_registered_element_data`](@ref).
+"""
+function set_element_ordering!(simstate, positions)
+    _, _, solver, cache = mesh_equations_solver_cache(simstate.semi)
+    n_elements = nelements(solver, cache)
+
+    if length(positions) != n_elements
+        error("element ordering has ", length(positions), " entries, but there are ",
+              n_elements, " elements")
+    end
+    if !isperm(positions)
+        error("element ordering is not a permutation of 1:", n_elements)
+    end
+    for data in assigned_entries(simstate.registry)
+        check_registered_element_data(data, simstate)
+    end
+
+    simstate.element_ordering = ElementOrdering(collect(Int, positions),
+                                                simstate.mesh_epoch)
+
+    return nothing
+end
+
+function set_element_ordering!(simstate, ::Nothing)
+    simstate.element_ordering = nothing
+    return nothing
+end
+
+
+"""
+    check_registered_element_data(data, simstate)
+
+Throw an error if `data` holds one value per local element or per degree of freedom of
+`simstate`, since such data would be in Trixi's element order while a host-defined
+[`ElementOrdering`](@ref) is active. Other data, e.g., global parameters, is accepted.
+"""
+function check_registered_element_data(data, simstate)
+    mesh, _, solver, cache = mesh_equations_solver_cache(simstate.semi)
+    if length(data) in (nelements(solver, cache), ndofs(mesh, solver, cache))
+        error("registered element data is read in Trixi's element order and cannot be ",
+              "combined with a host-defined element ordering")
+    end
+
+    return nothing
+end
+
+assigned_entries(registry) = (registry[i] for i in eachindex(registry)
+                              if isassigned(registry, i))
+
+
+# Positions of all elements in host data, either the registered ordering or the identity
+function element_positions(simstate)
+    ordering = simstate.element_ordering
+    if isnothing(ordering)
+        _, _, solver, cache = mesh_equations_solver_cache(simstate.semi)
+        return eachelement(solver, cache)
+    end
+
+    if ordering.mesh_epoch != simstate.mesh_epoch
+        error("element ordering is outdated since the mesh has changed, set it again")
+    end
+
+    return ordering.positions
+end
+
+# Index in host data of `node` (counted within the element) of `element`
+@inline function host_dof_index(positions, element, node, n_nodes)
+    return (positions[element] - 1) * n_nodes + node
+end
@@ -0,0 +1,141 @@
+# Linux powercap interface exposing the RAPL energy counters
+const powercap_directory = "/sys/class/powercap"
+
+
+# Energy counter files of all top-level RAPL zones (one per CPU package) that can be read;
+# subzones (cores, uncore, dram) are contained in their package and thus skipped
+function rapl_counters()
+    isdir(powercap_directory) || return String[], Float64[]
+
+    counters = String[]
+    max_energies = Float64[]
+    for zone in readdir(powercap_directory)
+        occursin(r"^intel-rapl:\d+$", zone) || continue
+
+        counter = joinpath(powercap_directory, zone, "energy_uj")
+        max_energy = joinpath(powercap_directory, zone, "max_energy_range_uj")
+        try
+            read_counter(counter)
+            push!(max_energies, read_counter(max_energy))
+            push!(counters, counter)
+        catch
+            # not readable, e.g., since access is restricted to root
+            continue
+        end
+    end
+
+    return counters, max_energies
+end
+
+read_counter(file) = parse(Float64, readchomp(file))
+
+
+"""
+    EnergyMeter
+
+Energy accounting for `trixi_step` based on the RAPL counters of the Linux powercap
+interface. Since the counters cover whole CPU packages, only the first rank on every
+compute node reads them (see [`node_comms`](@ref)), and the energy of all nodes is summed
+up when the statistics are requested. Counter wrap-arounds are corrected, but only one
+wrap-around per step is detected.
+
+If the counters are not available on every node, e.g., since they are only readable by
+root, no energy is recorded.
+"""
+mutable struct EnergyMeter
+    counters::Vector{String}        # energy counter files (empty if not measuring)
+    max_energies::Vector{Float64}   # counter ranges in microjoules
+    readings::Vector{Float64}       # counter values at the start of the step
+    available::Bool                 # true if counters are read on all nodes
+    energy::Float64                 # accumulated energy of this rank (in joules)
+    n_steps::Int
+    n_dof_updates::Int
+
+    function EnergyMeter()
+        counters, max_energies = rapl_counters()
+        available = !isempty(counters)
+
+        if Trixi.mpi_isparallel()
+            node_comm, _ = node_comms()
+            if MPI.Comm_rank(node_comm) != 0
+                counters, max_energies = String[], Float64[]
+                available = true
+            end
+            available = MPI.Allreduce(Int(available), min, Trixi.mpi_comm()) > 0
+        end
+
+        return new(counters, max_energies, zeros(length(counters)), available, 0.0, 0, 0)
+    end
+end
+
+
+function start_energy_measurement!(meter::EnergyMeter)
+    meter.available || return nothing
+
+    for (i, counter) in enumerate(meter.counters)
+        meter.readings[i] = read_counter(counter)
+    end
+
+    return nothing
+end
+
+function finish_energy_measurement!(meter::EnergyMeter, n_dofs)
+    meter.n_steps += 1
+    meter.n_dof_updates += n_dofs
+    meter.available || return nothing
+
+    for (i, counter) in enumerate(meter.counters)
+        delta = read_counter(counter) - meter.readings[i]
+        if delta < 0
+            delta += meter.max_energies[i]
+        end
+        meter.energy += delta * 1.0e-6
+    end
+
+    return nothing
+end
+
+
+"""
+    energy_stats(meter::EnergyMeter)
+
+Return whether energy counters are available, the total energy in joules consumed during
+all recorded steps on all nodes, and the energy per step and per update of a single
+degree of freedom (based on the global number of degrees of freedom). This function has to
+be called collectively by all ranks.
+"""
+function energy_stats(meter::EnergyMeter)
+    energy = meter.energy
+    if Trixi.mpi_isparallel()
+        energy = MPI.Allreduce(energy, +, Trixi.mpi_comm())
+    end
+
+    if !meter.available
+        return (; available = false, energy = NaN, energy_per_step = NaN,
+                energy_per_dof_update = NaN)
+    end
+
+    return (; available = true, energy, energy_per_step = energy / max(meter.n_steps, 1),
+            energy_per_dof_update = energy / max(meter.n_dof_updates, 1))
+end
+
+
+# Report the energy statistics on the root rank, collective
+function log_energy_summary(meter::EnergyMeter)
+    stats = energy_stats(meter)
+    Trixi.mpi_isroot() || return nothing
+
+    if stats.available
+        log_message(LOG_INFO,
+                    string("Energy: ", stats.energy, " J in ", meter.n_steps, " steps (",
+                           stats.energy_per_step, " J/step, ", stats.energy_per_dof_update,
+                           " J/DOF update)");
+                    source = "energy", energy = stats.energy, n_steps = meter.n_steps,
+                    energy_per_step = stats.energy_per_step,
+                    energy_per_dof_update = stats.energy_per_dof_update)
+    else
+        log_message(LOG_INFO, "Energy: RAPL counters not available"; source = "energy")
+    end
+
+    return nothing
+end
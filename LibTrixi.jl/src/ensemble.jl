@@ -0,0 +1,261 @@
+"""
+    EnsembleEquations
+
+Wrapper that stacks `NMEMBERS` independent copies of a system of equations into a single
+system with `NVARS = NMEMBERS * nvariables(equations)` variables. The member index is the
+innermost index, i.e., variable `v` of member `k` is stored at position
+`k + NMEMBERS * (v - 1)`. Thus, one pass of Trixi's kernels over the (shared) mesh advances
+all members at once, and the member loops inside the flux functions are fully unrolled,
+which allows the compiler to process the members in SIMD lanes.
+
+Since all members share one time integrator, they are advanced with a common time step.
+"""
+struct EnsembleEquations{NDIMS, NVARS, NMEMBERS, EquationsType} <:
+       Trixi.AbstractEquations{NDIMS, NVARS}
+    equations::EquationsType
+
+    function EnsembleEquations(equations, n_members)
+        n_dims = ndims(equations)
+        n_variables = n_members * nvariables(equations)
+        return new{n_dims, n_variables, n_members, typeof(equations)}(equations)
+    end
+end
+
+nmembers(::EnsembleEquations{NDIMS, NVARS, NMEMBERS}) where {NDIMS, NVARS, NMEMBERS} =
+    NMEMBERS
+
+Trixi.get_name(equations::EnsembleEquations) =
+    "Ensemble of " * Trixi.get_name(equations.equations)
+
+function Trixi.varnames(conversion, equations::EnsembleEquations)
+    names = Trixi.varnames(conversion, equations.equations)
+    return Tuple(name * "_" * string(k) for name in names
+                 for k in 1:nmembers(equations))
+end
+
+
+# Extract the variables of a single member
+@inline function member_vars(u, member, equations::EnsembleEquations)
+    n_members = nmembers(equations)
+    return Trixi.SVector(ntuple(v -> u[member + n_members * (v - 1)],
+                                Val(nvariables(equations.equations))))
+end
+
+# Evaluate `func(member)` for all members and stack the results with the member index
+# innermost
+@inline function map_members(func, equations::EnsembleEquations)
+    n_members = nmembers(equations)
+    results = ntuple(func, Val(n_members))
+    stacked = ntuple(Val(nvariables(equations))) do i
+        member, v = (i - 1) % n_members + 1, (i - 1) ÷ n_members + 1
+        return results[member][v]
+    end
+
+    return Trixi.SVector(stacked)
+end
+
+
+@inline function Trixi.flux(u, orientation_or_normal_direction,
+                            equations::EnsembleEquations)
+    return map_members(k -> Trixi.flux(member_vars(u, k, equations),
+                                       orientation_or_normal_direction,
+                                       equations.equations), equations)
+end
+
+@inline function Trixi.cons2prim(u, equations::EnsembleEquations)
+    return map_members(k -> cons2prim(member_vars(u, k, equations), equations.equations),
+                       equations)
+end
+
+@inline function Trixi.max_abs_speeds(u, equations::EnsembleEquations)
+    speeds = ntuple(k -> Trixi.max_abs_speeds(member_vars(u, k, equations),
+                                              equations.equations),
+                    Val(nmembers(equations)))
+    return reduce((a, b) -> max.(a, b), speeds)
+end
+
+Trixi.max_abs_speeds(equations::EnsembleEquations) =
+    Trixi.max_abs_speeds(equations.equations)
+
+Trixi.have_constant_speed(equations::EnsembleEquations) =
+    Trixi.have_constant_speed(equations.equations)
+
+Trixi.have_nonconservative_terms(equations::EnsembleEquations) =
+    Trixi.have_nonconservative_terms(equations.equations)
+
+
+# Apply a two-point flux (surface or volume flux) to each member separately
+struct EnsembleFlux{FluxType}
+    flux::FluxType
+end
+
+@inline function (ensemble_flux::EnsembleFlux)(u_ll, u_rr, orientation_or_normal_direction,
+                                               equations::EnsembleEquations)
+    return map_members(k -> ensemble_flux.flux(member_vars(u_ll, k, equations),
+                                               member_vars(u_rr, k, equations),
+                                               orientation_or_normal_direction,
+                                               equations.equations), equations)
+end
+
+
+# Apply initial condition, source terms, or boundary conditions to each member separately
+struct EnsembleInitialCondition{InitialConditionType}
+    initial_condition::InitialConditionType
+end
+
+@inline function (ensemble::EnsembleInitialCondition)(x, t, equations::EnsembleEquations)
+    return map_members(k -> ensemble.initial_condition(x, t, equations.equations),
+                       equations)
+end
+
+struct EnsembleSourceTerms{SourceTermsType}
+    source_terms::SourceTermsType
+end
+
+@inline function (ensemble::EnsembleSourceTerms)(u, x, t, equations::EnsembleEquations)
+    return map_members(k -> ensemble.source_terms(member_vars(u, k, equations), x, t,
+                                                  equations.equations), equations)
+end
+
+struct EnsembleBoundaryCondition{BoundaryConditionType}
+    boundary_condition::BoundaryConditionType
+end
+
+# The geometric arguments differ between mesh types, but the last two arguments are always
+# the surface flux and the equations
+@inline function (ensemble::EnsembleBoundaryCondition)(u_inner, args...)
+    geometry = args[1:(end - 2)]
+    surface_flux = args[end - 1]
+    equations = args[end]
+    return map_members(k -> ensemble.boundary_condition(member_vars(u_inner, k, equations),
+                                                        geometry..., surface_flux.flux,
+                                                        equations.equations), equations)
+end
+
+
+ensemble_boundary_condition(boundary_condition::Trixi.BoundaryConditionPeriodic) =
+    boundary_condition
+ensemble_boundary_condition(boundary_condition) =
+    EnsembleBoundaryCondition(boundary_condition)
+
+ensemble_boundary_conditions(boundary_conditions::Trixi.BoundaryConditionPeriodic) =
+    boundary_conditions
+ensemble_boundary_conditions(boundary_conditions::NamedTuple) =
+    map(ensemble_boundary_condition, boundary_conditions)
+function ensemble_boundary_conditions(boundary_conditions)
+    error("unsupported boundary conditions for ensembles: ", typeof(boundary_conditions))
+end
+
+ensemble_source_terms(::Nothing) = nothing
+ensemble_source_terms(source_terms) = EnsembleSourceTerms(source_terms)
+
+ensemble_volume_integral(volume_integral::Trixi.VolumeIntegralWeakForm) = volume_integral
+function ensemble_volume_integral(volume_integral::Trixi.VolumeIntegralFluxDifferencing)
+    return Trixi.VolumeIntegralFluxDifferencing(EnsembleFlux(volume_integral.volume_flux))
+end
+function ensemble_volume_integral(volume_integral)
+    error("unsupported volume integral for ensembles: ", typeof(volume_integral))
+end
+
+
+"""
+    create_ensemble(simstate, n_members)
+
+Return a new [`SimulationState`](@ref) that advances `n_members` copies of `simstate` at
+once, using [`EnsembleEquations`](@ref) on the same mesh with a single solver cache. The
+mesh is shared with `simstate` and only released when both have been finalized. All
+members start from the current solution and time of `simstate`; individual initial data
+can be set with [`store_member_conservative_vars!`](@ref). Only the `StepsizeCallback` is
+taken over from `simstate`.
+"""
+function create_ensemble(simstate, n_members)
+    semi = simstate.semi
+    integrator = simstate.integrator
+    mesh, equations, solver, cache = mesh_equations_solver_cache(semi)
+
+    if n_members < 1
+        error("number of ensemble members must be positive: ", n_members)
+    end
+    if !(solver isa Trixi.DGSEM)
+        error("ensembles are only supported for DGSEM solvers")
+    end
+    if Trixi.have_nonconservative_terms(equations) isa Trixi.True
+        error("ensembles are not supported for equations with nonconservative terms")
+    end
+
+    equations_ensemble = EnsembleEquations(equations, n_members)
+    surface_flux = EnsembleFlux(solver.surface_integral.surface_flux)
+    solver_ensemble = Trixi.DGSEM(solver.basis, Trixi.SurfaceIntegralWeakForm(surface_flux),
+                                  ensemble_volume_integral(solver.volume_integral),
+                                  solver.mortar)
+    initial_condition = EnsembleInitialCondition(semi.initial_condition)
+    boundary_conditions = ensemble_boundary_conditions(semi.boundary_conditions)
+    source_terms = ensemble_source_terms(semi.source_terms)
+    semi_ensemble = Trixi.remake(semi; equations = equations_ensemble,
+                                 solver = solver_ensemble, initial_condition,
+                                 boundary_conditions, source_terms)
+
+    # all members start from the current solution
+    ode = Trixi.semidiscretize(semi_ensemble, (integrator.t, integrator.sol.prob.tspan[2]))
+    u_ensemble = reshape(ode.u0, n_members, nvariables(equations), :)
+    u = reshape(integrator.u, 1, nvariables(equations), :)
+    u_ensemble .= u
+
+    is_stepsize_callback(cb) = cb isa DiscreteCallback{<:Any, <:Trixi.StepsizeCallback}
+    callbacks = CallbackSet(filter(is_stepsize_callback,
+                                   integrator.opts.callback.discrete_callbacks)...)
+    integrator_ensemble = init(ode, integrator.alg; dt = integrator.dt,
+                               save_everystep = false, adaptive = integrator.opts.adaptive,
+                               callback = callbacks)
+
+    # both simulation states use the mesh until they are finalized
+    share_mesh!(mesh)
+
+    return SimulationState(semi_ensemble, integrator_ensemble)
+end
+
+
+# Number of members of a simulation (one for regular simulations)
+function nmembers(simstate::SimulationState)
+    _, equations, _, _ = mesh_equations_solver_cache(simstate.semi)
+    return equations isa EnsembleEquations ? nmembers(equations) : 1
+end
+
+# View of the conservative variables of a member, with the same layout as the solution of a
+# regular simulation
+function member_conservative_vars(simstate::SimulationState, member)
+    n_members = nmembers(simstate)
+    if !(1 <= member <= n_members)
+        error("member ", member, " does not exist, number of members: ", n_members)
+    end
+
+    _, equations, _, _ = mesh_equations_solver_cache(simstate.semi)
+    n_variables = nvariables(equations) ÷ n_members
+    u = reshape(simstate.integrator.u, n_members, n_variables, :)
+
+    return view(u, member, :, :)
+end
+
+"""
+    store_member_conservative_vars!(simstate, member, data)
+
+Overwrite the conservative variables of ensemble member `member` with `data`, which has the
+same layout as the solution vector of a regular simulation, with the elements in the order
+set by [`set_element_ordering!`](@ref).
+"""
+function store_member_conservative_vars!(simstate, member, data)
+    u_member = member_conservative_vars(simstate, member)
+    data_member = reshape(data, size(u_member))
+
+    # data is given in the element order of the host
+    positions = element_positions(simstate)
+    n_nodes = size(u_member, 2) ÷ length(positions)
+    for element in eachindex(positions), node in 1:n_nodes
+        dof = (element - 1) * n_nodes + node
+        u_member[:, dof] .= view(data_member, :,
+                                 host_dof_index(positions, element, node, n_nodes))
+    end
+    u_modified!(simstate.integrator, true)
+
+    return nothing
+end
@@ -0,0 +1,237 @@
+# Status of the solution, ordered by severity such that all ranks agree on the worst one
+const HEALTH_OK = 0
+const HEALTH_PRESSURE = 1            # non-positive pressure
+const HEALTH_DENSITY = 2             # non-positive density
+const HEALTH_NONFINITE = 3           # NaN or Inf in any conservative variable
+
+# Action taken when the solution is found to be unhealthy
+const HEALTH_REPORT = 0
+const HEALTH_STOP = 1
+const HEALTH_ROLLBACK = 2
+
+const health_descriptions = Dict(HEALTH_PRESSURE => "non-positive pressure",
+                                 HEALTH_DENSITY => "non-positive density",
+                                 HEALTH_NONFINITE => "non-finite value")
+
+
+"""
+    HealthCheck
+
+Settings and state for detecting a broken solution early. Every `interval` steps, all nodes
+are checked for non-finite conservative variables and, for equations that define them, for
+non-positive density and pressure. The first `n_report` offending elements of each rank are
+reported with their coordinates on the root rank, and depending on `action`
+- `HEALTH_REPORT`: the simulation continues and is not checked again,
+- `HEALTH_STOP`: the simulation is considered finished with the offending solution,
+- `HEALTH_ROLLBACK`: the solution before the offending step is restored, which requires a
+  copy of the solution before each checked step (allocated like all buffers of the
+  simulation, see [`allocate_buffer`](@ref)), and the simulation is considered finished.
+The agreement of all ranks is fused with the reduction of the [`Preemption`](@ref) check.
+"""
+mutable struct HealthCheck
+    interval::Int
+    action::Int
+    n_report::Int
+    status::Int                     # status found by the first failed check
+    element_status::Vector{Int8}
+    u_backup::Union{Vector{Float64}, Vector{Float32}}
+    t_backup::Float64
+
+    function HealthCheck(interval, action = HEALTH_STOP, n_report = 5)
+        if interval < 1
+            error("health check interval must be positive: ", interval)
+        end
+        if !(action in (HEALTH_REPORT, HEALTH_STOP, HEALTH_ROLLBACK))
+            error("invalid health check action: ", action)
+        end
+        if n_report < 1
+            error("number of reported elements must be positive: ", n_report)
+        end
+
+        return new(interval, action, n_report, HEALTH_OK, Int8[], Float64[], NaN)
+    end
+end
+
+
+# True if the simulation was stopped by the health check
+function is_unhealthy(simstate)
+    health = simstate.health_check
+    return !isnothing(health) && health.status != HEALTH_OK &&
+           health.action != HEALTH_REPORT
+end
+
+# The solution is checked after every `interval` steps until the first failure
+is_check_step(health::HealthCheck, iter) = health.status == HEALTH_OK &&
+                                           iter % health.interval == 0
+
+
+# Keep a copy of the solution if the next step is checked and may have to be rolled back,
+# in a buffer from `storage` that is only replaced if the solution does not fit anymore
+function backup_solution!(health::HealthCheck, integrator, storage)
+    if health.action == HEALTH_ROLLBACK && is_check_step(health, integrator.iter + 1)
+        if eltype(health.u_backup) != eltype(integrator.u) ||
+           length(health.u_backup) != length(integrator.u)
+            health.u_backup = allocate_buffer(storage, eltype(integrator.u),
+                                              length(integrator.u))
+        end
+        copyto!(health.u_backup, integrator.u)
+        health.t_backup = integrator.t
+    end
+
+    return nothing
+end
+
+
+# Density and pressure are only checked if the equations provide them
+function has_positivity(equations)
+    u_type = Trixi.SVector{nvariables(equations), Float64}
+    return hasmethod(Trixi.density, Tuple{u_type, typeof(equations)}) &&
+           hasmethod(Trixi.pressure, Tuple{u_type, typeof(equations)})
+end
+
+@inline function node_health(u_node, equations, ::Val{Positivity}) where {Positivity}
+    all(isfinite, u_node) || return HEALTH_NONFINITE
+    if Positivity
+        Trixi.density(u_node, equations) > 0 || return HEALTH_DENSITY
+        Trixi.pressure(u_node, equations) > 0 || return HEALTH_PRESSURE
+    end
+
+    return HEALTH_OK
+end
+
+# Store the worst status of the nodes of each element in `element_status` and return the
+# worst status on this rank
+function check_elements!(element_status, u, mesh, equations, solver, cache, positivity)
+    node_cis = CartesianIndices(ntuple(_ -> nnodes(solver), ndims(mesh)))
+    Trixi.@threaded for element in eachelement(solver, cache)
+        status = HEALTH_OK
+        for node_ci in node_cis
+            node_vars = get_node_vars(u, equations, solver, node_ci, element)
+            status = max(status, node_health(node_vars, equations, positivity))
+            status == HEALTH_NONFINITE && break
+        end
+        element_status[element] = status
+    end
+
+    return isempty(element_status) ? HEALTH_OK : Int(maximum(element_status))
+end
+
+function local_health_status!(simstate)
+    health = simstate.health_check
+    mesh, equations, solver, cache = mesh_equations_solver_cache(simstate.semi)
+    u = wrap_array(simstate.integrator.u, mesh, equations, solver, cache)
+
+    resize!(health.element_status, nelements(solver, cache))
+    return check_elements!(health.element_status, u, mesh, equations, solver, cache,
+                           Val(has_positivity(equations)))
+end
+
+
+"""
+    check_step!(simstate, step_time_ns)
+
+Run the [`HealthCheck`](@ref) and the [`Preemption`](@ref) check after a step, whichever
+are enabled and due, with a single reduction over all ranks to agree on their outcome. A
+simulation stopped by the health check is not preempted, such that no checkpoint of a broken
+solution is written.
+"""
+function check_step!(simstate, step_time_ns)
+    health = simstate.health_check
+    preemption = simstate.preemption
+    check_health = !isnothing(health) && is_check_step(health, simstate.integrator.iter)
+    check_preemption = !isnothing(preemption) && !preemption.triggered
+    check_health || check_preemption || return nothing
+
+    status = check_health ? local_health_status!(simstate) : HEALTH_OK
+    stop = check_preemption && preemption_requested!(preemption, step_time_ns)
+    if Trixi.mpi_isparallel()
+        status, stop = MPI.Allreduce([status, Int(stop)], max, Trixi.mpi_comm())
+    end
+
+    if status != HEALTH_OK
+        handle_unhealthy!(simstate, status)
+    end
+    if stop > 0 && !is_unhealthy(simstate)
+        preempt!(simstate)
+    end
+
+    return nothing
+end
+
+
+function handle_unhealthy!(simstate, status)
+    health = simstate.health_check
+    integrator = simstate.integrator
+    health.status = status
+    report_unhealthy_elements(simstate)
+
+    rolled_back = false
+    if health.action == HEALTH_ROLLBACK
+        # a changed mesh does not fit the backup anymore
+        restorable = length(health.u_backup) == length(integrator.u) &&
+                     !amr_was_applied(integrator)
+        if Trixi.mpi_isparallel()
+            restorable = MPI.Allreduce(Int(restorable), min, Trixi.mpi_comm()) > 0
+        end
+        if restorable
+            copyto!(integrator.u, health.u_backup)
+            set_t!(integrator, health.t_backup)
+            u_modified!(integrator, true)
+            rolled_back = true
+        end
+    end
+
+    if Trixi.mpi_isroot()
+        action = health.action == HEALTH_REPORT ? "continuing" :
+                 rolled_back ? "rolled back to t = $(integrator.t)" : "stopped"
+        log_message(LOG_ERROR,
+                    string("Solution has ", health_descriptions[status], " after step ",
+                           integrator.iter, ", simulation ", action);
+                    source = "health", status, t = integrator.t, iter = integrator.iter,
+                    action = health.action, rolled_back)
+    end
+
+    return nothing
+end
+
+
+# Report the first offending elements of all ranks with the center of their nodes on the
+# root rank
+function report_unhealthy_elements(simstate)
+    health = simstate.health_check
+    mesh, _, _, cache = mesh_equations_solver_cache(simstate.semi)
+    n_dims = ndims(mesh)
+    node_coordinates = reshape(cache.elements.node_coordinates, n_dims, :,
+                               length(health.element_status))
+
+    # element, status, and coordinates per record, unused records are NaN
+    records = fill(NaN, 5, health.n_report)
+    elements = findall(!iszero, health.element_status)
+    for (i, element) in enumerate(Iterators.take(elements, health.n_report))
+        records[1, i] = element
+        records[2, i] = health.element_status[element]
+        center = sum(view(node_coordinates, :, :, element), dims = 2) /
+                 size(node_coordinates, 2)
+        records[3:(2 + n_dims), i] .= vec(center)
+    end
+
+    if Trixi.mpi_isparallel()
+        records = MPI.Gather(vec(records), Trixi.mpi_comm())
+    end
+    Trixi.mpi_isroot() || return nothing
+
+    records = reshape(records, 5, health.n_report, :)
+    for rank in axes(records, 3), i in axes(records, 2)
+        isnan(records[1, i, rank]) && continue
+        element = Int(records[1, i, rank])
+        status = Int(records[2, i, rank])
+        coordinates = records[3:(2 + n_dims), i, rank]
+        log_message(LOG_ERROR,
+                    string(uppercasefirst(health_descriptions[status]), " in element ",
+                           element, " on rank ", rank - 1, " at ", coordinates);
+                    source = "health", status, element, element_rank = rank - 1,
+                    coordinates)
+    end
+
+    return nothing
+end
@@ -0,0 +1,294 @@
+# Log levels, identical to the values used in the C API
+const LOG_DEBUG = 0
+const LOG_INFO = 1
+const LOG_WARNING = 2
+const LOG_ERROR = 3
+
+const log_level_names = ("debug", "info", "warning", "error")
+
+
+"""
+    LogSink
+
+Destination for all output of LibTrixi and of the callbacks of the running simulations.
+Messages with a level of at least `min_level` are passed to `write(level, line)`, where
+`line` is either the plain message or, if `json` is true, a JSON object with the message and
+further structured fields (one object per line). Only ranks that are a multiple of
+`rank_stride` emit messages, i.e., `rank_stride = 0` restricts output to the root rank.
+
+The standard output of the process is not redirected. Instead, the callbacks of Trixi that
+print regularly are replaced by callbacks that emit records through the sink, see
+[`log_callback_output`](@ref), for all simulations initialized while a sink is active.
+
+Calls of `write` are serialized by [`log_message`](@ref), i.e., `write` does not need to be
+thread-safe. It may, however, be called from different threads if simulations are advanced
+concurrently by [`run_scheduler`](@ref).
+"""
+struct LogSink{WriteType}
+    write::WriteType
+    min_level::Int
+    rank_stride::Int
+    json::Bool
+
+    function LogSink(write, min_level, rank_stride, json)
+        if !(LOG_DEBUG <= min_level <= LOG_ERROR)
+            error("invalid log level: ", min_level)
+        end
+        if rank_stride < 0
+            error("rank stride must not be negative: ", rank_stride)
+        end
+
+        return new{typeof(write)}(write, min_level, rank_stride, json)
+    end
+end
+
+# Currently active sink (if any)
+const log_sink = Ref{Union{Nothing, LogSink}}(nothing)
+
+
+function log_rank()
+    return Trixi.mpi_isparallel() ? Trixi.mpi_rank() : 0
+end
+
+function rank_is_logging(sink::LogSink)
+    rank = log_rank()
+    return sink.rank_stride == 0 ? rank == 0 : rank % sink.rank_stride == 0
+end
+
+
+# Minimal JSON serialization for the value types used in log records
+json_value(io, value::AbstractString) = json_string(io, value)
+json_value(io, value::Symbol) = json_string(io, string(value))
+json_value(io, value::Bool) = print(io, value)
+json_value(io, value::Integer) = print(io, value)
+function json_value(io, value::Real)
+    isfinite(value) ? print(io, Float64(value)) : print(io, "null")
+end
+json_value(io, ::Nothing) = print(io, "null")
+
+function json_value(io, values::Union{AbstractVector, Tuple})
+    print(io, '[')
+    for (i, value) in enumerate(values)
+        i > 1 && print(io, ',')
+        json_value(io, value)
+    end
+    print(io, ']')
+end
+
+function json_string(io, s)
+    print(io, '"')
+    for c in s
+        if c == '"' || c == '\\'
+            print(io, '\\', c)
+        elseif c == '\n'
+            print(io, "\\n")
+        elseif c < ' '
+            print(io, "\\u", string(UInt16(c), base = 16, pad = 4))
+        else
+            print(io, c)
+        end
+    end
+    print(io, '"')
+end
+
+function json_record(level, message, fields)
+    io = IOBuffer()
+    print(io, "{\"level\":")
+    json_value(io, log_level_names[level + 1])
+    print(io, ",\"rank\":", log_rank(), ",\"walltime\":", time(), ",\"message\":")
+    json_value(io, message)
+    for (key, value) in pairs(fields)
+        print(io, ',')
+        json_string(io, string(key))
+        print(io, ':')
+        json_value(io, value)
+    end
+    print(io, '}')
+
+    return String(take!(io))
+end
+
+
+"""
+    log_message(level, message; fields...)
+
+Emit `message` with the given `level` through the active [`LogSink`](@ref), with additional
+structured `fields` for JSON output. Without a sink, the message is printed to `stdout`.
+Messages are emitted one at a time, also when called from concurrent tasks.
+"""
+function log_message(level, message; fields...)
+    sink = log_sink[]
+    if isnothing(sink)
+        lock(() -> println(message), log_lock)
+        return nothing
+    end
+
+    if level < sink.min_level || !rank_is_logging(sink)
+        return nothing
+    end
+
+    line = sink.json ? json_record(level, message, fields) : message
+    lock(() -> sink.write(level, line), log_lock)
+
+    return nothing
+end
+
+# Serializes the output of simulations that are advanced concurrently
+const log_lock = ReentrantLock()
+
+# Debug output of the library: shown with `LIBTRIXI_DEBUG` set to `julia` or `all` if no
+# sink is active, otherwise subject to the level filter of the sink
+function log_debug(args...)
+    if !isnothing(log_sink[])
+        log_message(LOG_DEBUG, string(args...))
+    elseif show_debug_output()
+        lock(() -> println(args...), log_lock)
+    end
+
+    return nothing
+end
+
+
+"""
+    set_log_sink!(write, min_level = LOG_INFO, rank_stride = 0, json = false)
+    set_log_sink!(nothing)
+
+Route all output through a new [`LogSink`](@ref), or restore printing to `stdout`.
+"""
+function set_log_sink!(write, min_level = LOG_INFO, rank_stride = 0, json = false)
+    set_log_sink!(nothing)
+
+    log_sink[] = LogSink(write, min_level, rank_stride, json)
+
+    return nothing
+end
+
+function set_log_sink!(::Nothing)
+    log_sink[] = nothing
+
+    return nothing
+end
+
+
+# Affect of an analysis callback that reports the error norms of Trixi's analysis callback
+# as a structured record instead of printing them. The original callback is kept such that
+# it can be rebuilt.
+struct LoggedAnalysis{CallbackType}
+    analysis_callback::CallbackType
+end
+
+# The error norms are only valid on the root rank
+function (logged::LoggedAnalysis)(integrator)
+    analysis = logged.analysis_callback.affect!
+    semi = integrator.p
+    l2_error, linf_error = Trixi.calc_error_norms(integrator.u, integrator.t,
+                                                  analysis.analyzer, semi, analysis.cache)
+    Trixi.mpi_isroot() || return nothing
+
+    _, equations, _, _ = mesh_equations_solver_cache(semi)
+    log_message(LOG_INFO,
+                string("analysis: t = ", integrator.t, ", L2 error = ", Vector(l2_error),
+                       ", Linf error = ", Vector(linf_error));
+                source = "analysis", t = integrator.t, iter = integrator.iter,
+                dt = integrator.dt,
+                variables = collect(Trixi.varnames(Trixi.cons2cons, equations)),
+                l2_error = Vector(l2_error), linf_error = Vector(linf_error))
+
+    return nothing
+end
+
+# Like Trixi's analysis callback, the initial solution is analyzed as well
+function logged_analysis_callback(analysis_callback)
+    logged = LoggedAnalysis(analysis_callback)
+    initialize = function (c, u, t, integrator)
+        logged(integrator)
+        u_modified!(integrator, false)
+    end
+    return DiscreteCallback(analysis_callback.condition, logged; initialize,
+                            save_positions = analysis_callback.save_positions)
+end
+
+
+# Affect of an alive callback that reports the progress as a structured record instead of
+# printing it
+struct LoggedAlive{CallbackType}
+    alive_callback::CallbackType
+end
+
+function (logged::LoggedAlive)(integrator)
+    Trixi.mpi_isroot() || return nothing
+
+    runtime = (time_ns() - logged.alive_callback.affect!.start_time) * 1.0e-9
+    log_message(LOG_INFO,
+                string("alive: step ", integrator.iter, ", dt = ", integrator.dt, ", t = ",
+                       integrator.t, ", run time = ", runtime, " s");
+                source = "alive", t = integrator.t, iter = integrator.iter,
+                dt = integrator.dt, runtime)
+
+    return nothing
+end
+
+# The run time is measured from the initialization on. A callback that replaces an already
+# initialized one keeps its start time once, but not when the simulation is reinitialized.
+function logged_alive_callback(alive_callback, initialized = false)
+    initialize = function (c, u, t, integrator)
+        if !initialized
+            alive_callback.affect!.start_time = time_ns()
+        end
+        initialized = false
+        u_modified!(integrator, false)
+    end
+    return DiscreteCallback(alive_callback.condition, LoggedAlive(alive_callback);
+                            initialize, save_positions = alive_callback.save_positions)
+end
+
+
+"""
+    log_callback_output(simstate)
+
+Return a new [`SimulationState`](@ref) in which the analysis and alive callbacks of
+`simstate` emit structured records through the active [`LogSink`](@ref) instead of printing
+to `stdout`. The time integrator is recreated at the current time with these callbacks
+replaced, while semidiscretization and all other callbacks are reused. The summary of
+Trixi's timers is logged when the simulation is finalized, see
+[`log_timer_summary`](@ref). Output that Trixi prints while the libelixir sets up the
+simulation, e.g., the setup summary on the root rank, is not affected.
+"""
+function log_callback_output(simstate)
+    discrete_callbacks = simstate.integrator.opts.callback.discrete_callbacks
+    if !any(cb -> cb isa DiscreteCallback{<:Any, <:Union{Trixi.AnalysisCallback,
+                                                            Trixi.AliveCallback}},
+            discrete_callbacks)
+        return simstate
+    end
+
+    callbacks = map(discrete_callbacks) do cb
+        if cb isa DiscreteCallback{<:Any, <:Trixi.AnalysisCallback}
+            # already initialized, the initial analysis must not be repeated
+            return reuse_callback(logged_analysis_callback(cb))
+        elseif cb isa DiscreteCallback{<:Any, <:Trixi.AliveCallback}
+            # already initialized, keep measuring the run time from the initialization
+            return logged_alive_callback(cb, true)
+        else
+            return reuse_callback(cb)
+        end
+    end
+
+    return replace_callbacks(simstate, callbacks)
+end
+
+
+"""
+    log_timer_summary()
+
+Emit the summary of Trixi's timers on the root rank as a message with the source `summary`,
+instead of printing it like Trixi's summary callback.
+"""
+function log_timer_summary()
+    Trixi.mpi_isroot() || return nothing
+
+    summary = sprint(io -> Trixi.TimerOutputs.print_timer(io, Trixi.timer()))
+    log_message(LOG_INFO, summary; source = "summary")
+
+    return nothing
+end
@@ -0,0 +1,216 @@
+"""
+    Nesting
+
+Two-way coupling between a parent simulation and a child simulation whose domain is a
+subregion of the parent domain.
+
+Parent-to-child: in a relaxation zone of width `relaxation_width` along the boundary of the
+child domain, the child solution is relaxed towards the interpolated parent solution. The
+relaxation weight is one at the child boundary and decays quadratically to zero at the
+inner edge of the zone. The zone is measured with respect to the axis-aligned bounding box
+of the child domain.
+
+Child-to-parent: parent solution values inside the child domain but outside the relaxation
+zone are replaced by `(1 - feedback_weight) * u_parent + feedback_weight * u_child`.
+
+All interpolation operators are precomputed and only rebuilt when the mesh of either
+simulation changes.
+"""
+mutable struct Nesting
+    parent::SimulationState
+    child::SimulationState
+    relaxation_width::Float64
+    feedback_weight::Float64
+    # mesh epochs of parent and child for which the operators below are valid
+    parent_epoch::Int
+    child_epoch::Int
+    # parent-to-child: child dofs in the relaxation zone with their weights
+    relaxation_dofs::Vector{Int}
+    relaxation_weights::Vector{Float64}
+    relaxation_operator::PointInterpolation
+    # child-to-parent: parent dofs inside the child domain
+    feedback_dofs::Vector{Int}
+    feedback_operator::PointInterpolation
+
+    function Nesting(parent, child, relaxation_width, feedback_weight)
+        if trixi_nvariables_jl(parent) != trixi_nvariables_jl(child)
+            error("parent and child simulation must have the same number of variables")
+        end
+        if trixi_ndims_jl(parent) != trixi_ndims_jl(child)
+            error("parent and child simulation must have the same number of dimensions")
+        end
+        if relaxation_width <= 0
+            error("relaxation width must be positive: ", relaxation_width)
+        end
+        if !(0 <= feedback_weight <= 1)
+            error("feedback weight must be in [0, 1]: ", feedback_weight)
+        end
+
+        nesting = new(parent, child, relaxation_width, feedback_weight)
+        update_nesting_operators!(nesting)
+
+        return nesting
+    end
+end
+
+
+# Signed distance of `x` to the boundary of the box given by `lower` and `upper` (negative
+# outside of the box)
+function boundary_distance(x, lower, upper)
+    return minimum(d -> min(x[d] - lower[d], upper[d] - x[d]), eachindex(lower))
+end
+
+
+# (Re-)compute all interpolation operators for the current meshes
+function update_nesting_operators!(nesting::Nesting)
+    child_lower, child_upper = domain_bounding_box(nesting.child)
+    width = nesting.relaxation_width
+
+    # child dofs in relaxation zone, interpolated from the parent
+    child_coordinates = dof_coordinates(nesting.child)
+    distances = [boundary_distance(x, child_lower, child_upper)
+                 for x in eachcol(child_coordinates)]
+    nesting.relaxation_dofs = findall(<(width), distances)
+    nesting.relaxation_weights = [(1 - distances[dof] / width)^2
+                                  for dof in nesting.relaxation_dofs]
+    relaxation_coordinates = child_coordinates[:, nesting.relaxation_dofs]
+    nesting.relaxation_operator = PointInterpolation(nesting.parent, relaxation_coordinates)
+    if !all(nesting.relaxation_operator.located)
+        error("relaxation zone of child simulation is not covered by parent mesh")
+    end
+
+    # parent dofs inside child domain (excluding the relaxation zone), interpolated from
+    # the child
+    parent_coordinates = dof_coordinates(nesting.parent)
+    distances = [boundary_distance(x, child_lower, child_upper)
+                 for x in eachcol(parent_coordinates)]
+    candidate_dofs = findall(>=(width), distances)
+    interpolation = PointInterpolation(nesting.child, parent_coordinates[:, candidate_dofs])
+    nesting.feedback_dofs = candidate_dofs[interpolation.located]
+    nesting.feedback_operator = interpolation
+
+    nesting.parent_epoch = nesting.parent.mesh_epoch
+    nesting.child_epoch = nesting.child.mesh_epoch
+
+    log_debug("Nesting operators updated: ", length(nesting.relaxation_dofs),
+              " relaxation dofs, ", length(nesting.feedback_dofs), " feedback dofs")
+
+    return nothing
+end
+
+
+# Rebuild the operators if either mesh has changed since they were last computed
+function ensure_nesting_operators!(nesting::Nesting)
+    if nesting.parent_epoch != nesting.parent.mesh_epoch ||
+       nesting.child_epoch != nesting.child.mesh_epoch
+        update_nesting_operators!(nesting)
+    end
+
+    return nothing
+end
+
+
+"""
+    nesting_interpolate!(nesting::Nesting)
+
+Relax the child solution in the relaxation zone towards the interpolated parent solution.
+"""
+function nesting_interpolate!(nesting::Nesting)
+    ensure_nesting_operators!(nesting)
+
+    parent_values = interpolate_to_points(nesting.relaxation_operator, nesting.parent)
+
+    integrator = nesting.child.integrator
+    u = reshape(integrator.u, size(parent_values, 1), :)
+    Trixi.@threaded for k in eachindex(nesting.relaxation_dofs)
+        dof = nesting.relaxation_dofs[k]
+        weight = nesting.relaxation_weights[k]
+        for v in axes(u, 1)
+            u[v, dof] = (1 - weight) * u[v, dof] + weight * parent_values[v, k]
+        end
+    end
+    u_modified!(integrator, true)
+
+    return nothing
+end
+
+
+"""
+    nesting_feedback!(nesting::Nesting)
+
+Blend the parent solution inside the child domain with the interpolated child solution.
+"""
+function nesting_feedback!(nesting::Nesting)
+    ensure_nesting_operators!(nesting)
+
+    child_values = interpolate_to_points(nesting.feedback_operator, nesting.child)
+    child_values = child_values[:, nesting.feedback_operator.located]
+
+    integrator = nesting.parent.integrator
+    weight = nesting.feedback_weight
+    u = reshape(integrator.u, size(child_values, 1), :)
+    Trixi.@threaded for k in eachindex(nesting.feedback_dofs)
+        dof = nesting.feedback_dofs[k]
+        for v in axes(u, 1)
+            u[v, dof] = (1 - weight) * u[v, dof] + weight * child_values[v, k]
+        end
+    end
+    u_modified!(integrator, true)
+
+    return nothing
+end
+
+
+# Let all nestings refer to `simstate_new` instead of `simstate_old`. The operators are
+# rebuilt automatically since the new simulation state has a different mesh epoch.
+function replace_nested_simstate!(simstate_old, simstate_new)
+    for nesting in values(nestings)
+        if nesting.parent === simstate_old
+            nesting.parent = simstate_new
+        end
+        if nesting.child === simstate_old
+            nesting.child = simstate_new
+        end
+    end
+
+    return nothing
+end
+
+
+# Global variables to store nestings, analogous to the simulation states
+const NestingHandle = Cint
+const nestings = Dict{NestingHandle, Nesting}()
+const nesting_counter = Ref(0)
+
+# Store nesting in the global nestings dict and return a C-compatible handle to it
+function store_nesting(nesting)
+    if nesting_counter[] >= typemax(NestingHandle)
+        error("maximum number of storable nestings reached: ", typemax(NestingHandle))
+    end
+
+    nesting_counter[] += 1
+    handle = nesting_counter[]
+    nestings[handle] = nesting
+
+    return handle
+end
+
+# Load the nesting identified by the handle from the global nestings dict
+function load_nesting(handle)
+    if !in(handle, keys(nestings))
+        error("the provided handle was not found in the stored nestings: ", handle)
+    end
+
+    return nestings[handle]
+end
+
+# Remove the nesting identified by the handle from the global nestings dict
+function delete_nesting!(handle)
+    if !in(handle, keys(nestings))
+        error("the provided handle was not found in the stored nestings: ", handle)
+    end
+
+    delete!(nestings, handle)
+
+    return handle
+end
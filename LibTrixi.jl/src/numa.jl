@@ -0,0 +1,190 @@
+# System call number of `move_pages`, which has no wrapper in glibc
+const SYS_move_pages = Sys.ARCH === :x86_64 ? 279 :
+                       Sys.ARCH === :aarch64 ? 239 :
+                       Sys.ARCH === :powerpc64le ? 301 : -1
+const MPOL_MF_MOVE = 2
+
+# Number of pages passed to a single `move_pages` call
+const numa_batch_size = 65536
+
+numa_available() = Sys.islinux() && SYS_move_pages > 0
+
+
+# NUMA node of the thread processing each chunk of `Trixi.@threaded` loops, determined with
+# such a loop of one index per chunk, since its threads need not be ordered like the Julia
+# thread ids; threads are only guaranteed to stay there if they are pinned, e.g., with
+# `JULIA_EXCLUSIVE=1`
+function thread_numa_nodes()
+    nodes = zeros(Int, Threads.nthreads())
+    Trixi.@threaded for chunk in eachindex(nodes)
+        nodes[chunk] = cpu_numa_node(ccall(:sched_getcpu, Cint, ()))
+    end
+
+    return nodes
+end
+
+function cpu_numa_node(cpu)
+    for entry in readdir("/sys/devices/system/cpu/cpu$cpu")
+        m = match(r"^node(\d+)$", entry)
+        isnothing(m) || return parse(Int, m[1])
+    end
+
+    return 0
+end
+
+
+# Chunk containing `index` of `1:n` in the contiguous partition used by `Trixi.@threaded`,
+# where the first `rem(n, n_threads)` chunks hold one index more than the others
+function owner_thread(index, n, n_threads)
+    chunk, remainder = divrem(n, n_threads)
+    n_large = remainder * (chunk + 1)
+    if index <= n_large
+        return div(index - 1, chunk + 1) + 1
+    else
+        return remainder + div(index - n_large - 1, chunk) + 1
+    end
+end
+
+
+# All arrays of the solution, the time integrator, and the solver cache that span at least
+# one page, without duplicates from arrays wrapping the same memory
+function numa_arrays(simstate)
+    arrays = Array[]
+    integrator = simstate.integrator
+    collect_arrays!(arrays, integrator.u, 0)
+    collect_arrays!(arrays, integrator.uprev, 0)
+    collect_arrays!(arrays, integrator.cache, 1)
+    collect_arrays!(arrays, simstate.semi.cache, 2)
+
+    return unique(a -> UInt(pointer(a)), arrays)
+end
+
+function collect_arrays!(arrays, x, depth)
+    if x isa Array
+        if isbitstype(eltype(x)) && sizeof(x) >= Mmap.PAGESIZE
+            push!(arrays, x)
+        end
+    elseif depth > 0 && (x isa Tuple || x isa NamedTuple)
+        foreach(value -> collect_arrays!(arrays, value, depth - 1), x)
+    elseif depth > 0 && isstructtype(typeof(x)) && !(x isa Function)
+        for name in fieldnames(typeof(x))
+            isdefined(x, name) && collect_arrays!(arrays, getfield(x, name), depth - 1)
+        end
+    end
+
+    return arrays
+end
+
+
+# Addresses of all memory pages of `array`
+function array_pages(array)
+    page_size = Mmap.PAGESIZE
+    start = UInt(pointer(array))
+    return collect((start - start % page_size):page_size:(start + sizeof(array) - 1))
+end
+
+# NUMA node of the thread processing each page of `array`, assuming that the threaded loops
+# run over the last dimension
+function target_nodes(array, pages, thread_nodes)
+    start = UInt(pointer(array))
+    n = size(array, ndims(array))
+    stride = length(array) ÷ n
+
+    return map(pages) do page
+        index = div(Int(max(page, start) - start), sizeof(eltype(array))) + 1
+        return Cint(thread_nodes[owner_thread(div(index - 1, stride) + 1, n,
+                                              length(thread_nodes))])
+    end
+end
+
+# Call `move_pages` to query the NUMA node of each page (if `targets` is `nothing`) or to
+# move them to `targets`. The node of each page (or a negative error code, e.g., for pages
+# not touched yet) is returned.
+function move_pages(pages, targets)
+    status = similar(pages, Cint)
+    batches = Iterators.partition(eachindex(pages), numa_batch_size)
+    GC.@preserve pages targets status for batch in batches
+        ret = ccall(:syscall, Clong,
+                    (Clong, Cint, Culong, Ptr{UInt}, Ptr{Cint}, Ptr{Cint}, Cint),
+                    SYS_move_pages, 0, length(batch), pointer(pages, first(batch)),
+                    isnothing(targets) ? C_NULL : pointer(targets, first(batch)),
+                    pointer(status, first(batch)), isnothing(targets) ? 0 : MPOL_MF_MOVE)
+        if ret < 0
+            error("move_pages failed: ", Libc.strerror(Libc.errno()))
+        end
+    end
+
+    return status
+end
+
+
+"""
+    place_numa!(simstate)
+
+Move the memory pages of the solution, the stage vectors of the time integrator, and the
+arrays of the solver cache to the NUMA node of the thread that processes them, using the
+same contiguous partition of elements (or interfaces etc.) over threads as
+`Trixi.@threaded`. Pages are usually placed on the node of the thread that first touches
+them, which for most arrays is the thread that allocated and initialized them, regardless
+of the threads that process them later. Moving the pages after the fact has the same effect
+as a parallel first touch at allocation, but works for arrays that already exist. For a
+lasting effect, threads have to be pinned. Arrays reallocated later, e.g., by AMR, are not
+placed again.
+"""
+function place_numa!(simstate)
+    if !numa_available()
+        log_debug("NUMA placement not available on this system")
+        return nothing
+    end
+
+    thread_nodes = thread_numa_nodes()
+    if allequal(thread_nodes)
+        log_debug("NUMA placement skipped, all threads run on node ", first(thread_nodes))
+        return nothing
+    end
+
+    arrays = numa_arrays(simstate)
+    for array in arrays
+        pages = array_pages(array)
+        GC.@preserve array move_pages(pages, target_nodes(array, pages, thread_nodes))
+    end
+
+    log_debug("NUMA placement of ", length(arrays), " arrays for thread nodes ",
+              thread_nodes)
+
+    return nothing
+end
+
+
+"""
+    numa_placement(simstate)
+
+Return the number of memory pages on each NUMA node (as a vector indexed by node number
+plus one) and the fraction of pages that reside on the node of the thread processing them,
+for all arrays considered by [`place_numa!`](@ref) on this rank. Pages that have not been
+touched yet are not counted. Without NUMA support, an empty vector and NaN are returned.
+"""
+function numa_placement(simstate)
+    if !numa_available()
+        return Int[], NaN
+    end
+
+    thread_nodes = thread_numa_nodes()
+    pages_per_node = Int[]
+    n_local = 0
+    for array in numa_arrays(simstate)
+        pages = array_pages(array)
+        status = GC.@preserve array move_pages(pages, nothing)
+        targets = target_nodes(array, pages, thread_nodes)
+        for (node, target) in zip(status, targets)
+            node >= 0 || continue
+            if node >= length(pages_per_node)
+                append!(pages_per_node, zeros(Int, node + 1 - length(pages_per_node)))
+            end
+            pages_per_node[node + 1] += 1
+            n_local += node == target
+        end
+    end
+
+    return pages_per_node, n_local / max(sum(pages_per_node), 1)
+end
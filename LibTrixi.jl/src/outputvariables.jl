@@ -0,0 +1,111 @@
+"""
+    OutputVariable
+
+User-defined quantity named `name` that is computed node-wise as `func(u, equations)`,
+where `u` holds the conservative variables at a single node as an `SVector`.
+"""
+struct OutputVariable{FuncType}
+    name::String
+    func::FuncType
+
+    function OutputVariable(name, func)
+        if isempty(name)
+            error("output variable name must not be empty")
+        end
+
+        return new{typeof(func)}(name, func)
+    end
+end
+
+# Compile a Julia expression that evaluates to a function `(u, equations) -> value`, e.g.,
+# `"Trixi.entropy"` or `"(u, equations) -> cons2prim(u, equations)[1]^2"`
+function OutputVariable(name, expression::AbstractString)
+    func = Base.eval(Main, Meta.parse(expression))
+    return OutputVariable(name, func)
+end
+
+
+# Conversion given as a C function `value = func(u, nvariables, userdata)`
+struct COutputFunction
+    func::Ptr{Cvoid}
+    userdata::Ptr{Cvoid}
+end
+
+@inline function (c_func::COutputFunction)(u::Trixi.SVector{N}, equations) where {N}
+    u_c = Trixi.SVector{N, Cdouble}(u)
+    return ccall(c_func.func, Cdouble, (Ref{Trixi.SVector{N, Cdouble}}, Cint, Ptr{Cvoid}),
+                 u_c, N, c_func.userdata)
+end
+
+
+"""
+    define_output_variable!(simstate, name, func_or_expression)
+
+Add a new [`OutputVariable`](@ref) to `simstate` and return its index. The conversion is
+either a callable `(u, equations) -> value` or a Julia expression that evaluates to one.
+Defining a variable with an existing name replaces the previous definition.
+"""
+function define_output_variable!(simstate, name, func_or_expression)
+    variable = OutputVariable(name, func_or_expression)
+
+    index = findfirst(v -> v.name == variable.name, simstate.output_variables)
+    if isnothing(index)
+        push!(simstate.output_variables, variable)
+        index = length(simstate.output_variables)
+    else
+        simstate.output_variables[index] = variable
+    end
+
+    return index
+end
+
+function load_output_variable(simstate, index)
+    if !(1 <= index <= length(simstate.output_variables))
+        error("output variable ", index, " does not exist, number of output variables: ",
+              length(simstate.output_variables))
+    end
+
+    return simstate.output_variables[index]
+end
+
+
+"""
+    load_output_variable!(data, simstate, index)
+
+Evaluate the output variable `index` at all nodes in a single threaded pass over the
+solution and store the values in `data`, with the same layout and element ordering as for
+primitive variables.
+"""
+function load_output_variable!(data, simstate, index)
+    variable = load_output_variable(simstate, index)
+
+    # the conversion may have been compiled after the caller, hence the dynamic call, which
+    # also acts as function barrier for the loop
+    Base.invokelatest(evaluate_output_variable!, data, variable.func, simstate.semi,
+                      simstate.integrator.u, element_positions(simstate))
+
+    return nothing
+end
+
+function evaluate_output_variable!(data, func, semi, u_ode, positions)
+    mesh, equations, solver, cache = mesh_equations_solver_cache(semi)
+    n_nodes_per_dim = nnodes(solver)
+    n_dims = ndims(mesh)
+    n_nodes = n_nodes_per_dim^n_dims
+
+    u = wrap_array(u_ode, mesh, equations, solver, cache)
+
+    # all permutations of nodes indices for arbitrary dimension
+    node_cis = CartesianIndices(ntuple(i -> n_nodes_per_dim, n_dims))
+    node_lis = LinearIndices(node_cis)
+
+    Trixi.@threaded for element in eachelement(solver, cache)
+        for node_ci in node_cis
+            node_vars = get_node_vars(u, equations, solver, node_ci, element)
+            node_index = host_dof_index(positions, element, node_lis[node_ci], n_nodes)
+            data[node_index] = func(node_vars, equations)
+        end
+    end
+
+    return nothing
+end
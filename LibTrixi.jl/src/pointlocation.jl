@@ -0,0 +1,353 @@
+"""
+    PointInterpolation
+
+Precomputed operator to interpolate the DG solution of a simulation to arbitrary physical
+points. Every rank contributes rank-local target points, which are only sent to the ranks
+whose local domain (bounding box) contains them. These ranks locate the points and return
+the interpolated values. Points that are found on several ranks (e.g., on partition
+boundaries) are owned by the lowest such rank.
+"""
+struct PointInterpolation
+    n_local_points::Int         # number of target points contributed by this rank
+    located::BitVector          # (n_local_points), true if point was found on any rank
+    # points sent to other ranks for location
+    send_counts::Vector{Int}    # number of rank-local points sent to each rank
+    found_counts::Vector{Int}   # number of these points found by each rank
+    value_index::Vector{Int}    # (n_local_points), column of the value from the owner
+    # points received from other ranks and located in rank-local elements
+    return_counts::Vector{Int}  # number of points found for each rank
+    elements::Vector{Int}       # element containing the point
+    basis::Array{Float64, 3}    # (nnodes, ndims, length(elements)), Lagrange basis
+end
+
+
+# Uniform Cartesian bins to quickly find candidate elements for a physical point
+struct ElementBins
+    lower::Vector{Float64}
+    upper::Vector{Float64}
+    bin_size::Vector{Float64}
+    n_bins::Int                 # per dimension
+    elements::Vector{Vector{Int}}
+end
+
+function ElementBins(element_lower, element_upper)
+    n_dims, n_elements = size(element_lower)
+    n_bins = max(1, floor(Int, n_elements^(1 / n_dims)))
+
+    if n_elements == 0
+        return ElementBins(fill(Inf, n_dims), fill(-Inf, n_dims), ones(n_dims), 1,
+                           [Int[]])
+    end
+
+    lower = vec(minimum(element_lower, dims = 2))
+    upper = vec(maximum(element_upper, dims = 2))
+    bin_size = max.((upper .- lower) ./ n_bins, eps())
+
+    bin_lis = LinearIndices(ntuple(_ -> n_bins, n_dims))
+    elements = [Int[] for _ in bin_lis]
+    for element in 1:n_elements
+        first_bin = bin_index(lower, bin_size, n_bins, view(element_lower, :, element))
+        last_bin = bin_index(lower, bin_size, n_bins, view(element_upper, :, element))
+        for bin in CartesianIndex(first_bin):CartesianIndex(last_bin)
+            push!(elements[bin_lis[bin]], element)
+        end
+    end
+
+    return ElementBins(lower, upper, bin_size, n_bins, elements)
+end
+
+function bin_index(lower, bin_size, n_bins, x)
+    return ntuple(d -> clamp(floor(Int, (x[d] - lower[d]) / bin_size[d]) + 1, 1, n_bins),
+                  length(lower))
+end
+
+function candidate_elements(bins::ElementBins, x)
+    if any(d -> !(bins.lower[d] <= x[d] <= bins.upper[d]), eachindex(bins.lower))
+        return Int[]
+    end
+
+    index = bin_index(bins.lower, bins.bin_size, bins.n_bins, x)
+    bin_lis = LinearIndices(ntuple(_ -> bins.n_bins, length(bins.lower)))
+    return bins.elements[bin_lis[index...]]
+end
+
+
+# Axis-aligned bounding boxes of all elements, slightly enlarged to account for curved
+# elements bulging out between their nodes
+function element_bounding_boxes(node_coordinates, n_dims)
+    n_elements = size(node_coordinates, n_dims + 2)
+    coordinates = reshape(node_coordinates, n_dims, :, n_elements)
+    lower = dropdims(minimum(coordinates, dims = 2), dims = 2)
+    upper = dropdims(maximum(coordinates, dims = 2), dims = 2)
+
+    margin = 0.05 .* (upper .- lower)
+    return lower .- margin, upper .+ margin
+end
+
+
+# Compute the reference coordinates of the physical point `x` in the element given by its
+# node coordinates with Newton's method. Return `nothing` if the point is not inside.
+function reference_coordinates(x, element_coordinates, basis, barycentric_weights)
+    n_dims = length(x)
+    n_nodes = length(basis.nodes)
+    node_cis = CartesianIndices(ntuple(_ -> n_nodes, n_dims))
+    tolerance = 1.0e-12
+
+    xi = zeros(n_dims)
+    x_xi = zeros(n_dims)
+    jacobian = zeros(n_dims, n_dims)
+    for iteration in 1:20
+        # Lagrange basis and its derivative (l'(xi) = D^T l(xi)) in each direction
+        l = [Trixi.lagrange_interpolating_polynomials(xi[d], basis.nodes,
+                                                      barycentric_weights)
+             for d in 1:n_dims]
+        dl = [transpose(basis.derivative_matrix) * l[d] for d in 1:n_dims]
+
+        fill!(x_xi, zero(eltype(x_xi)))
+        fill!(jacobian, zero(eltype(jacobian)))
+        for node_ci in node_cis
+            index = Tuple(node_ci)
+            weight = prod(d -> l[d][index[d]], 1:n_dims)
+            for i in 1:n_dims
+                x_xi[i] += weight * element_coordinates[i, node_ci]
+            end
+            for k in 1:n_dims
+                dweight = prod(d -> d == k ? dl[d][index[d]] : l[d][index[d]], 1:n_dims)
+                for i in 1:n_dims
+                    jacobian[i, k] += dweight * element_coordinates[i, node_ci]
+                end
+            end
+        end
+
+        delta = jacobian \ (x .- x_xi)
+        xi .+= delta
+
+        # Newton's method diverges for points far outside of the element
+        if any(abs.(xi) .> 3)
+            return nothing
+        end
+
+        if maximum(abs, delta) < tolerance
+            return all(abs.(xi) .<= 1 + 1.0e-10) ? clamp.(xi, -1, 1) : nothing
+        end
+    end
+
+    return nothing
+end
+
+
+# Exchange the consecutive blocks of `data` with `send_counts[rank + 1]` entries for each
+# rank, receiving `recv_counts[rank + 1]` entries from each rank
+function exchange(data, send_counts, recv_counts)
+    if !Trixi.mpi_isparallel()
+        return copy(data)
+    end
+
+    received = similar(data, sum(recv_counts))
+    MPI.Alltoallv!(MPI.VBuffer(data, send_counts), MPI.VBuffer(received, recv_counts),
+                   Trixi.mpi_comm())
+
+    return received
+end
+
+# Ranges of the consecutive blocks with `counts[rank + 1]` entries for each rank
+function ranges_from_counts(counts)
+    offsets = cumsum(counts)
+    return [(offsets[i] - counts[i] + 1):offsets[i] for i in eachindex(counts)]
+end
+
+function exchange_counts(send_counts)
+    if !Trixi.mpi_isparallel()
+        return copy(send_counts)
+    end
+
+    return MPI.Alltoall(MPI.UBuffer(send_counts, 1), Trixi.mpi_comm())
+end
+
+# Bounding boxes of the local domains of all ranks as arrays of size (ndims, nranks)
+function rank_bounding_boxes(element_lower, element_upper)
+    n_dims = size(element_lower, 1)
+    lower = fill(Inf, n_dims)
+    upper = fill(-Inf, n_dims)
+    if size(element_lower, 2) > 0
+        lower .= vec(minimum(element_lower, dims = 2))
+        upper .= vec(maximum(element_upper, dims = 2))
+    end
+
+    if !Trixi.mpi_isparallel()
+        return reshape(lower, n_dims, 1), reshape(upper, n_dims, 1)
+    end
+
+    comm = Trixi.mpi_comm()
+    return reshape(MPI.Allgather(lower, comm), n_dims, :),
+           reshape(MPI.Allgather(upper, comm), n_dims, :)
+end
+
+
+"""
+    PointInterpolation(simstate, points)
+
+Locate the rank-local physical `points` of size (ndims, n_points) in the mesh of `simstate`
+and precompute the Lagrange basis needed for interpolating the solution to these points.
+Each point is only sent to the ranks whose local domain contains it, i.e., the
+communication volume does not grow with the global number of points. This function has to
+be called collectively by all ranks.
+"""
+function PointInterpolation(simstate, points)
+    mesh, _, solver, cache = mesh_equations_solver_cache(simstate.semi)
+    n_dims = ndims(mesh)
+    n_nodes = nnodes(solver)
+    basis = solver.basis
+    barycentric_weights = Trixi.barycentric_weights(basis.nodes)
+    node_coordinates = cache.elements.node_coordinates
+    n_local_points = size(points, 2)
+
+    element_lower, element_upper = element_bounding_boxes(node_coordinates, n_dims)
+    bins = ElementBins(element_lower, element_upper)
+
+    # send each point to all ranks whose bounding box contains it, ordered by rank
+    rank_lower, rank_upper = rank_bounding_boxes(element_lower, element_upper)
+    destinations = map(axes(rank_lower, 2)) do rank
+        return filter(1:n_local_points) do point
+            return all(d -> rank_lower[d, rank] <= points[d, point] <= rank_upper[d, rank],
+                       1:n_dims)
+        end
+    end
+    send_points = reduce(vcat, destinations; init = Int[])
+    send_counts = length.(destinations)
+    recv_counts = exchange_counts(send_counts)
+    recv_points = reshape(exchange(Vector{Float64}(vec(points[:, send_points])),
+                                   n_dims .* send_counts, n_dims .* recv_counts),
+                          n_dims, :)
+
+    n_recv_points = size(recv_points, 2)
+    found_elements = zeros(Int, n_recv_points)
+    found_coordinates = zeros(n_dims, n_recv_points)
+    Trixi.@threaded for point in 1:n_recv_points
+        x = recv_points[:, point]
+        for element in candidate_elements(bins, x)
+            if any(d -> !(element_lower[d, element] <= x[d] <= element_upper[d, element]),
+                   1:n_dims)
+                continue
+            end
+
+            element_coordinates = selectdim(node_coordinates, n_dims + 2, element)
+            xi = reference_coordinates(x, element_coordinates, basis, barycentric_weights)
+            if !isnothing(xi)
+                found_elements[point] = element
+                found_coordinates[:, point] .= xi
+                break
+            end
+        end
+    end
+
+    # tell the senders which points were found, values are only returned for these
+    found = found_elements .> 0
+    recv_ranges = ranges_from_counts(recv_counts)
+    return_counts = [count(view(found, range)) for range in recv_ranges]
+    found_flags = exchange(Vector{UInt8}(found), recv_counts, send_counts)
+    found_counts = [count(!iszero, view(found_flags, range))
+                    for range in ranges_from_counts(send_counts)]
+
+    # the values of all found points arrive ordered by rank, the first one is the owner's
+    value_index = zeros(Int, n_local_points)
+    n_values = 0
+    for (k, point) in enumerate(send_points)
+        iszero(found_flags[k]) && continue
+        n_values += 1
+        if value_index[point] == 0
+            value_index[point] = n_values
+        end
+    end
+    located = BitVector(value_index .> 0)
+
+    found_points = findall(found)
+    elements = found_elements[found_points]
+    interpolation_basis = zeros(n_nodes, n_dims, length(found_points))
+    for (k, point) in enumerate(found_points)
+        for d in 1:n_dims
+            interpolation_basis[:, d, k] .= Trixi.lagrange_interpolating_polynomials(
+                found_coordinates[d, point], basis.nodes, barycentric_weights)
+        end
+    end
+
+    return PointInterpolation(n_local_points, located, send_counts, found_counts,
+                              value_index, return_counts, elements, interpolation_basis)
+end
+
+
+"""
+    interpolate_to_points(interpolation::PointInterpolation, simstate)
+
+Interpolate the conservative variables of `simstate` to the target points and return the
+values at the rank-local target points as array of size (nvariables, n_local_points).
+Values at points that were not located are zero. Only the values of located points are
+communicated. This function has to be called collectively by all ranks.
+"""
+function interpolate_to_points(interpolation::PointInterpolation, simstate)
+    mesh, equations, solver, cache = mesh_equations_solver_cache(simstate.semi)
+    n_dims = ndims(mesh)
+    n_variables = nvariables(equations)
+    u = wrap_array(simstate.integrator.u, mesh, equations, solver, cache)
+
+    # all permutations of nodes indices for arbitrary dimension
+    node_cis = CartesianIndices(ntuple(i -> nnodes(solver), n_dims))
+
+    # values at the points located in rank-local elements, ordered by requesting rank
+    found_values = zeros(n_variables, length(interpolation.elements))
+    Trixi.@threaded for k in eachindex(interpolation.elements)
+        element = interpolation.elements[k]
+        for node_ci in node_cis
+            weight = 1.0
+            for (d, node_index) in enumerate(Tuple(node_ci))
+                weight *= interpolation.basis[node_index, d, k]
+            end
+            for v in 1:n_variables
+                found_values[v, k] += weight * u[v, node_ci, element]
+            end
+        end
+    end
+
+    received = reshape(exchange(vec(found_values),
+                                n_variables .* interpolation.return_counts,
+                                n_variables .* interpolation.found_counts),
+                       n_variables, :)
+
+    values = zeros(n_variables, interpolation.n_local_points)
+    for point in 1:interpolation.n_local_points
+        index = interpolation.value_index[point]
+        if index > 0
+            values[:, point] .= view(received, :, index)
+        end
+    end
+
+    return values
+end
+
+
+# Coordinates of all rank-local degrees of freedom as array of size (ndims, ndofs)
+function dof_coordinates(simstate)
+    mesh, _, _, cache = mesh_equations_solver_cache(simstate.semi)
+    return reshape(cache.elements.node_coordinates, ndims(mesh), :)
+end
+
+
+# Global axis-aligned bounding box of the simulation domain
+function domain_bounding_box(simstate)
+    coordinates = dof_coordinates(simstate)
+    n_dims = size(coordinates, 1)
+
+    lower = fill(Inf, n_dims)
+    upper = fill(-Inf, n_dims)
+    if size(coordinates, 2) > 0
+        lower .= vec(minimum(coordinates, dims = 2))
+        upper .= vec(maximum(coordinates, dims = 2))
+    end
+
+    if Trixi.mpi_isparallel()
+        MPI.Allreduce!(lower, min, Trixi.mpi_comm())
+        MPI.Allreduce!(upper, max, Trixi.mpi_comm())
+    end
+
+    return lower, upper
+end
@@ -0,0 +1,300 @@
+# Matrix that projects nodal values on the 1D nodes `nodes_in` to the nodes `nodes_out` via
+# the Legendre modes. Increasing the polynomial degree is exact, decreasing it truncates the
+# highest modes, which is the L2 projection on the reference element.
+function projection_matrix(nodes_in, nodes_out)
+    n_modes = min(length(nodes_in), length(nodes_out))
+    _, inverse_vandermonde = Trixi.vandermonde_legendre(nodes_in)
+    vandermonde_out = [Trixi.legendre_polynomial_and_derivative(m - 1, x)[1]
+                       for x in nodes_out, m in 1:n_modes]
+
+    return vandermonde_out * inverse_vandermonde[1:n_modes, :]
+end
+
+
+# Project nodal data with `n_variables` variables per node, stored in the same layout as the
+# DG solution, element-wise with the 1D `projection` matrix
+function project_nodal_data(data, n_variables, n_dims, projection)
+    n_nodes_in = size(projection, 2)
+    n_nodes_out = size(projection, 1)
+    data_in = reshape(data, n_variables, ntuple(_ -> n_nodes_in, n_dims)..., :)
+    n_elements = size(data_in, n_dims + 2)
+    data_out = Array{eltype(data)}(undef, n_variables, ntuple(_ -> n_nodes_out, n_dims)...,
+                                   n_elements)
+
+    Trixi.@threaded for element in 1:n_elements
+        element_in = selectdim(data_in, n_dims + 2, element)
+        selectdim(data_out, n_dims + 2, element) .= Trixi.multiply_dimensionwise(projection,
+                                                                                 element_in)
+    end
+
+    return vec(data_out)
+end
+
+
+# Recreate those parts of the solver, indicators, and controllers that depend on the basis
+remake_volume_integral(volume_integral::Trixi.VolumeIntegralWeakForm, equations, basis) =
+    volume_integral
+remake_volume_integral(volume_integral::Trixi.VolumeIntegralFluxDifferencing, equations,
+                       basis) = volume_integral
+
+function remake_volume_integral(volume_integral::Trixi.VolumeIntegralShockCapturingHG,
+                                equations, basis)
+    indicator = volume_integral.indicator
+    if !(indicator isa Trixi.IndicatorHennemannGassner)
+        error("unsupported shock-capturing indicator: ", typeof(indicator))
+    end
+
+    indicator_new = Trixi.IndicatorHennemannGassner(equations, basis;
+                                                    alpha_max = indicator.alpha_max,
+                                                    alpha_min = indicator.alpha_min,
+                                                    alpha_smooth = indicator.alpha_smooth,
+                                                    variable = indicator.variable)
+
+    (; volume_flux_dg, volume_flux_fv) = volume_integral
+    return Trixi.VolumeIntegralShockCapturingHG(indicator_new; volume_flux_dg,
+                                                volume_flux_fv)
+end
+
+function remake_volume_integral(volume_integral, equations, basis)
+    error("unsupported volume integral: ", typeof(volume_integral))
+end
+
+
+function remake_indicator(indicator::Trixi.IndicatorHennemannGassner, semi)
+    return Trixi.IndicatorHennemannGassner(semi; alpha_max = indicator.alpha_max,
+                                           alpha_min = indicator.alpha_min,
+                                           alpha_smooth = indicator.alpha_smooth,
+                                           variable = indicator.variable)
+end
+
+function remake_indicator(indicator::Trixi.IndicatorLöhner, semi)
+    return Trixi.IndicatorLöhner(semi; f_wave = indicator.f_wave,
+                                 variable = indicator.variable)
+end
+
+function remake_indicator(indicator::Trixi.IndicatorMax, semi)
+    return Trixi.IndicatorMax(semi; variable = indicator.variable)
+end
+
+function remake_indicator(indicator, semi)
+    error("unsupported AMR indicator: ", typeof(indicator))
+end
+
+
+function remake_controller(controller::Trixi.ControllerThreeLevel, semi)
+    return Trixi.ControllerThreeLevel(semi, remake_indicator(controller.indicator, semi);
+                                      base_level = controller.base_level,
+                                      med_level = controller.med_level,
+                                      med_threshold = controller.med_threshold,
+                                      max_level = controller.max_level,
+                                      max_threshold = controller.max_threshold)
+end
+
+function remake_controller(controller, semi)
+    error("unsupported AMR controller: ", typeof(controller))
+end
+
+
+# Callbacks that do not depend on the basis are reused, but they must not be initialized a
+# second time since this would, e.g., write output files again or reset the timers
+function reuse_callback(cb)
+    initialize = (c, u, t, integrator) -> u_modified!(integrator, false)
+    return DiscreteCallback(cb.condition, cb.affect!; initialize, finalize = cb.finalize,
+                            save_positions = cb.save_positions)
+end
+
+function remake_callback(cb, semi)
+    if cb isa DiscreteCallback{<:Any, <:Trixi.AnalysisCallback}
+        analysis = cb.affect!
+        return Trixi.AnalysisCallback(semi; interval = analysis.interval,
+                                      save_analysis = analysis.save_analysis,
+                                      output_directory = analysis.output_directory,
+                                      analysis_filename = analysis.analysis_filename,
+                                      analysis_errors = analysis.analysis_errors,
+                                      analysis_integrals = analysis.analysis_integrals)
+    elseif cb isa DiscreteCallback{<:Any, <:Trixi.AMRCallback}
+        amr = cb.affect!
+        return Trixi.AMRCallback(semi, remake_controller(amr.controller, semi);
+                                 interval = amr.interval,
+                                 adapt_initial_condition = false,
+                                 dynamic_load_balancing = amr.dynamic_load_balancing)
+    elseif cb isa DiscreteCallback{<:Any, <:LoggedAnalysis}
+        return logged_analysis_callback(remake_callback(cb.affect!.analysis_callback, semi))
+    elseif cb isa DiscreteCallback{<:Any, <:LoggedAlive}
+        return logged_alive_callback(cb.affect!.alive_callback, true)
+    elseif cb isa DiscreteCallback{<:Any, <:AutotunedAMR}
+        # keep tuning with the same tuner, but for the rebuilt AMR callback
+        autotuned = cb.affect!
+        return autotuned_amr_callback(remake_callback(autotuned.amr_callback, semi),
+                                      autotuned.tuner)
+    elseif cb isa DiscreteCallback{<:Any, <:Trixi.StepsizeCallback}
+        # needs to be initialized again to compute the time step for the new degree
+        return cb
+    else
+        return reuse_callback(cb)
+    end
+end
+
+
+"""
+    set_polydeg(simstate, polydeg)
+
+Return a new [`SimulationState`](@ref) in which the DGSEM solver of `simstate` uses
+polynomial degree `polydeg`, while mesh, equations, and all other settings are unchanged.
+The solution is projected to the new basis, see [`projection_matrix`](@ref). The time
+integrator is recreated at the current time, with all callbacks that depend on the basis
+rebuilt for the new degree.
+
+The registry is shared with `simstate`, but all its entries are invalidated, see
+[`invalidate_registry!`](@ref): registered data may be owned by the host and may or may not
+depend on the nodes, thus it cannot be projected reliably. Data vectors have to be
+registered or allocated again for the new degree, until then stepping fails with an error
+(see [`check_registry`](@ref)).
+"""
+function set_polydeg(simstate, polydeg)
+    _, _, solver, _ = mesh_equations_solver_cache(simstate.semi)
+
+    if !(solver isa Trixi.DGSEM)
+        error("changing the polynomial degree is only supported for DGSEM solvers")
+    end
+    if polydeg < 1
+        error("polynomial degree must be at least 1: ", polydeg)
+    end
+
+    basis = Trixi.LobattoLegendreBasis(real(solver), polydeg)
+    projection = projection_matrix(solver.basis.nodes, basis.nodes)
+    uEltype = eltype(simstate.integrator.u)
+
+    simstate_new = rebuild_simstate(simstate, basis, uEltype, projection)
+    invalidate_registry!(simstate_new.registry)
+
+    return simstate_new
+end
+
+
+"""
+    invalidate_registry!(registry)
+
+Remove all data vectors from `registry` while keeping its length, such that the same
+indices can be registered again, e.g., with [`trixi_register_data`](@ref). The memory of
+host-owned vectors is no longer referenced; library-owned vectors are released by the
+garbage collector, which invalidates the pointers returned for them.
+"""
+function invalidate_registry!(registry)
+    n_entries = length(registry)
+
+    # new entries of a vector with non-bits element type are unassigned
+    resize!(registry, 0)
+    resize!(registry, n_entries)
+
+    return registry
+end
+
+# Fail explicitly if the right-hand side might access an unassigned entry of `registry`,
+# e.g., since not all data was registered again after the registry was invalidated
+function check_registry(registry)
+    for i in eachindex(registry)
+        if !isassigned(registry, i)
+            error("data registry entry ", i, " is not assigned, register or allocate data ",
+                  "before the next step")
+        end
+    end
+
+    return nothing
+end
+
+# Fail if data with element type `T` cannot be stored in `registry` without a conversion,
+# which would detach the stored vector from the host memory
+function check_registry_eltype(registry, T)
+    if eltype(eltype(registry)) != T
+        error("data of type ", T, " cannot be stored in a registry of ",
+              eltype(eltype(registry)), " vectors, use a ",
+              T == Float32 ? "LibTrixiDataRegistryF32" : "LibTrixiDataRegistry")
+    end
+
+    return nothing
+end
+
+
+# No projection if the nodes do not change
+project_nodal_data(data, n_variables, n_dims, ::Nothing) = data
+
+
+# Create an integrator for `ode` with the same algorithm, settings, and step counters as
+# `integrator`, but with the given callbacks
+function recreate_integrator(integrator, ode, callbacks)
+    integrator_new = init(ode, integrator.alg; dt = integrator.dt, save_everystep = false,
+                          adaptive = integrator.opts.adaptive,
+                          abstol = integrator.opts.abstol, reltol = integrator.opts.reltol,
+                          maxiters = integrator.opts.maxiters, callback = callbacks)
+    integrator_new.stats.naccept = integrator.stats.naccept
+    integrator_new.stats.nreject = integrator.stats.nreject
+    integrator_new.iter = integrator.iter
+
+    return integrator_new
+end
+
+
+# Recreate the integrator of `simstate` at the current time with `callbacks`, while the
+# semidiscretization is unchanged
+function replace_callbacks(simstate, callbacks)
+    integrator = simstate.integrator
+    t_end = integrator.sol.prob.tspan[2]
+    ode = ODEProblem(integrator.sol.prob.f, copy(integrator.u), (integrator.t, t_end),
+                     simstate.semi)
+    integrator_new = recreate_integrator(integrator, ode, CallbackSet(callbacks...))
+
+    simstate_new = SimulationState(simstate.semi, integrator_new, simstate.registry)
+    simstate_new.mesh_epoch = simstate.mesh_epoch
+    transfer_settings!(simstate_new, simstate)
+    simstate_new.element_ordering = simstate.element_ordering
+
+    return simstate_new
+end
+
+
+"""
+    rebuild_simstate(simstate, basis, uEltype, projection)
+
+Return a new [`SimulationState`](@ref) on the same mesh as `simstate`, with a DGSEM solver
+using `basis` and a solution of element type `uEltype`. The solution is projected with the
+1D matrix `projection` (or copied if it is `nothing`), while the registry of `simstate` is
+shared as it is. The time integrator is recreated at the current time, with all callbacks
+that depend on the basis rebuilt.
+"""
+function rebuild_simstate(simstate, basis, uEltype, projection)
+    semi = simstate.semi
+    integrator = simstate.integrator
+    mesh, equations, solver, cache = mesh_equations_solver_cache(semi)
+    n_dims = ndims(mesh)
+
+    # new solver and semidiscretization on the same mesh
+    volume_integral = remake_volume_integral(solver.volume_integral, equations, basis)
+    solver_new = Trixi.DGSEM(basis, solver.surface_integral, volume_integral)
+    semi_new = Trixi.remake(semi; uEltype, solver = solver_new)
+
+    # project solution and registered data
+    t = integrator.t
+    t_end = integrator.sol.prob.tspan[2]
+    ode = Trixi.semidiscretize(semi_new, (t, t_end))
+    copyto!(ode.u0, project_nodal_data(integrator.u, nvariables(equations), n_dims,
+                                       projection))
+
+    # recreate integrator with the same algorithm and step counters
+    callbacks = CallbackSet(map(cb -> remake_callback(cb, semi_new),
+                                integrator.opts.callback.discrete_callbacks)...)
+    integrator_new = recreate_integrator(integrator, ode, callbacks)
+
+    simstate_new = SimulationState(semi_new, integrator_new, simstate.registry)
+    simstate_new.mesh_epoch = simstate.mesh_epoch + 1
+    transfer_settings!(simstate_new, simstate)
+
+    # the elements themselves are unchanged, thus a valid element ordering remains valid
+    ordering = simstate.element_ordering
+    if !isnothing(ordering) && ordering.mesh_epoch == simstate.mesh_epoch
+        simstate_new.element_ordering = ElementOrdering(ordering.positions,
+                                                        simstate_new.mesh_epoch)
+    end
+
+    return simstate_new
+end
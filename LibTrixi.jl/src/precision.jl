@@ -0,0 +1,29 @@
+"""
+    set_precision(simstate, RealT, uEltype = RealT)
+
+Return a new [`SimulationState`](@ref) in which the solution and all solution-sized solver
+data are stored with element type `uEltype`, while the DGSEM basis and the geometric data
+derived from it (node coordinates, Jacobians, metric terms) use `RealT`. With
+`RealT = Float64` and `uEltype = Float32`, the geometry keeps full precision while the
+memory traffic for the solution is halved.
+
+The mesh itself is not rebuilt, i.e., mesh types that store their geometry independently of
+the solver keep the floating point type they were created with. Registered data vectors are
+kept as they are. The time integrator is recreated at the current time, which is stored in
+`Float64` regardless of the chosen precision.
+"""
+function set_precision(simstate, RealT, uEltype = RealT)
+    _, _, solver, _ = mesh_equations_solver_cache(simstate.semi)
+
+    if !(solver isa Trixi.DGSEM)
+        error("changing the precision is only supported for DGSEM solvers")
+    end
+
+    if RealT == real(solver)
+        basis = solver.basis
+    else
+        basis = Trixi.LobattoLegendreBasis(RealT, Trixi.polydeg(solver))
+    end
+
+    return rebuild_simstate(simstate, basis, uEltype, nothing)
+end
@@ -0,0 +1,183 @@
+"""
+    Preemption
+
+Settings and state for stopping a simulation ahead of a preemption or the end of the
+wall-time limit. After each step, all ranks agree on whether to stop, which is the case if
+- `handle_signals` is true and `SIGTERM` or `SIGUSR1` was received on any rank since the
+  simulation handles signals or was last preempted (see [`watch_signals!`](@ref)), or
+- the next step would exceed `walltime_budget` seconds since the preemption was set up,
+  estimated from the longest step so far.
+
+In that case, a restart file (and a mesh file) is written to `output_directory` on all ranks
+and the simulation is considered finished. The budget is ignored if it is not positive.
+"""
+mutable struct Preemption
+    walltime_budget::Float64
+    output_directory::String
+    handle_signals::Bool
+    start_time::Float64
+    max_step_time::Float64          # longest step so far (in seconds)
+    signal::Cint                    # signal received and not yet consumed by a preemption
+    triggered::Bool
+
+    function Preemption(walltime_budget, output_directory, handle_signals = false)
+        if isempty(output_directory)
+            error("checkpoint directory must not be empty")
+        end
+
+        preemption = new(walltime_budget, output_directory, handle_signals, time(), 0.0,
+                         0, false)
+        if handle_signals
+            watch_signals!(preemption)
+        end
+
+        return preemption
+    end
+end
+
+
+# Simulations that currently handle signals; a signal is passed on to all of them. The lock
+# guards the list and the signals recorded in it, which are shared by simulations that are
+# advanced concurrently
+const signal_watchers = Preemption[]
+const signal_lock = ReentrantLock()
+
+"""
+    watch_signals!(preemption)
+
+Let the signal thread of the C library wait for `SIGTERM` and `SIGUSR1` on behalf of
+`preemption`, until [`unwatch_signals!`](@ref) is called. As long as any simulation handles
+signals, they no longer terminate the process or trigger Julia's profiler, but are polled
+between steps by [`signal_received`](@ref). Afterwards, Julia's default signal handling
+applies again. See `src/signals.c` for details.
+"""
+function watch_signals!(preemption)
+    lock(signal_lock) do
+        any(p -> p === preemption, signal_watchers) && return nothing
+
+        push!(signal_watchers, preemption)
+        signal_thread_available() && ccall(:trixi_watch_signals, Cvoid, (Cint,), 1)
+    end
+
+    return nothing
+end
+
+function unwatch_signals!(preemption)
+    lock(signal_lock) do
+        index = findfirst(p -> p === preemption, signal_watchers)
+        isnothing(index) && return nothing
+
+        deleteat!(signal_watchers, index)
+        preemption.signal = 0
+        signal_thread_available() && ccall(:trixi_watch_signals, Cvoid, (Cint,), 0)
+    end
+
+    return nothing
+end
+
+# The signal thread is part of the C library, i.e., it is missing if LibTrixi.jl is used
+# from Julia directly
+function signal_thread_available()
+    try
+        cglobal(:trixi_watch_signals)
+        return true
+    catch
+        return false
+    end
+end
+
+# A signal concerns all simulations that handle signals, not only the one that polled it
+function record_signal!(signal)
+    lock(signal_lock) do
+        foreach(preemption -> preemption.signal = signal, signal_watchers)
+    end
+
+    return nothing
+end
+
+function signal_received(preemption::Preemption)
+    preemption.handle_signals || return false
+
+    if signal_thread_available()
+        signal = ccall(:trixi_take_signal, Cint, ())
+        signal != 0 && record_signal!(signal)
+    end
+
+    return lock(() -> preemption.signal != 0, signal_lock)
+end
+
+function budget_exhausted(preemption::Preemption)
+    preemption.walltime_budget > 0 || return false
+
+    elapsed = time() - preemption.start_time
+    return elapsed + preemption.max_step_time >= preemption.walltime_budget
+end
+
+
+"""
+    write_checkpoint(simstate, output_directory)
+
+Write a restart file of the current solution together with the mesh to `output_directory`,
+using Trixi's `SaveRestartCallback`, such that the simulation can be restarted from it.
+"""
+function write_checkpoint(simstate, output_directory)
+    integrator = simstate.integrator
+    mesh, _, _, _ = mesh_equations_solver_cache(simstate.semi)
+
+    if Trixi.mpi_isroot()
+        mkpath(output_directory)
+    end
+    if Trixi.mpi_isparallel()
+        MPI.Barrier(Trixi.mpi_comm())
+    end
+
+    # the restart file refers to a mesh file in the same directory
+    if hasproperty(mesh, :unsaved_changes)
+        mesh.unsaved_changes = true
+    end
+
+    save_restart = Trixi.SaveRestartCallback(; output_directory)
+    save_restart.affect!(integrator)
+
+    return nothing
+end
+
+
+# Record the duration of the last step and return whether this rank requests to stop; the
+# ranks agree on stopping in `check_step!`
+function preemption_requested!(preemption::Preemption, step_time_ns)
+    preemption.max_step_time = max(preemption.max_step_time, step_time_ns * 1.0e-9)
+
+    return signal_received(preemption) || budget_exhausted(preemption)
+end
+
+
+# HDF5 is not thread-safe, thus simulations that are advanced concurrently write their
+# checkpoints one after the other
+const checkpoint_lock = ReentrantLock()
+
+"""
+    preempt!(simstate)
+
+Write a checkpoint and mark the simulation as finished. This has to be called collectively
+by all ranks once they agreed to stop, see [`check_step!`](@ref).
+"""
+function preempt!(simstate)
+    preemption = simstate.preemption
+    lock(() -> write_checkpoint(simstate, preemption.output_directory), checkpoint_lock)
+    preemption.triggered = true
+    lock(() -> preemption.signal = 0, signal_lock)
+
+    if Trixi.mpi_isroot()
+        integrator = simstate.integrator
+        log_message(LOG_WARNING,
+                    string("Simulation preempted at t = ", integrator.t,
+                           ", checkpoint written to ", preemption.output_directory);
+                    source = "preemption", t = integrator.t, iter = integrator.iter,
+                    output_directory = preemption.output_directory)
+    end
+
+    return nothing
+end
+
+is_preempted(simstate) = !isnothing(simstate.preemption) && simstate.preemption.triggered
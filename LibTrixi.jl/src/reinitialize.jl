@@ -0,0 +1,111 @@
+"""
+    reinitialize!(simstate, t0, t_end, data = nothing)
+
+Restart the simulation in `simstate` at time `t0` with final time `t_end` on the current
+mesh, reusing the semidiscretization with its cache and, if the time span is unchanged, the
+time integrator with all its allocations. The solution is set to the initial condition of
+the semidiscretization at `t0`, or to the conservative variables in `data`, which has the
+same layout as the solution with the elements in the order set by
+[`set_element_ordering!`](@ref). Step counters, time step, and all callbacks are reset as
+after the initialization of the simulation, and a failed [`HealthCheck`](@ref) is reset.
+A [`Preemption`](@ref) is reset as well, i.e., pending signals are dropped and its wall-time
+budget starts anew.
+
+Since the initialization of an AMR callback that adapts the initial condition would
+overwrite `data` with the initial condition (on an adapted mesh), such callbacks are
+rejected if `data` is given.
+"""
+function reinitialize!(simstate, t0, t_end, data = nothing)
+    if !(t0 < t_end)
+        error("final time must be larger than initial time: ", t0, " >= ", t_end)
+    end
+
+    semi = simstate.semi
+    integrator = simstate.integrator
+    if !isnothing(data) && adapts_initial_condition(integrator)
+        error("initial state cannot be set with an AMR callback that adapts the initial ",
+              "condition, create it with `adapt_initial_condition = false`")
+    end
+
+    if isnothing(data)
+        Trixi.compute_coefficients!(integrator.u, semi.initial_condition, t0, semi)
+    else
+        store_conservative_vars!(simstate, data)
+    end
+
+    tspan = convert(typeof(integrator.sol.prob.tspan), (t0, t_end))
+    if tspan == integrator.sol.prob.tspan
+        reinit!(integrator, integrator.u; t0, tf = t_end, erase_sol = true,
+                reset_dt = false)
+    else
+        # the time span is part of the immutable ODE problem
+        ode = ODEProblem(integrator.sol.prob.f, integrator.u, tspan, semi)
+        simstate.integrator = recreate_integrator(integrator, ode, integrator.opts.callback)
+    end
+
+    integrator = simstate.integrator
+    integrator.stats.naccept = 0
+    integrator.stats.nreject = 0
+    integrator.iter = 0
+
+    tuner = amr_autotuner(simstate)
+    if !isnothing(tuner)
+        tuner.last_adaptation = 0
+    end
+
+    if !isnothing(simstate.health_check)
+        simstate.health_check.status = HEALTH_OK
+    end
+
+    preemption = simstate.preemption
+    if !isnothing(preemption)
+        preemption.triggered = false
+        lock(() -> preemption.signal = 0, signal_lock)
+        preemption.start_time = time()
+        preemption.max_step_time = 0.0
+    end
+
+    # initializing an AMR callback may adapt the mesh to the initial condition
+    if adapts_initial_condition(integrator)
+        simstate.mesh_epoch += 1
+    end
+
+    return nothing
+end
+
+# Whether initializing the callbacks of `integrator` adapts the mesh to the initial
+# condition (tuned AMR callbacks are never initialized)
+function adapts_initial_condition(integrator)
+    index = amr_callback_index(integrator)
+    isnothing(index) && return false
+
+    amr = integrator.opts.callback.discrete_callbacks[index].affect!
+    return amr isa Trixi.AMRCallback && amr.adapt_initial_condition
+end
+
+
+# Overwrite the solution with conservative variables given in the element order of the host
+function store_conservative_vars!(simstate, data)
+    mesh, equations, solver, cache = mesh_equations_solver_cache(simstate.semi)
+    if equations isa EnsembleEquations
+        error("use store_member_conservative_vars! to set the state of ensemble members")
+    end
+
+    u_ode = simstate.integrator.u
+    n_variables = nvariables(equations)
+    u = reshape(u_ode, n_variables, :)
+    data_dofs = reshape(data, size(u))
+
+    positions = element_positions(simstate)
+    n_nodes = size(u, 2) ÷ length(positions)
+    Trixi.@threaded for element in eachindex(positions)
+        for node in 1:n_nodes
+            dof = (element - 1) * n_nodes + node
+            u[:, dof] .= view(data_dofs, :,
+                              host_dof_index(positions, element, node, n_nodes))
+        end
+    end
+    u_modified!(simstate.integrator, true)
+
+    return nothing
+end
@@ -0,0 +1,78 @@
+# Advance a simulation with its own time step until it reaches the synchronization time
+# `t_sync` (or its final time, whichever comes first)
+function advance_to!(simstate, t_sync)
+    integrator = simstate.integrator
+    t_end = integrator.sol.prob.tspan[2]
+
+    # make the integrator hit the synchronization time exactly
+    if t_sync < t_end && !isapprox(t_sync, t_end)
+        add_tstop!(integrator, t_sync)
+    end
+
+    while integrator.t < t_sync && !isapprox(integrator.t, t_sync) &&
+        !trixi_is_finished_jl(simstate)
+        trixi_step_jl(simstate)
+    end
+
+    return nothing
+end
+
+
+"""
+    run_scheduler(simstates, sync_interval, coupling = t -> nothing)
+
+Advance all simulations in `simstates` until they are finished. Each simulation uses its own
+time step, but all simulations are synchronized every `sync_interval` units of simulation
+time, starting from the earliest current time. After each synchronization point is reached
+by all simulations, `coupling(t)` is called with the current synchronization time.
+
+Between synchronization points, the simulations are independent of each other. If Julia
+runs with multiple threads and MPI is not used, they are therefore advanced concurrently,
+one task per simulation. The per-step hooks that act on state of the whole process, i.e.,
+log output (see [`log_message`](@ref)), received signals (see [`signal_received`](@ref)),
+and checkpoints (see [`preempt!`](@ref)), are serialized, and `coupling` is called by the
+calling task. With MPI, the simulations are
+advanced one after the other, since the collective communication of different simulations
+must not interleave.
+"""
+function run_scheduler(simstates, sync_interval, coupling = t -> nothing)
+    if sync_interval <= 0
+        error("synchronization interval must be positive: ", sync_interval)
+    end
+
+    t_start = minimum(simstate -> simstate.integrator.t, simstates)
+    t_end = maximum(simstate -> simstate.integrator.sol.prob.tspan[2], simstates)
+    concurrent = length(simstates) > 1 && Threads.nthreads() > 1 &&
+                 !Trixi.mpi_isparallel()
+
+    # Trixi's global timer is not thread-safe and thus disabled for concurrent stepping
+    timer = Trixi.timer()
+    timer_enabled = timer.enabled
+    if concurrent
+        Trixi.TimerOutputs.disable_timer!(timer)
+    end
+
+    try
+        n_sync = 0
+        while !all(trixi_is_finished_jl, simstates)
+            n_sync += 1
+            t_sync = min(t_start + n_sync * sync_interval, t_end)
+
+            if concurrent
+                tasks = [Threads.@spawn advance_to!(simstate, t_sync)
+                         for simstate in simstates]
+                foreach(wait, tasks)
+            else
+                foreach(simstate -> advance_to!(simstate, t_sync), simstates)
+            end
+
+            coupling(t_sync)
+        end
+    finally
+        if concurrent && timer_enabled
+            Trixi.TimerOutputs.enable_timer!(timer)
+        end
+    end
+
+    return nothing
+end
@@ -0,0 +1,153 @@
+# Wall times (in seconds) of the initialization phases of the simulation that is currently
+# set up by `trixi_initialize_simulation_jl`, not recorded if `nothing`
+const setup_timings = Ref{Union{Nothing, Vector{Pair{String, Float64}}}}(nothing)
+
+
+"""
+    setup_phase(f, name)
+
+Run `f()` as initialization phase `name` and return its result. While a simulation is set
+up by [`trixi_initialize_simulation`](@ref), the wall time of the phase is recorded for
+the simulation state, and the times of phases with the same name are added up. Libelixirs
+can use this to time their own phases, e.g., the construction of the mesh.
+"""
+function setup_phase(f, name)
+    start = time_ns()
+    result = f()
+    record_setup_phase!(name, (time_ns() - start) * 1.0e-9)
+
+    return result
+end
+
+function record_setup_phase!(name, time)
+    timings = setup_timings[]
+    isnothing(timings) && return nothing
+
+    index = findfirst(phase -> first(phase) == name, timings)
+    if isnothing(index)
+        push!(timings, name => time)
+    else
+        timings[index] = name => last(timings[index]) + time
+    end
+
+    return nothing
+end
+
+
+# Phases that are logged at the end of the setup, the same list on all ranks such that the
+# times can be reduced even if a rank did not record some of them
+const reported_setup_phases = ("libelixir", "init_simstate", "mesh", "initial_condition",
+                               "initial_amr", "background_compilation", "total")
+
+# Log the setup phases of `simstate`, using the maximum time of all ranks
+function report_setup_timings(simstate)
+    not_recorded = -1.0
+    times = map(reported_setup_phases) do name
+        index = findfirst(phase -> first(phase) == name, simstate.setup_timings)
+        return isnothing(index) ? not_recorded : last(simstate.setup_timings[index])
+    end
+    times = collect(Float64, times)
+    if Trixi.mpi_isparallel()
+        times = MPI.Allreduce(times, max, Trixi.mpi_comm())
+    end
+
+    # only phases recorded on any rank
+    recorded = findall(!=(not_recorded), times)
+    names = collect(reported_setup_phases[recorded])
+    times = times[recorded]
+
+    if Trixi.mpi_isroot()
+        summary = join((string(name, " ", round(time, digits = 3), " s")
+                        for (name, time) in zip(names, times)), ", ")
+        log_message(LOG_INFO, string("Setup phases: ", summary);
+                    source = "setup", (Symbol(name) => time
+                                       for (name, time) in zip(names, times))...)
+    end
+
+    return nothing
+end
+
+
+# Same limit as for the initial adaptation of Trixi's AMR callback
+const max_initial_amr_iterations = 10
+
+
+"""
+    semidiscretize_threaded(semi, tspan; amr_callback = nothing, only_refine = true)
+
+Create the ODE problem for `semi` on the time span `tspan` like `Trixi.semidiscretize`, but
+evaluate the initial condition on all nodes with Julia threads. If `amr_callback` is given,
+the mesh is first adapted to the initial condition, alternating between adaptation (with the
+indicators of Trixi, which use threads) and threaded evaluation of the initial condition on
+the new mesh until the mesh does not change anymore. The callback must then be created with
+`adapt_initial_condition = false`, as the adaptation would be repeated otherwise when the
+time integrator is initialized. The times of both phases are recorded as
+`initial_condition` and `initial_amr`, see [`setup_phase`](@ref).
+"""
+function semidiscretize_threaded(semi, tspan; amr_callback = nothing, only_refine = true)
+    t0 = first(tspan)
+    u_ode = Trixi.allocate_coefficients(mesh_equations_solver_cache(semi)...)
+    setup_phase(() -> compute_initial_condition!(u_ode, semi, t0), "initial_condition")
+
+    if !isnothing(amr_callback)
+        amr = amr_callback.affect!
+        if amr.adapt_initial_condition
+            error("AMR callback must be created with `adapt_initial_condition = false`")
+        end
+
+        for iteration in 1:max_initial_amr_iterations
+            has_changed = setup_phase("initial_amr") do
+                return amr(u_ode, semi, t0, 0; only_refine)
+            end
+            has_changed || break
+
+            setup_phase(() -> compute_initial_condition!(u_ode, semi, t0),
+                        "initial_condition")
+
+            if iteration == max_initial_amr_iterations && Trixi.mpi_isroot()
+                log_message(LOG_WARNING,
+                            string("Initial AMR did not converge after ", iteration,
+                                   " iterations");
+                            source = "setup", iterations = iteration)
+            end
+        end
+    end
+
+    return ODEProblem{true, OrdinaryDiffEq.SciMLBase.FullSpecialize}(Trixi.rhs!, u_ode,
+                                                                     tspan, semi)
+end
+
+
+"""
+    compute_initial_condition!(u_ode, semi, t)
+
+Evaluate the initial condition of `semi` at time `t` on all nodes and store it in `u_ode`,
+with the elements distributed over Julia threads.
+"""
+function compute_initial_condition!(u_ode, semi, t)
+    mesh, equations, solver, cache = mesh_equations_solver_cache(semi)
+    u = wrap_array(u_ode, mesh, equations, solver, cache)
+    compute_initial_condition!(u, semi.initial_condition, t, Val(ndims(mesh)), equations,
+                               solver, cache)
+
+    return u_ode
+end
+
+function compute_initial_condition!(u, initial_condition, t, ::Val{NDIMS}, equations,
+                                    solver, cache) where {NDIMS}
+    node_coordinates = cache.elements.node_coordinates
+    node_cis = CartesianIndices(ntuple(_ -> nnodes(solver), Val(NDIMS)))
+
+    Trixi.@threaded for element in eachelement(solver, cache)
+        for node_ci in node_cis
+            x_node = Trixi.SVector(ntuple(d -> node_coordinates[d, node_ci, element],
+                                          Val(NDIMS)))
+            u_node = initial_condition(x_node, t, equations)
+            for v in eachindex(u_node)
+                u[v, node_ci, element] = u_node[v]
+            end
+        end
+    end
+
+    return nothing
+end
@@ -0,0 +1,273 @@
+# Layout of a shared-memory segment, must match `src/trixi_shm.h`
+const SHM_MAGIC = 0x4d48535849525254  # "TRIXISHM" in little-endian byte order
+const SHM_VERSION = 1
+const SHM_HEADER_SIZE = 64
+const SHM_SLOT_HEADER_SIZE = 64
+const SHM_ALIGNMENT = 64
+
+# Byte offsets of the header fields
+const SHM_OFFSET_MAGIC = 0
+const SHM_OFFSET_VERSION = 8
+const SHM_OFFSET_NSLOTS = 12
+const SHM_OFFSET_NVARIABLES = 16
+const SHM_OFFSET_STATUS = 20
+const SHM_OFFSET_CAPACITY = 24
+const SHM_OFFSET_SLOT_OFFSET = 32
+const SHM_OFFSET_SLOT_SIZE = 40
+const SHM_OFFSET_PUBLISHED = 48
+
+# Byte offsets of the slot header fields
+const SHM_OFFSET_SEQUENCE = 0
+const SHM_OFFSET_SNAPSHOT = 8
+const SHM_OFFSET_TIME = 16
+const SHM_OFFSET_ITER = 24
+const SHM_OFFSET_MESH_EPOCH = 32
+const SHM_OFFSET_NDOFS = 40
+
+# Status of a segment
+const SHM_ACTIVE = 0
+const SHM_REPLACED = 1               # consumers have to open the segment again by name
+const SHM_CLOSED = 2                 # no further snapshots are published
+
+
+"""
+    SharedMemoryPublisher(name, interval, variable_ids, n_slots)
+
+Settings and state for publishing snapshots of the primitive variables `variable_ids` every
+`interval` steps to a POSIX shared-memory segment, from which processes on the same compute
+node, e.g., in-situ visualization or analysis, read them without copies through files or
+sockets. The segment holds a ring of `n_slots` snapshots, each guarded by a sequence lock:
+its sequence number is odd while the snapshot is written, such that consumers detect and
+retry torn reads without ever blocking the simulation. Each variable is stored contiguously
+for all degrees of freedom, in the element order of the host.
+
+The segment is named `name` with a single rank and `name.<rank>` with several ranks. When
+the number of degrees of freedom exceeds the capacity of the slots, e.g., after mesh
+refinement, the segment is replaced by a larger one with the same name. The layout of the
+segment and a small consumer library are provided by `trixi_shm.h`.
+"""
+mutable struct SharedMemoryPublisher
+    name::String
+    interval::Int
+    variable_ids::Vector{Int}
+    n_slots::Int
+    segment::Vector{UInt8}
+    capacity::Int                   # degrees of freedom per variable in each slot
+    n_published::Int
+
+    function SharedMemoryPublisher(name, interval, variable_ids, n_slots)
+        if isempty(name) || occursin('/', lstrip(==('/'), name))
+            error("invalid shared memory name: \"", name, "\"")
+        end
+        if interval < 1
+            error("publication interval must be positive: ", interval)
+        end
+        if isempty(variable_ids)
+            error("no variables to publish")
+        end
+        if n_slots < 1
+            error("number of slots must be positive: ", n_slots)
+        end
+
+        name = "/" * lstrip(==('/'), name)
+        if Trixi.mpi_isparallel()
+            name = string(name, ".", Trixi.mpi_rank())
+        end
+
+        return new(name, interval, collect(Int, variable_ids), n_slots, UInt8[], 0, 0)
+    end
+end
+
+
+function shm_store!(address, value)
+    unsafe_store!(Ptr{typeof(value)}(address), value)
+    return nothing
+end
+
+shm_load(::Type{T}, address) where {T} = unsafe_load(Ptr{T}(address))
+
+slot_offset(publisher) = cld(SHM_HEADER_SIZE + 4 * length(publisher.variable_ids),
+                             SHM_ALIGNMENT) * SHM_ALIGNMENT
+
+function slot_size(publisher, capacity)
+    n_bytes = SHM_SLOT_HEADER_SIZE + 8 * length(publisher.variable_ids) * capacity
+    return cld(n_bytes, SHM_ALIGNMENT) * SHM_ALIGNMENT
+end
+
+function set_segment_status!(publisher, status)
+    isempty(publisher.segment) && return nothing
+
+    Threads.atomic_fence()
+    shm_store!(pointer(publisher.segment) + SHM_OFFSET_STATUS, UInt32(status))
+    Threads.atomic_fence()
+
+    return nothing
+end
+
+
+"""
+    create_segment!(publisher, capacity)
+
+Create the shared-memory segment of `publisher` with room for `capacity` degrees of
+freedom per variable in each slot. A previous segment is marked as replaced and unlinked;
+consumers that still have it mapped keep a valid mapping until they open the new one.
+"""
+function create_segment!(publisher, capacity)
+    set_segment_status!(publisher, SHM_REPLACED)
+
+    # a segment left behind by a previous run with the same name is replaced as well
+    ccall(:shm_unlink, Cint, (Cstring,), publisher.name)
+    flags = Base.Filesystem.JL_O_RDWR | Base.Filesystem.JL_O_CREAT |
+            Base.Filesystem.JL_O_EXCL
+    fd = ccall(:shm_open, Cint, (Cstring, Cint, Base.Cmode_t), publisher.name, flags,
+               0o600)
+    if fd < 0
+        error("shm_open failed for \"", publisher.name, "\": ",
+              Libc.strerror(Libc.errno()))
+    end
+
+    offset = slot_offset(publisher)
+    size = slot_size(publisher, capacity)
+    io = fdio(fd, true)
+    segment = try
+        # new pages of the segment read as zero, i.e., all slots are empty
+        Mmap.mmap(io, Vector{UInt8}, offset + publisher.n_slots * size; grow = true)
+    finally
+        close(io)
+    end
+
+    ptr = pointer(segment)
+    shm_store!(ptr + SHM_OFFSET_VERSION, UInt32(SHM_VERSION))
+    shm_store!(ptr + SHM_OFFSET_NSLOTS, UInt32(publisher.n_slots))
+    shm_store!(ptr + SHM_OFFSET_NVARIABLES, UInt32(length(publisher.variable_ids)))
+    shm_store!(ptr + SHM_OFFSET_STATUS, UInt32(SHM_ACTIVE))
+    shm_store!(ptr + SHM_OFFSET_CAPACITY, UInt64(capacity))
+    shm_store!(ptr + SHM_OFFSET_SLOT_OFFSET, UInt64(offset))
+    shm_store!(ptr + SHM_OFFSET_SLOT_SIZE, UInt64(size))
+    shm_store!(ptr + SHM_OFFSET_PUBLISHED, UInt64(0))
+    for (v, variable_id) in enumerate(publisher.variable_ids)
+        shm_store!(ptr + SHM_HEADER_SIZE + 4 * (v - 1), Int32(variable_id))
+    end
+
+    # consumers only accept the segment once the magic number is visible
+    Threads.atomic_fence()
+    shm_store!(ptr + SHM_OFFSET_MAGIC, UInt64(SHM_MAGIC))
+    Threads.atomic_fence()
+
+    publisher.segment = segment
+    publisher.capacity = capacity
+    publisher.n_published = 0
+
+    log_debug("Shared memory segment ", publisher.name, " created for ", capacity,
+              " degrees of freedom")
+
+    return nothing
+end
+
+
+"""
+    publish!(simstate)
+
+Write a snapshot of the current solution to the next slot of the
+[`SharedMemoryPublisher`](@ref) of `simstate`, growing the segment first if the degrees of
+freedom do not fit. While a host-defined element ordering is outdated after the mesh has
+changed, the snapshot is skipped instead of failing the time step, since the host can only
+set the new ordering after the step.
+"""
+function publish!(simstate)
+    publisher = simstate.shm_publisher
+    ordering = simstate.element_ordering
+    if !isnothing(ordering) && ordering.mesh_epoch != simstate.mesh_epoch
+        if Trixi.mpi_isroot()
+            log_message(LOG_WARNING,
+                        string("Shared memory snapshot skipped at iteration ",
+                               simstate.integrator.iter,
+                               " since the element ordering is outdated");
+                        source = "shm", iter = simstate.integrator.iter,
+                        mesh_epoch = simstate.mesh_epoch)
+        end
+        return nothing
+    end
+
+    mesh, equations, solver, cache = mesh_equations_solver_cache(simstate.semi)
+    n_dofs = ndofs(mesh, solver, cache)
+    if n_dofs > publisher.capacity
+        # leave room for further refinement to avoid replacing the segment too often
+        capacity = isempty(publisher.segment) ? n_dofs : cld(3 * n_dofs, 2)
+        create_segment!(publisher, capacity)
+    end
+
+    integrator = simstate.integrator
+    slot = mod(publisher.n_published, publisher.n_slots)
+    slot_ptr = pointer(publisher.segment) + slot_offset(publisher) +
+               slot * slot_size(publisher, publisher.capacity)
+    sequence = shm_load(UInt64, slot_ptr + SHM_OFFSET_SEQUENCE)
+
+    # an odd sequence number marks the slot as being written
+    shm_store!(slot_ptr + SHM_OFFSET_SEQUENCE, sequence + 1)
+    Threads.atomic_fence()
+
+    data = unsafe_wrap(Array, Ptr{Float64}(slot_ptr + SHM_SLOT_HEADER_SIZE),
+                       (publisher.capacity, length(publisher.variable_ids)))
+    store_primitive_vars!(data, simstate, publisher.variable_ids)
+    snapshot = publisher.n_published + 1
+    shm_store!(slot_ptr + SHM_OFFSET_SNAPSHOT, UInt64(snapshot))
+    shm_store!(slot_ptr + SHM_OFFSET_TIME, Float64(integrator.t))
+    shm_store!(slot_ptr + SHM_OFFSET_ITER, Int64(integrator.iter))
+    shm_store!(slot_ptr + SHM_OFFSET_MESH_EPOCH, Int64(simstate.mesh_epoch))
+    shm_store!(slot_ptr + SHM_OFFSET_NDOFS, UInt64(n_dofs))
+
+    Threads.atomic_fence()
+    shm_store!(slot_ptr + SHM_OFFSET_SEQUENCE, sequence + 2)
+    Threads.atomic_fence()
+    shm_store!(pointer(publisher.segment) + SHM_OFFSET_PUBLISHED, UInt64(snapshot))
+    Threads.atomic_fence()
+
+    publisher.n_published = snapshot
+
+    return nothing
+end
+
+# Store the primitive variables `variable_ids` at all nodes in the columns of `data`, with
+# the elements in the order of the host
+function store_primitive_vars!(data, simstate, variable_ids)
+    mesh, equations, solver, cache = mesh_equations_solver_cache(simstate.semi)
+    u = wrap_array(simstate.integrator.u, mesh, equations, solver, cache)
+    node_cis = CartesianIndices(ntuple(_ -> nnodes(solver), ndims(mesh)))
+    node_lis = LinearIndices(node_cis)
+    n_nodes = length(node_cis)
+    positions = element_positions(simstate)
+
+    Trixi.@threaded for element in eachelement(solver, cache)
+        for node_ci in node_cis
+            node_vars = get_node_vars(u, equations, solver, node_ci, element)
+            prim = cons2prim(node_vars, equations)
+            dof = host_dof_index(positions, element, node_lis[node_ci], n_nodes)
+            for (v, variable_id) in enumerate(variable_ids)
+                data[dof, v] = prim[variable_id]
+            end
+        end
+    end
+
+    return nothing
+end
+
+
+"""
+    close_publisher!(publisher)
+
+Mark the segment of `publisher` as closed and remove its name, such that no segments are
+left behind. Consumers that have it mapped can still read the last snapshots.
+"""
+function close_publisher!(publisher)
+    isempty(publisher.segment) && return nothing
+
+    set_segment_status!(publisher, SHM_CLOSED)
+    ccall(:shm_unlink, Cint, (Cstring,), publisher.name)
+    publisher.segment = UInt8[]
+    publisher.capacity = 0
+
+    log_debug("Shared memory segment ", publisher.name, " closed")
+
+    return nothing
+end
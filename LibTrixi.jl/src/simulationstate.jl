@@ -1,4 +1,7 @@
 const LibTrixiDataRegistry = Vector{Vector{Float64}}
+# Separate registry type for single precision data, such that libelixirs read the entries of
+# either registry with a concrete type
+const LibTrixiDataRegistryF32 = Vector{Vector{Float32}}
 
 """
     SimulationState
@@ -7,14 +10,40 @@ Data structure to store a simulation state consisting of
 - a semidiscretization
 - the time integrator
 - an optional array of data vectors
+- a counter that is increased whenever the mesh changes (mesh epoch)
+- an optional [`StragglerWatchdog`](@ref)
+- optional [`Preemption`](@ref) settings
+- an optional [`HealthCheck`](@ref)
+- an optional [`EnergyMeter`](@ref)
+- user-defined [`OutputVariable`](@ref)s
+- an optional host-defined [`ElementOrdering`](@ref)
+- a flag to aggregate output per compute node, see [`save_vtkhdf`](@ref)
+- an optional [`BufferStorage`](@ref) for library-managed buffers
+- the wall times of the initialization phases, see [`setup_phase`](@ref)
+- an optional [`SharedMemoryPublisher`](@ref)
 """
 mutable struct SimulationState{SemiType, IntegratorType}
     semi::SemiType
     integrator::IntegratorType
-    registry::LibTrixiDataRegistry
+    registry::Union{LibTrixiDataRegistry, LibTrixiDataRegistryF32}
+    mesh_epoch::Int
+    watchdog::Union{Nothing, StragglerWatchdog}
+    preemption::Union{Nothing, Preemption}
+    health_check::Union{Nothing, HealthCheck}
+    energy_meter::Union{Nothing, EnergyMeter}
+    output_variables::Vector{OutputVariable}
+    element_ordering::Union{Nothing, ElementOrdering}
+    aggregate_output::Bool
+    buffer_storage::Union{Nothing, BufferStorage}
+    setup_timings::Vector{Pair{String, Float64}}
+    shm_publisher::Union{Nothing, SharedMemoryPublisher}
 
     function SimulationState(semi, integrator, registry = LibTrixiDataRegistry())
-        return new{typeof(semi), typeof(integrator)}(semi, integrator, registry)
+        return new{typeof(semi), typeof(integrator)}(semi, integrator, registry, 0,
+                                                     nothing, nothing, nothing,
+                                                     nothing, OutputVariable[], nothing,
+                                                     false, nothing,
+                                                     Pair{String, Float64}[], nothing)
     end
 end
 
@@ -59,6 +88,17 @@ function load_simstate(handle)
     return simstate
 end
 
+# Replace the simulation state identified by the handle, e.g., after it was rebuilt
+function replace_simstate!(handle, simstate)
+    if !in(handle, keys(simstates))
+        error("the provided handle was not found in the stored simulation states: ", handle)
+    end
+
+    simstates[handle] = simstate
+
+    return handle
+end
+
 # Remove the simulation state identified by the handle from the global simstate dict
 function delete_simstate!(handle)
     if !in(handle, keys(simstates))
@@ -69,3 +109,36 @@ function delete_simstate!(handle)
 
     return handle
 end
+
+# Return true if an AMR callback was triggered during the last time step of `integrator`
+function amr_was_applied(integrator)
+    for cb in integrator.opts.callback.discrete_callbacks
+        if cb isa DiscreteCallback{<:Any, <:Trixi.AMRCallback} &&
+           cb.condition(integrator.u, integrator.t, integrator)
+            return true
+        end
+        # the condition of an autotuned callback is reset by the adaptation itself
+        if cb isa DiscreteCallback{<:Any, <:AutotunedAMR} &&
+           cb.affect!.tuner.last_adaptation == integrator.stats.naccept
+            return true
+        end
+    end
+
+    return false
+end
+
+# Transfer all settings that are not part of the simulation setup itself, e.g., when a
+# simulation state is rebuilt
+function transfer_settings!(simstate_new, simstate)
+    simstate_new.watchdog = simstate.watchdog
+    simstate_new.preemption = simstate.preemption
+    simstate_new.health_check = simstate.health_check
+    simstate_new.energy_meter = simstate.energy_meter
+    simstate_new.output_variables = simstate.output_variables
+    simstate_new.aggregate_output = simstate.aggregate_output
+    simstate_new.buffer_storage = simstate.buffer_storage
+    simstate_new.setup_timings = simstate.setup_timings
+    simstate_new.shm_publisher = simstate.shm_publisher
+
+    return simstate_new
+end
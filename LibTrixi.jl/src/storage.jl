@@ -0,0 +1,109 @@
+# Access hints for file-backed buffers, passed to `madvise`
+const ACCESS_NORMAL = 0
+const ACCESS_SEQUENTIAL = 1
+const ACCESS_RANDOM = 2
+const ACCESS_WILLNEED = 3
+
+const madvise_flags = Dict(ACCESS_NORMAL => Mmap.MADV_NORMAL,
+                           ACCESS_SEQUENTIAL => Mmap.MADV_SEQUENTIAL,
+                           ACCESS_RANDOM => Mmap.MADV_RANDOM,
+                           ACCESS_WILLNEED => Mmap.MADV_WILLNEED)
+
+
+"""
+    BufferStorage(directory, access_hint = ACCESS_NORMAL)
+
+Storage of library-managed buffers, e.g., data vectors allocated for the registry, in
+file-backed memory maps in `directory`, typically on node-local NVMe. The operating system
+then pages rarely used data out to the file instead of keeping it in DRAM. Each buffer is
+mapped from its own file, which is removed right after mapping, such that no files are left
+behind; the memory is released when the buffer is garbage collected. The `access_hint`
+(`ACCESS_NORMAL`, `ACCESS_SEQUENTIAL`, `ACCESS_RANDOM`, or `ACCESS_WILLNEED`) is passed to
+`madvise` for every buffer.
+"""
+struct BufferStorage
+    directory::String
+    access_hint::Int
+
+    function BufferStorage(directory, access_hint = ACCESS_NORMAL)
+        if !haskey(madvise_flags, access_hint)
+            error("invalid access hint: ", access_hint)
+        end
+
+        mkpath(directory)
+
+        return new(directory, access_hint)
+    end
+end
+
+
+"""
+    HostAllocator
+
+C functions of the host that allocate and release the memory of library-managed buffers as
+`ptr = alloc(size, userdata)` and `free(ptr, userdata)`, with `size` in bytes. This lets
+the memory policies of the host, e.g., huge pages or NUMA pools, apply to these buffers.
+The memory is released by a finalizer when the buffer is garbage collected, which may run
+on any thread and as late as the end of the Julia process.
+"""
+struct HostAllocator
+    alloc::Ptr{Cvoid}
+    free::Ptr{Cvoid}
+    userdata::Ptr{Cvoid}
+end
+
+# Allocator for buffers in regular memory, Julia's own if `nothing`
+const host_allocator = Ref{Union{Nothing, HostAllocator}}(nothing)
+
+function allocate_host_buffer(allocator::HostAllocator, ::Type{T}, n) where {T}
+    n > 0 || return T[]
+
+    n_bytes = n * sizeof(T)
+    ptr = ccall(allocator.alloc, Ptr{Cvoid}, (Csize_t, Ptr{Cvoid}), n_bytes,
+                allocator.userdata)
+    if ptr == C_NULL
+        error("host allocator failed to allocate ", n_bytes, " bytes")
+    end
+    if UInt(ptr) % Base.datatype_alignment(T) != 0
+        error("memory returned by host allocator is not aligned for ", T)
+    end
+
+    buffer = unsafe_wrap(Array, Ptr{T}(ptr), n; own = false)
+    finalizer(buffer) do buffer
+        ccall(allocator.free, Cvoid, (Ptr{Cvoid}, Ptr{Cvoid}), pointer(buffer),
+              allocator.userdata)
+    end
+
+    return fill!(buffer, zero(T))
+end
+
+
+"""
+    allocate_buffer(storage, T, n)
+
+Allocate a zero-initialized vector of `n` elements of type `T`, either in a memory map of
+the [`BufferStorage`](@ref) `storage` or in regular memory if `storage` is `nothing`.
+Regular memory is obtained from the [`HostAllocator`](@ref) if one is set.
+"""
+function allocate_buffer(::Nothing, ::Type{T}, n) where {T}
+    allocator = host_allocator[]
+    isnothing(allocator) && return zeros(T, n)
+
+    return allocate_host_buffer(allocator, T, n)
+end
+
+function allocate_buffer(storage::BufferStorage, ::Type{T}, n) where {T}
+    n > 0 || return T[]
+
+    # new file pages read as zero, thus the buffer is initialized without touching it
+    path, io = mktemp(storage.directory; cleanup = false)
+    buffer = try
+        Mmap.mmap(io, Vector{T}, n)
+    finally
+        close(io)
+        rm(path)
+    end
+    Mmap.madvise!(buffer, madvise_flags[storage.access_hint])
+
+    return buffer
+end
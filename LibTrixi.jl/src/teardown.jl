@@ -0,0 +1,118 @@
+"""
+    DeferredTeardown
+
+Settings and state for releasing finalized simulation states in batches. Instead of a full
+garbage collection whenever a simulation is finalized, meshes that have to be finalized
+explicitly (see [`release_mesh!`](@ref)) are queued, and the queue is processed followed by
+a single garbage collection after `batch_size` finalizations or when
+[`collect_garbage!`](@ref) is called. With a `batch_size` that is not positive, this only
+happens on explicit request.
+"""
+mutable struct DeferredTeardown
+    batch_size::Int
+    pending_meshes::Vector{Any}
+    n_pending::Int                  # finalized simulations not collected yet
+end
+
+DeferredTeardown(batch_size) = DeferredTeardown(batch_size, Any[], 0)
+
+# Deferred teardown settings, immediate teardown if `nothing`
+const deferred_teardown = Ref{Union{Nothing, DeferredTeardown}}(nothing)
+
+# Number of further simulation states that use a mesh besides the one that created it
+const mesh_shares = IdDict{Any, Int}()
+
+# Record that another simulation state uses `mesh`, such that releasing one of them does not
+# finalize it (see `release_mesh!`)
+function share_mesh!(mesh)
+    mesh isa Trixi.P4estMesh || return nothing
+
+    mesh_shares[mesh] = get(mesh_shares, mesh, 0) + 1
+
+    return nothing
+end
+
+
+# In course of garbage collection, MPI might get finalized before t8code related objects.
+# This can lead to crashes because t8code allocates MPI related objects, e.g. shared memory
+# arrays. T8code.jl implements manual ref counting to deal with this issue. For p4est the
+# workaround is to finalize P4estMeshes explicitly in advance, either right away or as part
+# of the next batch, but always before MPI is finalized.
+# x-ref: https://github.com/DLR-AMR/t8code/issues/1295
+# x-ref: https://github.com/trixi-framework/libtrixi/pull/215#discussion_r1843676330
+#
+# A mesh shared by several simulation states (see `share_mesh!`) is only finalized when the
+# last of them is released.
+function release_mesh!(mesh)
+    mesh isa Trixi.P4estMesh || return nothing
+
+    n_shares = get(mesh_shares, mesh, 0)
+    if n_shares > 0
+        if n_shares == 1
+            delete!(mesh_shares, mesh)
+        else
+            mesh_shares[mesh] = n_shares - 1
+        end
+        return nothing
+    end
+
+    teardown = deferred_teardown[]
+    if isnothing(teardown)
+        finalize(mesh)
+    else
+        push!(teardown.pending_meshes, mesh)
+    end
+
+    return nothing
+end
+
+
+# Free the memory of a finalized simulation state whose handle has been removed, either
+# immediately or as part of the next batch
+function collect_finalized!()
+    teardown = deferred_teardown[]
+    if isnothing(teardown)
+        GC.gc()
+        return nothing
+    end
+
+    teardown.n_pending += 1
+    if teardown.batch_size > 0 && teardown.n_pending >= teardown.batch_size
+        collect_garbage!()
+    end
+
+    return nothing
+end
+
+
+"""
+    collect_garbage!()
+
+Finalize all meshes of simulations whose teardown was deferred, and run a full garbage
+collection. This has to be called collectively by all ranks, and before MPI is finalized.
+"""
+function collect_garbage!()
+    teardown = deferred_teardown[]
+    if !isnothing(teardown)
+        foreach(finalize, teardown.pending_meshes)
+        empty!(teardown.pending_meshes)
+        log_debug("Deferred teardown of ", teardown.n_pending, " simulations")
+        teardown.n_pending = 0
+    end
+
+    GC.gc()
+
+    return nothing
+end
+
+
+# Process pending teardowns when Julia shuts down, i.e., in `trixi_finalize` of all builds,
+# which happens before MPI is finalized since the hook is registered after MPI.jl's
+function collect_garbage_at_exit()
+    teardown = deferred_teardown[]
+    if !isnothing(teardown) && (teardown.n_pending > 0 || !isempty(teardown.pending_meshes))
+        collect_garbage!()
+    end
+
+    return nothing
+end
@@ -0,0 +1,73 @@
+"""
+    transfer_solution!(simstate_dst, simstate_src; l2_projection = false)
+
+Overwrite the solution of `simstate_dst` with the solution of `simstate_src`, which may
+use a different mesh, mesh type, polynomial degree, or MPI partitioning. The source
+solution is evaluated at physical points of the destination mesh with a
+[`PointInterpolation`](@ref) on the source simulation.
+
+By default, the source solution is interpolated to the nodes of the destination solver.
+With `l2_projection = true`, it is instead evaluated at Gauss points of each destination
+element and L2-projected onto the destination basis (element-wise on the reference
+element), which avoids aliasing when coarsening. All points of the destination mesh have to
+be covered by the source mesh. The simulation time of `simstate_dst` is not changed.
+
+This function has to be called collectively by all ranks.
+"""
+function transfer_solution!(simstate_dst, simstate_src; l2_projection = false)
+    if trixi_nvariables_jl(simstate_dst) != trixi_nvariables_jl(simstate_src)
+        error("source and destination simulation must have the same number of variables")
+    end
+    if trixi_ndims_jl(simstate_dst) != trixi_ndims_jl(simstate_src)
+        error("source and destination simulation must have the same number of dimensions")
+    end
+
+    if l2_projection
+        points, projection = projection_points(simstate_dst)
+    else
+        points, projection = dof_coordinates(simstate_dst), nothing
+    end
+
+    interpolation = PointInterpolation(simstate_src, points)
+    if !all(interpolation.located)
+        error("destination mesh is not covered by the source mesh")
+    end
+    values = interpolate_to_points(interpolation, simstate_src)
+
+    n_variables = trixi_nvariables_jl(simstate_dst)
+    n_dims = trixi_ndims_jl(simstate_dst)
+    copyto!(simstate_dst.integrator.u,
+            project_nodal_data(vec(values), n_variables, n_dims, projection))
+    u_modified!(simstate_dst.integrator, true)
+
+    log_debug("Solution transferred to ", size(points, 2), " points")
+
+    return nothing
+end
+
+
+# Physical coordinates of tensor-product Gauss points in all elements of `simstate`,
+# together with the 1D matrix that L2-projects values at these points onto the basis
+function projection_points(simstate)
+    mesh, _, solver, cache = mesh_equations_solver_cache(simstate.semi)
+    n_dims = ndims(mesh)
+    nodes = solver.basis.nodes
+    barycentric_weights = Trixi.barycentric_weights(nodes)
+
+    # one point more than nodes to integrate the mass matrix exactly
+    gauss_nodes, gauss_weights = Trixi.gauss_nodes_weights(length(nodes) + 1)
+    vandermonde = zeros(length(gauss_nodes), length(nodes))
+    for (i, x) in enumerate(gauss_nodes)
+        vandermonde[i, :] .= Trixi.lagrange_interpolating_polynomials(x, nodes,
+                                                                      barycentric_weights)
+    end
+
+    # projection = M^{-1} V^T W with mass matrix M = V^T W V
+    weighted = transpose(vandermonde .* gauss_weights)
+    projection = (weighted * vandermonde) \ weighted
+
+    points = project_nodal_data(vec(cache.elements.node_coordinates), n_dims, n_dims,
+                                vandermonde)
+
+    return reshape(points, n_dims, :), projection
+end
@@ -0,0 +1,479 @@
+# VTK cell types of the Lagrange (arbitrary order) cells used to represent DG elements
+const VTK_LAGRANGE_CURVE = UInt8(68)
+const VTK_LAGRANGE_QUADRILATERAL = UInt8(70)
+const VTK_LAGRANGE_HEXAHEDRON = UInt8(72)
+
+vtk_lagrange_cell_type(::Val{1}) = VTK_LAGRANGE_CURVE
+vtk_lagrange_cell_type(::Val{2}) = VTK_LAGRANGE_QUADRILATERAL
+vtk_lagrange_cell_type(::Val{3}) = VTK_LAGRANGE_HEXAHEDRON
+
+
+# Map zero-based tensor-product node indices of an element with polynomial degree `n` to
+# the zero-based position of that node in a VTK Lagrange cell. Vertices come first, then
+# edges, faces, and the interior, following `vtkHigherOrder*::PointIndexFromIJK`.
+function vtk_lagrange_index(i, n)
+    i == 0 && return 0
+    i == n && return 1
+    return i + 1
+end
+
+function vtk_lagrange_index(i, j, n)
+    ibdy = (i == 0 || i == n)
+    jbdy = (j == 0 || j == n)
+
+    # vertex
+    if ibdy && jbdy
+        return i > 0 ? (j > 0 ? 2 : 1) : (j > 0 ? 3 : 0)
+    end
+
+    # edge
+    offset = 4
+    if !ibdy && jbdy
+        return (i - 1) + (j > 0 ? 2 * (n - 1) : 0) + offset
+    elseif ibdy && !jbdy
+        return (j - 1) + (i > 0 ? n - 1 : 3 * (n - 1)) + offset
+    end
+
+    # interior
+    offset += 4 * (n - 1)
+    return offset + (i - 1) + (n - 1) * (j - 1)
+end
+
+function vtk_lagrange_index(i, j, k, n)
+    ibdy = (i == 0 || i == n)
+    jbdy = (j == 0 || j == n)
+    kbdy = (k == 0 || k == n)
+    nbdy = ibdy + jbdy + kbdy
+
+    # vertex
+    if nbdy == 3
+        return (i > 0 ? (j > 0 ? 2 : 1) : (j > 0 ? 3 : 0)) + (k > 0 ? 4 : 0)
+    end
+
+    # edge
+    offset = 8
+    if nbdy == 2
+        if !ibdy
+            return (i - 1) + (j > 0 ? 2 * (n - 1) : 0) + (k > 0 ? 4 * (n - 1) : 0) + offset
+        elseif !jbdy
+            return ((j - 1) + (i > 0 ? n - 1 : 3 * (n - 1)) + (k > 0 ? 4 * (n - 1) : 0) +
+                    offset)
+        else
+            offset += 8 * (n - 1)
+            return (k - 1) + (n - 1) * (i > 0 ? (j > 0 ? 2 : 1) : (j > 0 ? 3 : 0)) + offset
+        end
+    end
+
+    # face
+    offset += 12 * (n - 1)
+    if nbdy == 1
+        if ibdy
+            return (j - 1) + (n - 1) * (k - 1) + (i > 0 ? (n - 1)^2 : 0) + offset
+        end
+        offset += 2 * (n - 1)^2
+        if jbdy
+            return (i - 1) + (n - 1) * (k - 1) + (j > 0 ? (n - 1)^2 : 0) + offset
+        end
+        offset += 2 * (n - 1)^2
+        return (i - 1) + (n - 1) * (j - 1) + (k > 0 ? (n - 1)^2 : 0) + offset
+    end
+
+    # interior
+    offset += 6 * (n - 1)^2
+    return offset + (i - 1) + (n - 1) * ((j - 1) + (n - 1) * (k - 1))
+end
+
+
+"""
+    VTKHDFPiece
+
+Rank-local part of an unstructured VTK grid with one Lagrange cell per DG element. Since
+DG solutions are discontinuous, every element has its own set of points. Point data holds
+the primitive variables interpolated to equidistant nodes, as required by VTK's Lagrange
+cells.
+"""
+struct VTKHDFPiece
+    points::Matrix{Float64}        # (3, npoints)
+    connectivity::Vector{Int64}    # (npoints), zero-based and local to this piece
+    offsets::Vector{Int64}         # (ncells + 1), zero-based and local to this piece
+    types::Vector{UInt8}           # (ncells)
+    point_data::Matrix{Float64}    # (nvariables, npoints)
+end
+
+npoints(piece::VTKHDFPiece) = size(piece.points, 2)
+ncells(piece::VTKHDFPiece) = length(piece.types)
+
+
+function VTKHDFPiece(simstate)
+    mesh, equations, solver, cache = mesh_equations_solver_cache(simstate.semi)
+    n_dims = ndims(mesh)
+    n_nodes = nnodes(solver)
+    n_nodes_element = n_nodes^n_dims
+    n_elements = nelements(solver, cache)
+    n_variables = nvariables(equations)
+
+    u = wrap_array(simstate.integrator.u, mesh, equations, solver, cache)
+    node_coordinates = cache.elements.node_coordinates
+
+    # VTK Lagrange cells expect equidistant nodes
+    nodes_vtk = collect(range(-1, 1, length = n_nodes))
+    interpolation_matrix = Trixi.polynomial_interpolation_matrix(solver.basis.nodes,
+                                                                 nodes_vtk)
+
+    points = zeros(Float64, 3, n_elements * n_nodes_element)
+    connectivity = Vector{Int64}(undef, n_elements * n_nodes_element)
+    offsets = collect(Int64, 0:n_nodes_element:(n_elements * n_nodes_element))
+    types = fill(vtk_lagrange_cell_type(Val(n_dims)), n_elements)
+    point_data = Matrix{Float64}(undef, n_variables, n_elements * n_nodes_element)
+
+    # all permutations of nodes indices for arbitrary dimension
+    node_cis = CartesianIndices(ntuple(i -> n_nodes, n_dims))
+    node_lis = LinearIndices(node_cis)
+
+    # elements are processed in one contiguous chunk per thread, such that the temporary
+    # arrays are only allocated once per chunk
+    elements = eachelement(solver, cache)
+    n_chunks = min(Threads.nthreads(), length(elements))
+    Trixi.@threaded for chunk in 1:n_chunks
+        prim = Array{eltype(u)}(undef, n_variables, size(node_cis)...)
+        prim_vtk = similar(prim)
+        prim_tmp = ntuple(_ -> similar(prim), n_dims - 1)
+        coordinates_vtk = Array{Float64}(undef, n_dims, size(node_cis)...)
+        coordinates_tmp = ntuple(_ -> similar(coordinates_vtk), n_dims - 1)
+
+        for element in elements[chunk_range(length(elements), n_chunks, chunk)]
+            # convert solution to primitive variables
+            for node_ci in node_cis
+                node_vars = get_node_vars(u, equations, solver, node_ci, element)
+                prim[:, node_ci] .= cons2prim(node_vars, equations)
+            end
+
+            # interpolate coordinates and solution to equidistant nodes
+            coordinates_element = selectdim(node_coordinates, n_dims + 2, element)
+            Trixi.multiply_dimensionwise!(coordinates_vtk, interpolation_matrix,
+                                          coordinates_element, coordinates_tmp...)
+            Trixi.multiply_dimensionwise!(prim_vtk, interpolation_matrix, prim,
+                                          prim_tmp...)
+
+            first_point = (element - 1) * n_nodes_element
+            for node_ci in node_cis
+                point = first_point + node_lis[node_ci]
+                for d in 1:n_dims
+                    points[d, point] = coordinates_vtk[d, node_ci]
+                end
+                for v in 1:n_variables
+                    point_data[v, point] = prim_vtk[v, node_ci]
+                end
+
+                vtk_index = vtk_lagrange_index((Tuple(node_ci) .- 1)..., n_nodes - 1)
+                connectivity[first_point + vtk_index + 1] = point - 1
+            end
+        end
+    end
+
+    return VTKHDFPiece(points, connectivity, offsets, types, point_data)
+end
+
+
+# Range of the `chunk`-th of `n_chunks` contiguous and balanced chunks of `1:n`
+function chunk_range(n, n_chunks, chunk)
+    return (div((chunk - 1) * n, n_chunks) + 1):div(chunk * n, n_chunks)
+end
+
+
+# Create all datasets of a VTKHDF unstructured grid file, where `points_counts` and
+# `cells_counts` hold the number of points and cells of each piece. With
+# `collective = true`, all writes to the datasets are collective MPI-IO operations, such
+# that the pieces of all ranks are combined into a single I/O request per dataset.
+function create_vtkhdf_datasets(file, variable_names, points_counts, cells_counts, time;
+                                collective = false)
+    n_pieces = length(points_counts)
+    n_points = sum(points_counts)
+    n_cells = sum(cells_counts)
+    transfer = collective ? (; dxpl_mpio = :collective) : (;)
+
+    group = create_group(file, "VTKHDF")
+    attributes(group)["Version"] = [2, 2]
+    attributes(group)["Type"] = "UnstructuredGrid"
+
+    # the piece-wise sizes are tiny and thus written by everyone (same values everywhere)
+    group["NumberOfPoints"] = collect(Int64, points_counts)
+    group["NumberOfCells"] = collect(Int64, cells_counts)
+    group["NumberOfConnectivityIds"] = collect(Int64, points_counts)
+
+    datasets = Dict{String, Any}()
+    datasets["Points"] = create_dataset(group, "Points", datatype(Float64),
+                                        dataspace((3, n_points)); transfer...)
+    datasets["Connectivity"] = create_dataset(group, "Connectivity", datatype(Int64),
+                                              dataspace((n_points,)); transfer...)
+    datasets["Offsets"] = create_dataset(group, "Offsets", datatype(Int64),
+                                         dataspace((n_cells + n_pieces,)); transfer...)
+    datasets["Types"] = create_dataset(group, "Types", datatype(UInt8),
+                                       dataspace((n_cells,)); transfer...)
+
+    point_data = create_group(group, "PointData")
+    for name in variable_names
+        datasets[name] = create_dataset(point_data, name, datatype(Float64),
+                                        dataspace((n_points,)); transfer...)
+    end
+
+    field_data = create_group(group, "FieldData")
+    field_data["time"] = [Float64(time)]
+
+    return datasets
+end
+
+
+# Write a single piece into the datasets created by `create_vtkhdf_datasets`. For collective
+# datasets, every rank has to call this exactly once per file with its own piece.
+function write_vtkhdf_piece!(datasets, variable_names, piece, piece_index, points_counts,
+                             cells_counts)
+    point_offset = sum(points_counts[1:(piece_index - 1)])
+    cell_offset = sum(cells_counts[1:(piece_index - 1)])
+    points_range = (point_offset + 1):(point_offset + npoints(piece))
+    cells_range = (cell_offset + 1):(cell_offset + ncells(piece))
+    # each piece has one more offset than cells
+    offsets_range = (cell_offset + piece_index):(cell_offset + piece_index + ncells(piece))
+
+    write_selection!(datasets["Points"], piece.points, :, points_range)
+    write_selection!(datasets["Connectivity"], piece.connectivity, points_range)
+    write_selection!(datasets["Offsets"], piece.offsets, offsets_range)
+    write_selection!(datasets["Types"], piece.types, cells_range)
+    for (v, name) in enumerate(variable_names)
+        write_selection!(datasets[name], piece.point_data[v, :], points_range)
+    end
+
+    return nothing
+end
+
+# Write `data` to the `ranges` of `dataset`. Pieces without points or cells explicitly
+# write an empty selection, since every rank has to take part in collective writes.
+function write_selection!(dataset, data, ranges...)
+    if !isempty(data)
+        dataset[ranges...] = data
+        return nothing
+    end
+
+    file_space = HDF5.dataspace(dataset)
+    memory_space = HDF5.dataspace((0,))
+    memory_type = datatype(eltype(data))
+    try
+        HDF5.API.h5s_select_none(file_space)
+        HDF5.API.h5s_select_none(memory_space)
+        HDF5.API.h5d_write(dataset, memory_type, memory_space, file_space, dataset.xfer,
+                           zeros(eltype(data), 1))
+    finally
+        close(memory_type)
+        close(memory_space)
+        close(file_space)
+    end
+
+    return nothing
+end
+
+
+"""
+    save_vtkhdf(filename, simstate; aggregate = false)
+
+Write the current solution of `simstate` as VTKHDF file that can be opened directly with
+ParaView. Each DG element is stored as high-order Lagrange cell, and each MPI rank
+contributes one piece of the unstructured grid.
+
+If the HDF5 library supports MPI, all ranks write to the file with one collective MPI-IO
+request per dataset. Otherwise, the pieces are collected on the root rank, which then
+writes the file alone.
+
+With `aggregate = true`, the pieces of all ranks on a compute node are first collected on
+one aggregator rank per node, see [`node_comms`](@ref), and merged into a single piece.
+Only the aggregators then write to the file, i.e., with fewer and larger I/O requests.
+"""
+function save_vtkhdf(filename, simstate; aggregate = false)
+    _, equations, _, _ = mesh_equations_solver_cache(simstate.semi)
+    variable_names = collect(String, Trixi.varnames(cons2prim, equations))
+    time = simstate.integrator.t
+
+    piece = VTKHDFPiece(simstate)
+
+    if aggregate
+        save_vtkhdf_aggregated(filename, piece, variable_names, time)
+        return nothing
+    end
+
+    if !Trixi.mpi_isparallel()
+        h5open(filename, "w") do file
+            datasets = create_vtkhdf_datasets(file, variable_names, [npoints(piece)],
+                                              [ncells(piece)], time)
+            write_vtkhdf_piece!(datasets, variable_names, piece, 1, [npoints(piece)],
+                                [ncells(piece)])
+        end
+        return nothing
+    end
+
+    comm = Trixi.mpi_comm()
+    points_counts = MPI.Allgather(npoints(piece), comm)
+    cells_counts = MPI.Allgather(ncells(piece), comm)
+    piece_index = Trixi.mpi_rank() + 1
+
+    if HDF5.has_parallel()
+        h5open(filename, "w", comm) do file
+            datasets = create_vtkhdf_datasets(file, variable_names, points_counts,
+                                              cells_counts, time; collective = true)
+            write_vtkhdf_piece!(datasets, variable_names, piece, piece_index,
+                                points_counts, cells_counts)
+        end
+    else
+        pieces = gather_vtkhdf_pieces(piece, points_counts, cells_counts, comm)
+        if Trixi.mpi_isroot()
+            h5open(filename, "w") do file
+                datasets = create_vtkhdf_datasets(file, variable_names, points_counts,
+                                                  cells_counts, time)
+                for (index, p) in enumerate(pieces)
+                    write_vtkhdf_piece!(datasets, variable_names, p, index,
+                                        points_counts, cells_counts)
+                end
+            end
+        end
+    end
+
+    return nothing
+end
+
+
+# Collect all pieces on rank 0 of `comm` (returns an empty vector on all other ranks)
+function gather_vtkhdf_pieces(piece, points_counts, cells_counts, comm)
+    n_variables = size(piece.point_data, 1)
+    root = 0
+    is_root = MPI.Comm_rank(comm) == root
+
+    function gather(data, counts)
+        if is_root
+            recv = similar(data, sum(counts))
+            MPI.Gatherv!(data, MPI.VBuffer(recv, counts), root, comm)
+        else
+            recv = similar(data, 0)
+            MPI.Gatherv!(data, nothing, root, comm)
+        end
+        return recv
+    end
+
+    points = gather(vec(piece.points), 3 .* points_counts)
+    connectivity = gather(piece.connectivity, points_counts)
+    offsets = gather(piece.offsets, cells_counts .+ 1)
+    types = gather(piece.types, cells_counts)
+    point_data = gather(vec(piece.point_data), n_variables .* points_counts)
+
+    if !is_root
+        return VTKHDFPiece[]
+    end
+
+    pieces = VTKHDFPiece[]
+    p = c = 0
+    for (n_points, n_cells) in zip(points_counts, cells_counts)
+        point_ids = (p + 1):(p + n_points)
+        cell_ids = (c + 1):(c + n_cells)
+        # each piece has one more offset than cells
+        offset_ids = (c + length(pieces) + 1):(c + length(pieces) + n_cells + 1)
+        point_coordinates = points[(3 * p + 1):(3 * (p + n_points))]
+        point_values = point_data[(n_variables * p + 1):(n_variables * (p + n_points))]
+
+        push!(pieces,
+              VTKHDFPiece(reshape(point_coordinates, 3, n_points),
+                          connectivity[point_ids], offsets[offset_ids], types[cell_ids],
+                          reshape(point_values, n_variables, n_points)))
+        p += n_points
+        c += n_cells
+    end
+
+    return pieces
+end
+
+
+# Combine several pieces into a single piece
+function merge_vtkhdf_pieces(pieces)
+    points = reduce(hcat, (piece.points for piece in pieces))
+    types = reduce(vcat, (piece.types for piece in pieces))
+    point_data = reduce(hcat, (piece.point_data for piece in pieces))
+
+    # connectivity refers to the points and offsets to the connectivity of the merged piece
+    connectivity = Int64[]
+    offsets = Int64[0]
+    point_offset = 0
+    connectivity_offset = 0
+    for piece in pieces
+        append!(connectivity, piece.connectivity .+ point_offset)
+        append!(offsets, piece.offsets[2:end] .+ connectivity_offset)
+        point_offset += npoints(piece)
+        connectivity_offset += length(piece.connectivity)
+    end
+
+    return VTKHDFPiece(points, connectivity, offsets, types, point_data)
+end
+
+
+# Communicators per compute node, created once and reused
+const shared_node_comms = Ref{Union{Nothing, Tuple{MPI.Comm, MPI.Comm}}}(nothing)
+
+"""
+    node_comms()
+
+Return a communicator of all ranks on the same compute node (i.e., that can share memory)
+and a communicator of all node leaders, which are the first rank of each node, e.g., used as
+aggregators for output. On all other ranks, the latter is `MPI.COMM_NULL`.
+"""
+function node_comms()
+    if isnothing(shared_node_comms[])
+        comm = Trixi.mpi_comm()
+        rank = MPI.Comm_rank(comm)
+        node_comm = MPI.Comm_split_type(comm, MPI.COMM_TYPE_SHARED, rank)
+        is_leader = MPI.Comm_rank(node_comm) == 0
+        leader_comm = MPI.Comm_split(comm, is_leader ? 0 : nothing, rank)
+        shared_node_comms[] = (node_comm, leader_comm)
+    end
+
+    return shared_node_comms[]
+end
+
+
+# Funnel the pieces of all ranks on a node to the aggregator, which merges them into one
+# piece per node, and let only the aggregators write the file (collectively if the HDF5
+# library supports MPI, otherwise via the first aggregator)
+function save_vtkhdf_aggregated(filename, piece, variable_names, time)
+    node_comm, aggregator_comm = node_comms()
+
+    node_points_counts = MPI.Allgather(npoints(piece), node_comm)
+    node_cells_counts = MPI.Allgather(ncells(piece), node_comm)
+    pieces = gather_vtkhdf_pieces(piece, node_points_counts, node_cells_counts, node_comm)
+
+    if aggregator_comm == MPI.COMM_NULL
+        return nothing
+    end
+
+    node_piece = merge_vtkhdf_pieces(pieces)
+    points_counts = MPI.Allgather(npoints(node_piece), aggregator_comm)
+    cells_counts = MPI.Allgather(ncells(node_piece), aggregator_comm)
+    piece_index = MPI.Comm_rank(aggregator_comm) + 1
+
+    if HDF5.has_parallel()
+        h5open(filename, "w", aggregator_comm) do file
+            datasets = create_vtkhdf_datasets(file, variable_names, points_counts,
+                                              cells_counts, time; collective = true)
+            write_vtkhdf_piece!(datasets, variable_names, node_piece, piece_index,
+                                points_counts, cells_counts)
+        end
+    else
+        node_pieces = gather_vtkhdf_pieces(node_piece, points_counts, cells_counts,
+                                           aggregator_comm)
+        if MPI.Comm_rank(aggregator_comm) == 0
+            h5open(filename, "w") do file
+                datasets = create_vtkhdf_datasets(file, variable_names, points_counts,
+                                                  cells_counts, time)
+                for (index, p) in enumerate(node_pieces)
+                    write_vtkhdf_piece!(datasets, variable_names, p, index,
+                                        points_counts, cells_counts)
+                end
+            end
+        end
+    end
+
+    return nothing
+end
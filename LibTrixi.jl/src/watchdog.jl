@@ -0,0 +1,152 @@
+"""
+    StragglerWatchdog
+
+Detect slow ranks from the time each rank spends on computation, i.e., the wall time of
+`trixi_step` minus the time spent waiting for MPI communication to finish. Every `interval`
+steps, the accumulated compute times of all ranks are gathered on the root rank with a
+non-blocking gather. Its result is evaluated after the first step in which the gather has
+completed, at the latest at the next check or when the watchdog is finalized. Ranks whose
+compute time exceeds `threshold` times the median compute time are reported by calling
+`report(rank, compute_time, median_time)` on the root rank.
+
+The MPI waiting time is taken from Trixi's timers and thus not subtracted if timers are
+disabled.
+"""
+mutable struct StragglerWatchdog{ReportType}
+    interval::Int
+    threshold::Float64
+    report::ReportType
+    n_steps::Int
+    compute_time::Float64               # accumulated since the last gather (in seconds)
+    request::MPI.Request                # pending gather
+    send_buffer::Vector{Float64}
+    recv_buffer::Vector{Float64}
+
+    function StragglerWatchdog(interval, threshold, report = report_straggler)
+        if interval < 1
+            error("watchdog interval must be positive: ", interval)
+        end
+        if threshold <= 1
+            error("watchdog threshold must be larger than one: ", threshold)
+        end
+
+        n_ranks = Trixi.mpi_isparallel() ? MPI.Comm_size(Trixi.mpi_comm()) : 1
+        recv_buffer = zeros(Trixi.mpi_isroot() ? n_ranks : 0)
+
+        return new{typeof(report)}(interval, threshold, report, 0, 0.0, MPI.Request(),
+                                   zeros(1), recv_buffer)
+    end
+end
+
+
+# Default report: log a warning on the root rank
+function report_straggler(rank, compute_time, median_time)
+    log_message(LOG_WARNING,
+                string("Straggler detected: rank ", rank, " computed for ", compute_time,
+                       " s (median ", median_time, " s)");
+                source = "watchdog", straggler_rank = rank, compute_time, median_time)
+    return nothing
+end
+
+
+# Accumulated time spent waiting for MPI communication in Trixi's `rhs!` (in nanoseconds)
+function mpi_wait_time_ns()
+    timer = Trixi.timer()
+    if !haskey(timer.inner_timers, "rhs!")
+        return 0
+    end
+
+    rhs_timer = timer["rhs!"]
+    wait_time = 0
+    for label in ("finish MPI receive", "finish MPI send")
+        if haskey(rhs_timer.inner_timers, label)
+            wait_time += Trixi.TimerOutputs.time(rhs_timer[label])
+        end
+    end
+
+    return wait_time
+end
+
+
+# Evaluate gathered compute times on the root rank and report stragglers
+function evaluate_compute_times(watchdog, compute_times)
+    median_time = sort(compute_times)[div(length(compute_times) + 1, 2)]
+    for (index, compute_time) in enumerate(compute_times)
+        if compute_time > watchdog.threshold * median_time
+            watchdog.report(index - 1, compute_time, median_time)
+        end
+    end
+
+    return nothing
+end
+
+
+# Evaluate the pending gather if it has completed, or after waiting for it if `wait` is
+# true; completing the request resets it to the null request
+function complete_gather!(watchdog, wait)
+    MPI.isnull(watchdog.request) && return nothing
+
+    if wait
+        MPI.Wait(watchdog.request)
+    elseif !MPI.Test(watchdog.request)
+        return nothing
+    end
+
+    if Trixi.mpi_isroot()
+        evaluate_compute_times(watchdog, watchdog.recv_buffer)
+    end
+
+    return nothing
+end
+
+
+"""
+    record_step!(watchdog::StragglerWatchdog, step_time_ns, wait_time_ns)
+
+Record the wall time and the MPI waiting time of a single step, evaluate a completed gather,
+and start a gather of the compute times every `interval` steps.
+"""
+function record_step!(watchdog::StragglerWatchdog, step_time_ns, wait_time_ns)
+    watchdog.compute_time += max(step_time_ns - wait_time_ns, 0) * 1.0e-9
+    watchdog.n_steps += 1
+
+    if !Trixi.mpi_isparallel()
+        if watchdog.n_steps % watchdog.interval == 0
+            evaluate_compute_times(watchdog, [watchdog.compute_time])
+            watchdog.compute_time = 0.0
+        end
+        return nothing
+    end
+
+    # the previous gather is evaluated as soon as it has completed, but at the latest before
+    # the next one is started
+    at_check = watchdog.n_steps % watchdog.interval == 0
+    complete_gather!(watchdog, at_check)
+    at_check || return nothing
+
+    # start next gather; the error handler of MPI.jl's communicators returns error codes,
+    # which `MPI.API` turns into an `MPIError`
+    watchdog.send_buffer[1] = watchdog.compute_time
+    watchdog.compute_time = 0.0
+    float64 = MPI.Datatype(Float64)
+    try
+        MPI.API.MPI_Igather(watchdog.send_buffer, 1, float64, watchdog.recv_buffer, 1,
+                            float64, 0, Trixi.mpi_comm(), watchdog.request)
+    catch exception
+        exception isa MPI.MPIError || rethrow()
+        error("straggler watchdog could not start gather of compute times: ",
+              sprint(showerror, exception))
+    end
+
+    return nothing
+end
+
+
+# Complete and evaluate a pending gather such that no request is left behind
+function finalize_watchdog!(watchdog::StragglerWatchdog)
+    if Trixi.mpi_isparallel()
+        complete_gather!(watchdog, true)
+    end
+
+    return nothing
+end
@@ -2,6 +2,7 @@ module TestInterface
 
 using Test
 using LibTrixi
+using HDF5: h5open, attributes
 
 
 @testset verbose=true showtiming=true "Version information" begin
@@ -81,6 +82,14 @@ end
 end
 
 
+# callback for streaming element blocks, counts the blocks
+function block_callback(element_offset::Cint, nelements::Cint, data::Ptr{Cdouble},
+                        userdata::Ptr{Cvoid})::Cvoid
+    n_blocks = unsafe_pointer_to_objref(userdata)::Base.RefValue{Int}
+    n_blocks[] += 1
+    return nothing
+end
+
 @testset verbose=true showtiming=true "Data access" begin
 
     # compare number of dimensions
@@ -147,6 +156,1083 @@ end
     data_jl = zeros(ndofs_jl)
     trixi_load_primitive_vars_jl(simstate_jl, 1, data_jl)
     @test data_c == data_jl
+
+    # stream primitive variable values in blocks of elements
+    data_blocks = zeros(ndofs_jl)
+    ndofselement = trixi_ndofselement_jl(simstate_jl)
+    function store_block(offset, n, data)
+        dofs = (offset * ndofselement + 1):((offset + n) * ndofselement)
+        data_blocks[dofs] .= vec(data)
+    end
+    trixi_foreach_element_block_jl(simstate_jl, 5, [1], store_block)
+    @test data_blocks == data_jl
+
+    # via API, count the blocks
+    variable_ids = Cint[1]
+    n_blocks = Ref(0)
+    callback = @cfunction(block_callback, Cvoid, (Cint, Cint, Ptr{Cdouble}, Ptr{Cvoid}))
+    trixi_foreach_element_block(handle, Int32(5), Int32(1), pointer(variable_ids), callback,
+                                pointer_from_objref(n_blocks))
+    @test n_blocks[] == cld(nelements_c, 5)
+end
+
+
+@testset verbose=true showtiming=true "Simulation output" begin
+
+    # write VTKHDF files via API and via julia
+    mktempdir() do dir
+        filename_c = joinpath(dir, "solution_c.vtkhdf")
+        filename_jl = joinpath(dir, "solution_jl.vtkhdf")
+        trixi_save_vtkhdf(handle, Cstring(pointer(filename_c)))
+        trixi_save_vtkhdf_jl(simstate_jl, filename_jl)
+
+        nelements = trixi_nelements_jl(simstate_jl)
+        nnodes = trixi_nnodes_jl(simstate_jl)
+        ndofs = trixi_ndofs_jl(simstate_jl)
+
+        h5open(filename_c) do file_c
+            h5open(filename_jl) do file_jl
+                vtkhdf_c = file_c["VTKHDF"]
+                vtkhdf_jl = file_jl["VTKHDF"]
+                @test read(attributes(vtkhdf_c)["Type"]) == "UnstructuredGrid"
+
+                # one Lagrange curve per element
+                @test read(vtkhdf_c["NumberOfCells"]) == [nelements]
+                @test read(vtkhdf_c["NumberOfPoints"]) == [ndofs]
+                @test all(==(LibTrixi.VTK_LAGRANGE_CURVE), read(vtkhdf_c["Types"]))
+                @test read(vtkhdf_c["Offsets"]) == collect(0:nnodes:ndofs)
+
+                # solution is identical
+                @test read(vtkhdf_c["PointData/scalar"]) ==
+                      read(vtkhdf_jl["PointData/scalar"])
+            end
+        end
+    end
+
+    # VTK Lagrange ordering: vertices, edges, faces, interior
+    for n in 1:4
+        for n_dims in 1:3
+            indices = [LibTrixi.vtk_lagrange_index(Tuple(ci)..., n)
+                       for ci in CartesianIndices(ntuple(_ -> 0:n, n_dims))]
+            @test sort(vec(indices)) == 0:((n + 1)^n_dims - 1)
+        end
+    end
+    @test [LibTrixi.vtk_lagrange_index(i, j, 2)
+           for (i, j) in ((0, 0), (2, 0), (2, 2), (0, 2), (1, 0), (2, 1), (1, 2), (0, 1),
+                          (1, 1))] == 0:8
+    @test [LibTrixi.vtk_lagrange_index(i, j, k, 2)
+           for (i, j, k) in ((0, 0, 0), (2, 0, 0), (2, 2, 0), (0, 2, 0), (0, 0, 2),
+                             (2, 0, 2), (2, 2, 2), (0, 2, 2), (1, 0, 0), (2, 1, 0),
+                             (1, 2, 0), (0, 1, 0), (1, 0, 2), (2, 1, 2), (1, 2, 2),
+                             (0, 1, 2), (0, 0, 1), (2, 0, 1), (2, 2, 1), (0, 2, 1),
+                             (0, 1, 1), (2, 1, 1), (1, 0, 1), (1, 2, 1), (1, 1, 0),
+                             (1, 1, 2), (1, 1, 1))] == 0:26
+
+    # pieces of a node are merged into a single contiguous piece
+    piece = LibTrixi.VTKHDFPiece(simstate_jl)
+    merged = LibTrixi.merge_vtkhdf_pieces([piece, piece])
+    n_points = LibTrixi.npoints(piece)
+    @test LibTrixi.npoints(merged) == 2 * n_points
+    @test LibTrixi.ncells(merged) == 2 * LibTrixi.ncells(piece)
+    @test merged.offsets == vcat(piece.offsets, piece.offsets[2:end] .+ n_points)
+    @test merged.connectivity == vcat(piece.connectivity, piece.connectivity .+ n_points)
+    @test merged.point_data == hcat(piece.point_data, piece.point_data)
+
+    # offsets are shifted by the connectivity, not by the points of the previous pieces
+    shared = LibTrixi.VTKHDFPiece(zeros(3, 3), [0, 1, 2, 0, 2], [0, 3, 5],
+                                  UInt8[LibTrixi.VTK_LAGRANGE_CURVE, 3], zeros(1, 3))
+    merged = LibTrixi.merge_vtkhdf_pieces([shared, shared])
+    @test merged.offsets == [0, 3, 5, 8, 10]
+    @test merged.connectivity == [0, 1, 2, 0, 2, 3, 4, 5, 3, 5]
+
+    # a piece without elements writes empty selections
+    empty_piece = LibTrixi.VTKHDFPiece(zeros(3, 0), Int64[], Int64[0], UInt8[], zeros(1, 0))
+    points_counts = [n_points, 0]
+    cells_counts = [LibTrixi.ncells(piece), 0]
+    mktempdir() do dir
+        filename = joinpath(dir, "pieces.vtkhdf")
+        h5open(filename, "w") do file
+            datasets = LibTrixi.create_vtkhdf_datasets(file, ["scalar"], points_counts,
+                                                       cells_counts, 0.0)
+            for (index, p) in enumerate((piece, empty_piece))
+                LibTrixi.write_vtkhdf_piece!(datasets, ["scalar"], p, index,
+                                             points_counts, cells_counts)
+            end
+        end
+        h5open(filename) do file
+            @test read(file["VTKHDF/NumberOfPoints"]) == points_counts
+            @test read(file["VTKHDF/Points"]) == piece.points
+            @test read(file["VTKHDF/Offsets"]) == vcat(piece.offsets, 0)
+            @test read(file["VTKHDF/PointData/scalar"]) == vec(piece.point_data)
+        end
+    end
+
+    # aggregated output is identical to regular output
+    trixi_set_output_aggregation(handle, Int32(1))
+    @test LibTrixi.simstates[handle].aggregate_output
+    mktempdir() do dir
+        filename_aggregated = joinpath(dir, "aggregated.vtkhdf")
+        filename = joinpath(dir, "solution.vtkhdf")
+        trixi_save_vtkhdf_jl(LibTrixi.simstates[handle], filename_aggregated)
+        LibTrixi.save_vtkhdf(filename, LibTrixi.simstates[handle]; aggregate = false)
+        h5open(filename_aggregated) do file_aggregated
+            h5open(filename) do file
+                @test read(file_aggregated["VTKHDF/NumberOfPoints"]) ==
+                      [trixi_ndofs(handle)]
+                for name in ("NumberOfCells", "Points", "Connectivity", "Offsets",
+                             "Types", "PointData/scalar")
+                    @test read(file_aggregated["VTKHDF/" * name]) ==
+                          read(file["VTKHDF/" * name])
+                end
+            end
+        end
+    end
+    trixi_set_output_aggregation(handle, Int32(0))
+end
+
+
+@testset verbose=true showtiming=true "Straggler watchdog" begin
+
+    # enable via API with default report, then disable again
+    trixi_set_straggler_watchdog(handle, Int32(2), 1.5, C_NULL, C_NULL)
+    @test LibTrixi.simstates[handle].watchdog isa LibTrixi.StragglerWatchdog
+    trixi_step(handle)
+    trixi_step(handle)
+    @test LibTrixi.simstates[handle].watchdog.n_steps == 2
+    trixi_set_straggler_watchdog(handle, Int32(0), 1.5, C_NULL, C_NULL)
+    @test isnothing(LibTrixi.simstates[handle].watchdog)
+
+    # ranks exceeding the threshold times the median are reported
+    reported = Tuple{Int, Float64, Float64}[]
+    report = (rank, t, t_median) -> push!(reported, (rank, t, t_median))
+    trixi_set_straggler_watchdog_jl(simstate_jl, 1, 1.5, report)
+    LibTrixi.evaluate_compute_times(simstate_jl.watchdog, [1.0, 1.2, 2.0, 0.9])
+    @test reported == [(2, 2.0, 1.0)]
+
+    # a single rank is never a straggler
+    trixi_step_jl(simstate_jl)
+    @test length(reported) == 1
+    trixi_set_straggler_watchdog_jl(simstate_jl, 0, 1.5)
+
+    @test_throws ErrorException trixi_set_straggler_watchdog_jl(simstate_jl, 1, 0.5)
+end
+
+
+@testset verbose=true showtiming=true "Polynomial degree" begin
+
+    # use a further instance of the simulation
+    polydeg_handle = trixi_initialize_simulation(libelixir)
+    trixi_step(polydeg_handle)
+    u = copy(LibTrixi.simstates[polydeg_handle].integrator.u)
+    time = trixi_get_simulation_time(polydeg_handle)
+    nelements = trixi_nelements(polydeg_handle)
+
+    # increasing the degree changes all sizes, but not the time
+    trixi_set_polydeg(polydeg_handle, Int32(5))
+    @test trixi_nnodes(polydeg_handle) == 6
+    @test trixi_ndofs(polydeg_handle) == 6 * nelements
+    @test trixi_get_simulation_time(polydeg_handle) == time
+
+    # decreasing the degree again recovers the original solution
+    trixi_set_polydeg(polydeg_handle, Int32(3))
+    @test trixi_nnodes(polydeg_handle) == 4
+    @test LibTrixi.simstates[polydeg_handle].integrator.u ≈ u
+
+    # simulation continues with the rebuilt integrator
+    trixi_step(polydeg_handle)
+    @test trixi_get_simulation_time(polydeg_handle) > time
+
+    # registered data is invalidated, host memory is no longer referenced
+    simstate = LibTrixi.simstates[polydeg_handle]
+    registry = simstate.registry
+    push!(registry, Vector{Float64}(), Vector{Float64}())
+    host_data = zeros(trixi_ndofs(polydeg_handle))
+    trixi_register_data(polydeg_handle, Int32(1), Int32(length(host_data)),
+                        pointer(host_data))
+    trixi_allocate_data(polydeg_handle, Int32(2), Int32(3))
+    trixi_set_polydeg(polydeg_handle, Int32(4))
+    @test LibTrixi.simstates[polydeg_handle].registry === registry
+    @test length(registry) == 2
+    @test !isassigned(registry, 1)
+    @test !isassigned(registry, 2)
+
+    # stepping fails until all entries are assigned again for the new degree
+    host_data = zeros(trixi_ndofs(polydeg_handle))
+    trixi_register_data(polydeg_handle, Int32(1), Int32(length(host_data)),
+                        pointer(host_data))
+    @test pointer(registry[1]) == pointer(host_data)
+    message = "data registry entry 2 is not assigned, register or allocate data before " *
+              "the next step"
+    @test_throws ErrorException(message) trixi_step(polydeg_handle)
+    trixi_allocate_data(polydeg_handle, Int32(2), Int32(3))
+    trixi_step(polydeg_handle)
+    trixi_set_polydeg(polydeg_handle, Int32(3))
+
+    # julia variant returns a new simulation state
+    simstate_new = trixi_set_polydeg_jl(LibTrixi.simstates[polydeg_handle], 2)
+    @test trixi_nnodes_jl(simstate_new) == 3
+    @test_throws ErrorException trixi_set_polydeg_jl(simstate_new, 0)
+
+    trixi_finalize_simulation(polydeg_handle)
+end
+
+
+@testset verbose=true showtiming=true "Single precision" begin
+
+    # single and mixed precision instances next to a double precision reference
+    reference_handle = trixi_initialize_simulation(libelixir)
+    f32_handle = trixi_initialize_simulation_f32(libelixir, false)
+    mixed_handle = trixi_initialize_simulation_f32(libelixir, true)
+    for (h, RealT) in ((f32_handle, Float32), (mixed_handle, Float64))
+        simstate = LibTrixi.simstates[h]
+        _, _, solver, _ = LibTrixi.mesh_equations_solver_cache(simstate.semi)
+        @test eltype(simstate.integrator.u) == Float32
+        @test real(solver) == RealT
+    end
+
+    # libelixirs with precision keywords are set up without conversion
+    simstate_direct = trixi_initialize_simulation_jl(libelixir; RealT = Float32,
+                                                     uEltype = Float32)
+    _, _, solver, _ = LibTrixi.mesh_equations_solver_cache(simstate_direct.semi)
+    @test eltype(simstate_direct.integrator.u) == Float32
+    @test real(solver) == Float32
+
+    # same results up to single precision accuracy
+    ndofs = trixi_ndofs(reference_handle)
+    data_reference = zeros(ndofs)
+    data_f32 = zeros(Float32, ndofs)
+    for h in (reference_handle, f32_handle, mixed_handle)
+        trixi_step(h)
+    end
+    trixi_load_primitive_vars(reference_handle, Int32(1), data_reference)
+    for h in (f32_handle, mixed_handle)
+        @test trixi_get_simulation_time(h) ≈ trixi_get_simulation_time(reference_handle)
+        trixi_load_primitive_vars_f32(h, Int32(1), data_f32)
+        @test isapprox(data_f32, data_reference, rtol = 1.0e-5)
+    end
+
+    data_averages = zeros(Float32, trixi_nelements(f32_handle))
+    trixi_load_element_averaged_primitive_vars_f32(f32_handle, Int32(1), data_averages)
+    @test all(isfinite, data_averages)
+
+    # single precision data in the registry
+    simstate = LibTrixi.simstates[f32_handle]
+    push!(simstate.registry, zeros(1))
+    @test_throws ErrorException trixi_register_data_jl(simstate, 1, data_f32)
+    simstate.registry = LibTrixiDataRegistryF32(undef, 1)
+    trixi_register_data_f32(f32_handle, Int32(1), Int32(ndofs), pointer(data_f32))
+    @test simstate.registry[1] isa Vector{Float32}
+    @test pointer(simstate.registry[1]) == pointer(data_f32)
+    @test_throws ErrorException trixi_register_data_jl(simstate, 1, data_reference)
+    @test_throws ErrorException trixi_allocate_data_jl(simstate, 1, ndofs)
+
+    # precision can also be changed later on
+    simstate_f32 = LibTrixi.set_precision(LibTrixi.simstates[reference_handle], Float32)
+    @test eltype(simstate_f32.integrator.u) == Float32
+
+    for h in (reference_handle, f32_handle, mixed_handle)
+        trixi_finalize_simulation(h)
+    end
+end
+
+
+@testset verbose=true showtiming=true "AMR autotuning" begin
+    # the simulation has no AMR callback
+    @test_throws ErrorException trixi_get_amr_interval_jl(simstate_jl)
+    @test_throws ErrorException trixi_set_amr_autotuning_jl(simstate_jl, 1, 10)
+end
+
+
+@testset verbose=true showtiming=true "Reinitialize" begin
+
+    sweep_handle = trixi_initialize_simulation(libelixir)
+    simstate = LibTrixi.simstates[sweep_handle]
+    integrator = simstate.integrator
+    u0 = copy(integrator.u)
+
+    for _ in 1:3
+        trixi_step(sweep_handle)
+    end
+    @test integrator.u != u0
+
+    # same time span, the integrator is reused
+    trixi_reinitialize(sweep_handle, 0.0, 1.0)
+    @test simstate.integrator === integrator
+    @test integrator.u ≈ u0
+    @test trixi_get_simulation_time(sweep_handle) == 0.0
+    @test integrator.iter == 0
+    @test integrator.stats.naccept == 0
+    trixi_step(sweep_handle)
+    @test integrator.iter == 1
+
+    # state given by the host
+    data = 2 .* u0
+    trixi_set_initial_state(sweep_handle, 0.0, 1.0, pointer(data))
+    @test simstate.integrator.u ≈ data
+
+    # new time span
+    trixi_reinitialize(sweep_handle, 0.5, 0.75)
+    @test trixi_get_simulation_time(sweep_handle) == 0.5
+    @test simstate.integrator.sol.prob.tspan == (0.5, 0.75)
+    while trixi_is_finished(sweep_handle) == 0
+        trixi_step(sweep_handle)
+    end
+    @test trixi_get_simulation_time(sweep_handle) ≈ 0.75
+
+    @test_throws ErrorException trixi_reinitialize_jl(simstate, 1.0, 0.5)
+
+    # a preempted simulation can be restarted with a new wall-time budget
+    trixi_set_preemption_jl(simstate, 1000.0, mktempdir(), false)
+    preemption = simstate.preemption
+    preemption.triggered = true
+    preemption.signal = 15
+    preemption.max_step_time = 2000.0
+    start_time = preemption.start_time
+    trixi_reinitialize_jl(simstate, 0.0, 1.0)
+    @test !preemption.triggered
+    @test preemption.signal == 0
+    @test preemption.max_step_time == 0.0
+    @test preemption.start_time >= start_time
+    @test !trixi_is_finished_jl(simstate)
+
+    trixi_finalize_simulation(sweep_handle)
+end
+
+
+@testset verbose=true showtiming=true "Ensemble" begin
+
+    # ensemble of three copies of a fresh instance
+    base_handle = trixi_initialize_simulation(libelixir)
+    ensemble_handle = trixi_create_ensemble(base_handle, Int32(3))
+    @test trixi_nmembers(ensemble_handle) == 3
+    @test trixi_nmembers(base_handle) == 1
+    @test trixi_nvariables(ensemble_handle) == 3 * trixi_nvariables(base_handle)
+    @test trixi_ndofs(ensemble_handle) == trixi_ndofs(base_handle)
+
+    # shift the second member, which is preserved by linear advection
+    u_base = copy(LibTrixi.simstates[base_handle].integrator.u)
+    trixi_store_member_conservative_vars(ensemble_handle, Int32(2), u_base .+ 1.0)
+
+    # one ensemble step advances all members like the single simulation
+    trixi_step(base_handle)
+    trixi_step(ensemble_handle)
+    @test trixi_get_simulation_time(ensemble_handle) ≈
+          trixi_get_simulation_time(base_handle)
+    ndofs = trixi_ndofs(base_handle)
+    data_base = zeros(ndofs)
+    data_member = zeros(ndofs)
+    trixi_load_primitive_vars(base_handle, Int32(1), data_base)
+    trixi_load_member_primitive_vars(ensemble_handle, Int32(1), Int32(1), data_member)
+    @test data_member ≈ data_base
+    trixi_load_member_primitive_vars(ensemble_handle, Int32(2), Int32(1), data_member)
+    @test data_member ≈ data_base .+ 1.0
+
+    # invalid members
+    ensemble = LibTrixi.simstates[ensemble_handle]
+    @test_throws ErrorException trixi_load_member_primitive_vars_jl(ensemble, 4, 1,
+                                                                    data_member)
+    @test_throws ErrorException trixi_create_ensemble_jl(ensemble, 0)
+
+    trixi_finalize_simulation(ensemble_handle)
+    trixi_finalize_simulation(base_handle)
+
+    # a shared P4estMesh is only finalized with the last simulation that uses it, here with
+    # a volume integral that is supported by ensembles
+    p4est_libelixir = joinpath(mktempdir(), "libelixir_p4est2d_euler.jl")
+    p4est_source = read(joinpath(dirname(pathof(LibTrixi)),
+                                 "../examples/libelixir_p4est2d_euler_sedov.jl"), String)
+    flux_differencing = "VolumeIntegralFluxDifferencing(volume_flux)"
+    write(p4est_libelixir, replace(p4est_source, "volume_integral=volume_integral)" =>
+                                                 "volume_integral=$flux_differencing)"))
+    trixi_set_deferred_teardown(Int32(1), Int32(0))
+    teardown = LibTrixi.deferred_teardown[]
+    base_handle = trixi_initialize_simulation(p4est_libelixir)
+    ensemble_handle = trixi_create_ensemble(base_handle, Int32(2))
+    base_semi = LibTrixi.simstates[base_handle].semi
+    mesh, _, _, _ = LibTrixi.mesh_equations_solver_cache(base_semi)
+    @test LibTrixi.mesh_shares[mesh] == 1
+    trixi_finalize_simulation(base_handle)
+    @test isempty(teardown.pending_meshes)
+    @test !haskey(LibTrixi.mesh_shares, mesh)
+    trixi_step(ensemble_handle)
+    trixi_finalize_simulation(ensemble_handle)
+    @test only(teardown.pending_meshes) === mesh
+    trixi_set_deferred_teardown(Int32(0), Int32(0))
+end
+
+
+@testset verbose=true showtiming=true "Element ordering" begin
+
+    ordering_handle = trixi_initialize_simulation(libelixir)
+    simstate = LibTrixi.simstates[ordering_handle]
+    nelements = trixi_nelements(ordering_handle)
+    ndofselement = trixi_ndofselement(ordering_handle)
+    data = zeros(trixi_ndofs(ordering_handle))
+    averages = zeros(nelements)
+    trixi_load_primitive_vars(ordering_handle, Int32(1), data)
+    trixi_load_element_averaged_primitive_vars(ordering_handle, Int32(1), averages)
+
+    # reversed element order
+    ordering = Cint.(reverse(1:nelements))
+    trixi_set_element_ordering(ordering_handle, Cint(nelements), pointer(ordering))
+    data_ordered = zeros(length(data))
+    averages_ordered = zeros(nelements)
+    trixi_load_primitive_vars(ordering_handle, Int32(1), data_ordered)
+    trixi_load_element_averaged_primitive_vars(ordering_handle, Int32(1), averages_ordered)
+    @test averages_ordered == reverse(averages)
+    @test reshape(data_ordered, ndofselement, :) == reverse(reshape(data, ndofselement, :),
+                                                            dims = 2)
+
+    # registered element data would not be permuted and is rejected
+    push!(simstate.registry, Vector{Float64}())
+    @test_throws ErrorException trixi_register_data_jl(simstate, 1, data)
+    @test_throws ErrorException trixi_register_data_jl(simstate, 1, averages)
+    @test_throws ErrorException trixi_allocate_data_jl(simstate, 1, nelements)
+    trixi_register_data_jl(simstate, 1, zeros(3))
+    trixi_register_data_jl(simstate, 1, zeros(2 * length(data)))
+    trixi_set_element_ordering(ordering_handle, Cint(0), Ptr{Cint}(C_NULL))
+    trixi_register_data_jl(simstate, 1, data)
+    @test_throws ErrorException trixi_set_element_ordering_jl(simstate, ordering)
+    empty!(simstate.registry)
+    trixi_set_element_ordering(ordering_handle, Cint(nelements), pointer(ordering))
+
+    # duplicate positions are not a permutation
+    duplicates = collect(1:nelements)
+    duplicates[2] = 1
+    @test_throws "not a permutation" trixi_set_element_ordering_jl(simstate, duplicates)
+
+    # an outdated ordering is rejected
+    simstate.mesh_epoch += 1
+    @test_throws ErrorException trixi_load_primitive_vars_jl(simstate, 1, data_ordered)
+    @test_throws ErrorException trixi_set_element_ordering_jl(simstate, [1, 1])
+    trixi_set_element_ordering(ordering_handle, Cint(0), Ptr{Cint}(C_NULL))
+    trixi_load_primitive_vars(ordering_handle, Int32(1), data_ordered)
+    @test data_ordered == data
+
+    trixi_finalize_simulation(ordering_handle)
+end
+
+
+# output variable given as C function, negates the first conservative variable
+function output_variable_negate(u::Ptr{Cdouble}, nvariables::Cint,
+                                userdata::Ptr{Cvoid})::Cdouble
+    return -unsafe_load(u)
+end
+
+@testset verbose=true showtiming=true "Output variables" begin
+
+    output_handle = trixi_initialize_simulation(libelixir)
+    simstate = LibTrixi.simstates[output_handle]
+    ndofs = trixi_ndofs(output_handle)
+    scalar = zeros(ndofs)
+    data = zeros(ndofs)
+    trixi_load_primitive_vars(output_handle, Int32(1), scalar)
+
+    # Julia expression
+    square_handle = trixi_define_output_variable_jl(simstate, "square",
+                                                    "(u, equations) -> u[1]^2")
+    @test square_handle == 1
+    trixi_load_variable(output_handle, Int32(square_handle), data)
+    @test data ≈ scalar .^ 2
+
+    # redefinition keeps the handle
+    @test trixi_define_output_variable_jl(simstate, "square",
+                                          (u, equations) -> 2 * u[1]) == square_handle
+    trixi_load_variable_jl(simstate, square_handle, data)
+    @test data ≈ 2 .* scalar
+
+    # C function
+    negate = @cfunction(output_variable_negate, Cdouble, (Ptr{Cdouble}, Cint, Ptr{Cvoid}))
+    negate_handle = trixi_define_output_variable_callback(output_handle,
+                                                          Cstring(pointer("negate")),
+                                                          negate, C_NULL)
+    @test negate_handle == 2
+    trixi_load_variable(output_handle, negate_handle, data)
+    @test data == -scalar
+
+    # definitions survive rebuilding the simulation
+    trixi_set_polydeg(output_handle, Int32(4))
+    @test length(LibTrixi.simstates[output_handle].output_variables) == 2
+
+    @test_throws ErrorException trixi_load_variable_jl(simstate, 3, data)
+    @test_throws ErrorException trixi_define_output_variable_jl(simstate, "",
+                                                                "Trixi.entropy")
+
+    trixi_finalize_simulation(output_handle)
+end
+
+
+@testset verbose=true showtiming=true "Nesting" begin
+
+    # couple a second instance of the same simulation as child
+    child_handle = trixi_initialize_simulation(libelixir)
+    trixi_step(child_handle)
+    parent = LibTrixi.simstates[handle]
+    child = LibTrixi.simstates[child_handle]
+    child.integrator.u .+= 1.0
+
+    nesting_handle = trixi_create_nesting(handle, child_handle, 0.5, 1.0)
+    nesting = LibTrixi.nestings[nesting_handle]
+    @test !isempty(nesting.relaxation_dofs)
+    @test !isempty(nesting.feedback_dofs)
+
+    # julia variant operates on the same simulations
+    nesting_jl = trixi_create_nesting_jl(parent, child, 0.5, 1.0)
+    @test nesting_jl.relaxation_dofs == nesting.relaxation_dofs
+    @test nesting_jl.feedback_dofs == nesting.feedback_dofs
+
+    # parent-to-child: child equals parent on its boundary, interior is untouched
+    u_parent = copy(parent.integrator.u)
+    u_child = copy(child.integrator.u)
+    trixi_nesting_interpolate(nesting_handle)
+    boundary_dofs = nesting.relaxation_dofs[nesting.relaxation_weights .== 1]
+    @test !isempty(boundary_dofs)
+    @test child.integrator.u[boundary_dofs] ≈ u_parent[boundary_dofs]
+    @test child.integrator.u[nesting.feedback_dofs] == u_child[nesting.feedback_dofs]
+
+    # child-to-parent: parent equals child in the child interior
+    trixi_nesting_feedback_jl(nesting_jl)
+    @test parent.integrator.u[nesting.feedback_dofs] ≈ u_child[nesting.feedback_dofs]
+    trixi_finalize_nesting_jl(nesting_jl)
+
+    # nestings are only used via their handle
+    trixi_finalize_nesting(nesting_handle)
+    @test_throws ErrorException trixi_nesting_feedback(nesting_handle)
+
+    # restore parent state for the finalization checks
+    parent.integrator.u .= u_parent
+    trixi_finalize_simulation(child_handle)
+end
+
+
+@testset verbose=true showtiming=true "Solution transfer" begin
+
+    # transfer to a higher polynomial degree is exact
+    src_handle = trixi_initialize_simulation(libelixir)
+    trixi_step(src_handle)
+    simstate_src = LibTrixi.simstates[src_handle]
+    simstate_dst = trixi_set_polydeg_jl(simstate_src, 5)
+    dst_handle = store_simstate(simstate_dst)
+    u_expected = copy(simstate_dst.integrator.u)
+
+    fill!(simstate_dst.integrator.u, 0.0)
+    trixi_transfer_solution(src_handle, dst_handle, Int32(0))
+    @test simstate_dst.integrator.u ≈ u_expected
+
+    fill!(simstate_dst.integrator.u, 0.0)
+    trixi_transfer_solution_jl(simstate_src, simstate_dst, true)
+    @test simstate_dst.integrator.u ≈ u_expected
+
+    trixi_finalize_simulation(dst_handle)
+    trixi_finalize_simulation(src_handle)
+
+    # transfer between nested meshes, the initial solution is continuous across elements
+    # and thus the transfer to the finer mesh and back is exact
+    coarse_elixir = joinpath(mktempdir(), "libelixir_coarse.jl")
+    write(coarse_elixir, replace(read(libelixir, String),
+                                 "initial_refinement_level=4" =>
+                                 "initial_refinement_level=3"))
+    coarse_handle = trixi_initialize_simulation(coarse_elixir)
+    fine_handle = trixi_initialize_simulation(libelixir)
+    @test trixi_nelements(fine_handle) == 2 * trixi_nelements(coarse_handle)
+    simstate_coarse = LibTrixi.simstates[coarse_handle]
+    simstate_fine = LibTrixi.simstates[fine_handle]
+    u_coarse = copy(simstate_coarse.integrator.u)
+    u_fine = copy(simstate_fine.integrator.u)
+
+    fill!(simstate_fine.integrator.u, 0.0)
+    trixi_transfer_solution(coarse_handle, fine_handle, Int32(0))
+    @test isapprox(simstate_fine.integrator.u, u_fine, atol = 1e-3)
+
+    fill!(simstate_coarse.integrator.u, 0.0)
+    trixi_transfer_solution(fine_handle, coarse_handle, Int32(1))
+    @test simstate_coarse.integrator.u ≈ u_coarse
+
+    # points outside of the source mesh are not located and have no values
+    points = [-0.5 0.25 2.0]
+    interpolation = LibTrixi.PointInterpolation(simstate_coarse, points)
+    @test interpolation.located == [true, true, false]
+    values = LibTrixi.interpolate_to_points(interpolation, simstate_coarse)
+    @test size(values) == (1, 3)
+    @test values[1, 3] == 0.0
+
+    trixi_finalize_simulation(fine_handle)
+    trixi_finalize_simulation(coarse_handle)
+end
+
+
+# coupling function for the scheduler, records all synchronization times
+const scheduler_sync_times = Float64[]
+function scheduler_coupling(t::Cdouble, userdata::Ptr{Cvoid})::Cvoid
+    push!(scheduler_sync_times, t)
+    return nothing
+end
+
+@testset verbose=true showtiming=true "Scheduler" begin
+
+    # run two further simulations via API until they are finished
+    handles = Cint[trixi_initialize_simulation(libelixir) for _ in 1:2]
+    coupling = @cfunction(scheduler_coupling, Cvoid, (Cdouble, Ptr{Cvoid}))
+    trixi_scheduler_run(Cint(2), pointer(handles), 0.25, coupling, C_NULL)
+    @test scheduler_sync_times ≈ [0.25, 0.5, 0.75, 1.0]
+    @test all(handle -> trixi_is_finished(handle) == 1, handles)
+    foreach(trixi_finalize_simulation, handles)
+
+    # all simulations are at the synchronization time when coupling is called
+    simstates = [trixi_initialize_simulation_jl(libelixir) for _ in 1:2]
+    n_synced = Ref(0)
+    trixi_scheduler_run_jl(simstates, 0.3,
+                           t -> n_synced[] += all(s -> s.integrator.t ≈ t, simstates))
+    @test n_synced[] == 4
+    @test all(trixi_is_finished_jl, simstates)
+    foreach(trixi_finalize_simulation_jl, simstates)
+
+    @test_throws ErrorException trixi_scheduler_run_jl(simstates, 0.0)
+
+    # with multiple threads, the simulations are advanced concurrently, while the log sink
+    # is never called concurrently and a signal preempts both of them (in a separate process
+    # with two threads, and without solution files, which would be written to the same path)
+    scheduler_directory = mktempdir()
+    concurrent_libelixir = joinpath(scheduler_directory, "libelixir.jl")
+    write(concurrent_libelixir, replace(read(libelixir, String), "save_solution, " => ""))
+    script = """
+        using LibTrixi
+        Threads.nthreads() == 2 || error("expected two threads")
+        active, overlaps = Threads.Atomic{Int}(0), Threads.Atomic{Int}(0)
+        function write_record(level, line)
+            Threads.atomic_add!(active, 1) > 0 && Threads.atomic_add!(overlaps, 1)
+            Libc.systemsleep(0.001)
+            Threads.atomic_sub!(active, 1)
+        end
+        trixi_set_log_sink_jl(write_record, LibTrixi.LOG_DEBUG)
+        simstates = [trixi_initialize_simulation_jl("libelixir.jl") for _ in 1:2]
+        for (i, simstate) in enumerate(simstates)
+            trixi_set_preemption_jl(simstate, 0.0, "checkpoint_\$i", true)
+        end
+        trixi_scheduler_run_jl(simstates, 0.25, t -> LibTrixi.record_signal!(Cint(10)))
+        all(trixi_is_preempted_jl, simstates) || error("simulations not preempted")
+        foreach(trixi_finalize_simulation_jl, simstates)
+        isempty(LibTrixi.signal_watchers) || error("signals still handled")
+        overlaps[] == 0 || error("log sink called concurrently")
+        """
+    julia = `$(Base.julia_cmd()) --threads=2 --project=$(Base.active_project()) -e $script`
+    @test success(pipeline(Cmd(julia; dir = scheduler_directory), stdout = devnull))
+end
+
+
+@testset verbose=true showtiming=true "Preemption" begin
+
+    # a signal stops all simulations that handle signals after the next step (the signal
+    # thread of the C library is tested in test/c, here the signal is recorded directly)
+    checkpoint_directory = mktempdir()
+    preempted_handle = trixi_initialize_simulation(libelixir)
+    trixi_set_preemption(preempted_handle, 0.0, Cint(1),
+                         Cstring(pointer(checkpoint_directory)))
+    simstate = trixi_initialize_simulation_jl(libelixir)
+    trixi_set_preemption_jl(simstate, 0.0, mktempdir(), true)
+    @test length(LibTrixi.signal_watchers) == 2
+    trixi_step(preempted_handle)
+    @test trixi_is_preempted(preempted_handle) == 0
+    LibTrixi.record_signal!(Cint(15))
+    trixi_step(preempted_handle)
+    trixi_step_jl(simstate)
+    @test trixi_is_preempted(preempted_handle) == 1
+    @test trixi_is_finished(preempted_handle) == 1
+    @test trixi_is_preempted_jl(simstate)
+    @test trixi_get_simulation_time(preempted_handle) < 1.0
+    @test any(file -> startswith(file, "restart"), readdir(checkpoint_directory))
+    @test any(file -> startswith(file, "mesh"), readdir(checkpoint_directory))
+
+    # the preemption consumes the signal, and finalizing hands signals back to Julia
+    @test LibTrixi.simstates[preempted_handle].preemption.signal == 0
+    @test simstate.preemption.signal == 0
+    trixi_finalize_simulation(preempted_handle)
+    trixi_finalize_simulation_jl(simstate)
+    @test isempty(LibTrixi.signal_watchers)
+
+    # an exhausted wall-time budget stops the simulation as well
+    simstate = trixi_initialize_simulation_jl(libelixir)
+    trixi_set_preemption_jl(simstate, 1.0e-9, checkpoint_directory)
+    trixi_step_jl(simstate)
+    @test trixi_is_preempted_jl(simstate)
+    @test trixi_is_finished_jl(simstate)
+    trixi_finalize_simulation_jl(simstate)
+
+    @test_throws ErrorException trixi_set_preemption_jl(simstate, 1.0, "")
+end
+
+
+@testset verbose=true showtiming=true "Health check" begin
+
+    # a healthy solution passes all checks
+    health_handle = trixi_initialize_simulation(libelixir)
+    trixi_set_health_check(health_handle, Cint(1), Cint(LibTrixi.HEALTH_STOP), Cint(3))
+    trixi_step(health_handle)
+    @test trixi_get_health_status(health_handle) == 0
+    @test trixi_is_finished(health_handle) == 0
+
+    # a non-finite value stops the simulation after the next check
+    simstate = LibTrixi.simstates[health_handle]
+    simstate.integrator.u[5] = NaN
+    trixi_step(health_handle)
+    @test trixi_get_health_status(health_handle) == LibTrixi.HEALTH_NONFINITE
+    @test trixi_is_finished(health_handle) == 1
+    @test count(!iszero, simstate.health_check.element_status) >= 1
+    trixi_finalize_simulation(health_handle)
+
+    # rolling back restores the solution before the offending step, which is corrupted
+    # after the backup as by a failing step
+    simstate = trixi_initialize_simulation_jl(libelixir)
+    trixi_set_health_check_jl(simstate, 2, LibTrixi.HEALTH_ROLLBACK)
+    trixi_step_jl(simstate)
+    health = simstate.health_check
+    LibTrixi.backup_solution!(health, simstate.integrator, simstate.buffer_storage)
+    @test health.u_backup == simstate.integrator.u
+    u_backup = copy(health.u_backup)
+    t = simstate.integrator.t
+    LibTrixi.step!(simstate.integrator)
+    simstate.integrator.u[1] = Inf
+    LibTrixi.check_step!(simstate, 0)
+    @test trixi_get_health_status_jl(simstate) == LibTrixi.HEALTH_NONFINITE
+    @test trixi_is_finished_jl(simstate)
+    @test simstate.integrator.t == t
+    @test simstate.integrator.u == u_backup
+    @test all(isfinite, simstate.integrator.u)
+
+    # reinitializing resets the check, reporting lets the simulation continue
+    trixi_reinitialize_jl(simstate, 0.0, 1.0)
+    @test trixi_get_health_status_jl(simstate) == LibTrixi.HEALTH_OK
+    trixi_set_health_check_jl(simstate, 1, LibTrixi.HEALTH_REPORT)
+    simstate.integrator.u[1] = NaN
+    LibTrixi.check_step!(simstate, 0)
+    @test trixi_get_health_status_jl(simstate) == LibTrixi.HEALTH_NONFINITE
+    @test !trixi_is_finished_jl(simstate)
+    trixi_finalize_simulation_jl(simstate)
+
+    @test_throws ErrorException trixi_set_health_check_jl(simstate, 1, 3)
+    @test_throws "must be positive" trixi_set_health_check_jl(simstate, 1,
+                                                              LibTrixi.HEALTH_STOP, 0)
+end
+
+
+@testset verbose=true showtiming=true "Buffer storage" begin
+
+    storage_handle = trixi_initialize_simulation(libelixir)
+    simstate = LibTrixi.simstates[storage_handle]
+    push!(simstate.registry, Vector{Float64}())
+    ndofs = trixi_ndofs(storage_handle)
+
+    # regular memory by default
+    data_ptr = trixi_allocate_data(storage_handle, Int32(1), Int32(ndofs))
+    @test data_ptr == pointer(simstate.registry[1])
+    @test all(iszero, simstate.registry[1])
+
+    # file-backed memory maps, the files are removed right after mapping
+    directory = mktempdir()
+    trixi_set_buffer_storage(storage_handle, Cstring(pointer(directory)),
+                             Int32(LibTrixi.ACCESS_RANDOM))
+    data_ptr = trixi_allocate_data(storage_handle, Int32(1), Int32(ndofs))
+    data = unsafe_wrap(Array, data_ptr, ndofs)
+    @test data_ptr == pointer(simstate.registry[1])
+    @test all(iszero, data)
+    data .= 1:ndofs
+    @test simstate.registry[1][end] == ndofs
+    @test isempty(readdir(directory))
+
+    # the storage is kept when the simulation state is rebuilt
+    trixi_set_polydeg(storage_handle, Int32(4))
+    simstate = LibTrixi.simstates[storage_handle]
+    @test simstate.buffer_storage.directory == directory
+
+    trixi_set_buffer_storage(storage_handle, Cstring(pointer("")), Int32(0))
+    @test isnothing(simstate.buffer_storage)
+    @test_throws ErrorException trixi_set_buffer_storage_jl(simstate, directory, 42)
+
+    trixi_finalize_simulation(storage_handle)
+end
+
+
+# host allocator based on malloc, counts the allocated bytes
+function host_alloc(size::Csize_t, userdata::Ptr{Cvoid})::Ptr{Cvoid}
+    allocated = unsafe_pointer_to_objref(userdata)::Base.RefValue{Int}
+    allocated[] += size
+    return Libc.malloc(size)
+end
+
+function host_free(ptr::Ptr{Cvoid}, userdata::Ptr{Cvoid})::Cvoid
+    Libc.free(ptr)
+    return nothing
+end
+
+@testset verbose=true showtiming=true "Host allocator" begin
+
+    allocator_handle = trixi_initialize_simulation(libelixir)
+    simstate = LibTrixi.simstates[allocator_handle]
+    push!(simstate.registry, Vector{Float64}())
+    ndofs = trixi_ndofs(allocator_handle)
+
+    allocated = Ref(0)
+    alloc_fn = @cfunction(host_alloc, Ptr{Cvoid}, (Csize_t, Ptr{Cvoid}))
+    free_fn = @cfunction(host_free, Cvoid, (Ptr{Cvoid}, Ptr{Cvoid}))
+    GC.@preserve allocated begin
+        trixi_set_allocator(alloc_fn, free_fn, pointer_from_objref(allocated))
+        data_ptr = trixi_allocate_data(allocator_handle, Int32(1), Int32(ndofs))
+        @test data_ptr == pointer(simstate.registry[1])
+        @test allocated[] == ndofs * sizeof(Float64)
+        @test all(iszero, simstate.registry[1])
+
+        # restore Julia's allocator, memory is released by the garbage collector
+        trixi_set_allocator(C_NULL, C_NULL, C_NULL)
+        trixi_allocate_data(allocator_handle, Int32(1), Int32(ndofs))
+        @test allocated[] == ndofs * sizeof(Float64)
+        GC.gc()
+    end
+    @test_throws ErrorException trixi_set_allocator(alloc_fn, C_NULL, C_NULL)
+
+    trixi_finalize_simulation(allocator_handle)
+end
+
+
+@testset verbose=true showtiming=true "NUMA placement" begin
+
+    numa_handle = trixi_initialize_simulation(libelixir)
+    trixi_place_numa(numa_handle)
+
+    local_fraction = zeros(1)
+    nnodes = trixi_get_numa_placement(numa_handle, Int32(0), Ptr{Cint}(C_NULL),
+                                      pointer(local_fraction))
+    if LibTrixi.numa_available()
+        @test nnodes >= 1
+        @test 0 <= local_fraction[1] <= 1
+        pages = zeros(Cint, nnodes)
+        trixi_get_numa_placement(numa_handle, nnodes, pointer(pages),
+                                 pointer(local_fraction))
+        @test sum(pages) > 0
+    else
+        @test nnodes == 0
+        @test isnan(local_fraction[1])
+    end
+
+    # contiguous partition of threaded loops
+    @test [LibTrixi.owner_thread(i, 10, 4) for i in 1:10] == [1, 1, 1, 2, 2, 2, 3, 3, 4, 4]
+    @test [LibTrixi.owner_thread(i, 2, 4) for i in 1:2] == [1, 2]
+
+    # all indices of a chunk are processed by the same thread of `Trixi.@threaded`
+    n = 10 * Threads.nthreads() + 1
+    thread_ids = zeros(Int, n)
+    LibTrixi.Trixi.@threaded for i in 1:n
+        thread_ids[i] = Threads.threadid()
+    end
+    owners = [LibTrixi.owner_thread(i, n, Threads.nthreads()) for i in 1:n]
+    @test all(allequal(thread_ids[owners .== chunk]) for chunk in unique(owners))
+
+    trixi_finalize_simulation(numa_handle)
+end
+
+
+@testset verbose=true showtiming=true "Deferred teardown" begin
+
+    trixi_set_deferred_teardown(Int32(1), Int32(2))
+    teardown = LibTrixi.deferred_teardown[]
+    @test teardown.batch_size == 2
+
+    # handles are released immediately, memory with every second finalization
+    handles = [trixi_initialize_simulation(libelixir) for _ in 1:3]
+    trixi_finalize_simulation(handles[1])
+    @test !haskey(LibTrixi.simstates, handles[1])
+    @test teardown.n_pending == 1
+    trixi_finalize_simulation(handles[2])
+    @test teardown.n_pending == 0
+    trixi_finalize_simulation(handles[3])
+    @test teardown.n_pending == 1
+
+    trixi_collect_garbage()
+    @test teardown.n_pending == 0
+
+    # pending teardowns are processed when Julia shuts down
+    trixi_finalize_simulation(trixi_initialize_simulation(libelixir))
+    @test teardown.n_pending == 1
+    @test LibTrixi.collect_garbage_at_exit in Base.atexit_hooks
+    LibTrixi.collect_garbage_at_exit()
+    @test teardown.n_pending == 0
+
+    trixi_set_deferred_teardown(Int32(0), Int32(0))
+    @test isnothing(LibTrixi.deferred_teardown[])
+end
+
+
+@testset verbose=true showtiming=true "Background compilation" begin
+
+    trace_directory = mktempdir()
+    trixi_set_background_compilation(Cstring(pointer(trace_directory)))
+    compilation = LibTrixi.background_compilation[]
+    trace = LibTrixi.trace_file(compilation, libelixir)
+
+    # the first setup records the signatures, later setups compile them in the background
+    simstate = trixi_initialize_simulation_jl(libelixir)
+    @test isfile(trace)
+    signatures = LibTrixi.load_trace(trace)
+    @test signatures == LibTrixi.trace_signatures(simstate)
+    trixi_finalize_simulation_jl(simstate)
+
+    compilation_handle = trixi_initialize_simulation(libelixir)
+    trixi_step(compilation_handle)
+    @test trixi_get_simulation_time(compilation_handle) > 0
+    trixi_finalize_simulation(compilation_handle)
+
+    # a broken trace is ignored
+    write(trace, "no trace")
+    @test isempty(LibTrixi.load_trace(trace))
+
+    trixi_set_background_compilation(Cstring(pointer("")))
+    @test isnothing(LibTrixi.background_compilation[])
+end
+
+
+@testset verbose=true showtiming=true "Shared memory publication" begin
+
+    shm_handle = trixi_initialize_simulation(libelixir)
+    simstate = LibTrixi.simstates[shm_handle]
+    variable_ids = Cint[1, 1]
+    trixi_set_shm_publication(shm_handle, Cstring(pointer("libtrixi_test")), Cint(2),
+                              Cint(2), pointer(variable_ids), Cint(2))
+    publisher = simstate.shm_publisher
+    path = "/dev/shm/libtrixi_test"
+    @test isfile(path)
+    @test reinterpret(UInt64, read(path, 8))[1] == LibTrixi.SHM_MAGIC
+
+    # the current solution is published right away, then every second step
+    @test publisher.n_published == 1
+    trixi_step(shm_handle)
+    @test publisher.n_published == 1
+    trixi_step(shm_handle)
+    @test publisher.n_published == 2
+
+    segment = publisher.segment
+    @test LibTrixi.shm_load(UInt64, pointer(segment) + LibTrixi.SHM_OFFSET_PUBLISHED) == 2
+    slot_ptr = pointer(segment) + LibTrixi.slot_offset(publisher) +
+               LibTrixi.slot_size(publisher, publisher.capacity)
+    @test LibTrixi.shm_load(UInt64, slot_ptr + LibTrixi.SHM_OFFSET_SEQUENCE) == 2
+    @test LibTrixi.shm_load(Int64, slot_ptr + LibTrixi.SHM_OFFSET_ITER) == 2
+
+    n_dofs = trixi_ndofs(shm_handle)
+    data = zeros(n_dofs)
+    trixi_load_primitive_vars(shm_handle, Cint(1), pointer(data))
+    published = unsafe_wrap(Array, Ptr{Float64}(slot_ptr + LibTrixi.SHM_SLOT_HEADER_SIZE),
+                            (publisher.capacity, 2))
+    @test published[1:n_dofs, 1] == data
+    @test published[1:n_dofs, 2] == data
+
+    # a segment that is too small is replaced by a larger one
+    LibTrixi.create_segment!(publisher, 1)
+    small_segment = publisher.segment
+    trixi_step(shm_handle)
+    trixi_step(shm_handle)
+    @test publisher.capacity >= n_dofs
+    @test LibTrixi.shm_load(UInt32, pointer(small_segment) + LibTrixi.SHM_OFFSET_STATUS) ==
+          LibTrixi.SHM_REPLACED
+
+    # an ordering outdated by a mesh change skips snapshots instead of failing the step
+    trixi_set_element_ordering_jl(simstate, 1:trixi_nelements(shm_handle))
+    simstate.mesh_epoch += 1
+    n_published = publisher.n_published
+    trixi_step(shm_handle)
+    trixi_step(shm_handle)
+    @test publisher.n_published == n_published
+    trixi_set_element_ordering_jl(simstate, 1:trixi_nelements(shm_handle))
+    trixi_step(shm_handle)
+    trixi_step(shm_handle)
+    @test publisher.n_published == n_published + 1
+    trixi_set_element_ordering_jl(simstate, nothing)
+
+    # finalizing closes the segment and removes its name
+    segment = publisher.segment
+    trixi_finalize_simulation(shm_handle)
+    @test LibTrixi.shm_load(UInt32, pointer(segment) + LibTrixi.SHM_OFFSET_STATUS) ==
+          LibTrixi.SHM_CLOSED
+    @test !isfile(path)
+
+    @test_throws ErrorException trixi_set_shm_publication_jl(simstate, "a/b", 1, [1])
+    @test_throws ErrorException trixi_set_shm_publication_jl(simstate, "test", 1, [2])
+end
+
+
+@testset verbose=true showtiming=true "Energy accounting" begin
+
+    energy_handle = trixi_initialize_simulation(libelixir)
+    simstate = LibTrixi.simstates[energy_handle]
+    @test_throws ErrorException trixi_get_energy_stats_jl(simstate)
+
+    trixi_set_energy_accounting(energy_handle, Int32(1))
+    trixi_step(energy_handle)
+    trixi_step(energy_handle)
+    stats = zeros(3)
+    available = trixi_get_energy_stats(energy_handle, pointer(stats, 1), pointer(stats, 2),
+                                       pointer(stats, 3))
+    energy, energy_per_step, energy_per_dof_update = stats
+    @test simstate.energy_meter.n_steps == 2
+    @test simstate.energy_meter.n_dof_updates == 2 * trixi_ndofsglobal(energy_handle)
+
+    # counters are often only readable by root, then no energy is reported
+    if available == 1
+        @test energy >= 0
+        @test energy_per_step ≈ energy / 2
+        @test energy_per_dof_update ≈ energy / (2 * trixi_ndofsglobal(energy_handle))
+    else
+        @test all(isnan, stats)
+    end
+
+    trixi_finalize_simulation(energy_handle)
+end
+
+
+@testset verbose=true showtiming=true "Logging" begin
+
+    # collect all JSON records in a vector
+    records = Tuple{Int, String}[]
+    trixi_set_log_sink_jl((level, line) -> push!(records, (level, line)),
+                          LibTrixi.LOG_DEBUG, 0, true)
+
+    # the file descriptor of stdout is not redirected
+    stdout_file = stat(RawFD(1))
+    log_handle = trixi_initialize_simulation(libelixir)
+    while trixi_is_finished(log_handle) == 0
+        trixi_step(log_handle)
+    end
+    @test (stat(RawFD(1)).device, stat(RawFD(1)).inode) ==
+          (stdout_file.device, stdout_file.inode)
+
+    # an alive callback reports its progress as record
+    simstate = LibTrixi.simstates[log_handle]
+    alive = LibTrixi.logged_alive_callback(LibTrixi.Trixi.AliveCallback(alive_interval = 1))
+    alive.initialize(alive, simstate.integrator.u, simstate.integrator.t,
+                     simstate.integrator)
+    alive.affect!(simstate.integrator)
+
+    trixi_log_message_jl(LibTrixi.LOG_WARNING, "message from host")
+    trixi_finalize_simulation(log_handle)
+    trixi_set_log_sink_jl(nothing)
+
+    has_source(source) = ((level, line),) -> occursin("\"source\":\"$source\"", line)
+    @test all(((level, line),) -> startswith(line, "{") && endswith(line, "}"), records)
+    analysis = filter(has_source("analysis"), records)
+    @test !isempty(analysis)
+    @test occursin("\"l2_error\":[", last(analysis)[2])
+    @test count(has_source("alive"), records) == 1
+    @test count(has_source("summary"), records) == 1
+    @test any(((level, line),) -> level == LibTrixi.LOG_WARNING &&
+                                  occursin("message from host", line), records)
+
+    # level filter and plain text
+    empty!(records)
+    trixi_set_log_sink_jl((level, line) -> push!(records, (level, line)),
+                          LibTrixi.LOG_WARNING, 0, false)
+    trixi_log_message_jl(LibTrixi.LOG_INFO, "dropped")
+    trixi_log_message_jl(LibTrixi.LOG_ERROR, "kept")
+    trixi_set_log_sink_jl(nothing)
+    @test records == [(LibTrixi.LOG_ERROR, "kept")]
+
+    @test_throws ErrorException trixi_set_log_sink_jl((level, line) -> nothing, 4)
 end
 
 
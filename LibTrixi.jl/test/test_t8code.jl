@@ -7,6 +7,8 @@ using Trixi
 
 libelixir = joinpath(dirname(pathof(LibTrixi)),
                      "../examples/libelixir_t8code2d_advection_amr.jl")
+libelixir_threaded = joinpath(dirname(pathof(LibTrixi)),
+                              "../examples/libelixir_t8code2d_advection_amr_threaded.jl")
 
 # initialize a simulation via API, receive a handle
 handle = trixi_initialize_simulation(libelixir)
@@ -23,6 +25,123 @@ simstate_jl = trixi_initialize_simulation_jl(libelixir)
 end
 
 
+
+@testset verbose=true showtiming=true "VTKHDF output" begin
+
+    piece = LibTrixi.VTKHDFPiece(simstate_jl)
+    nnodes = trixi_nnodes_jl(simstate_jl)
+    @test LibTrixi.ncells(piece) == trixi_nelements_jl(simstate_jl)
+    @test all(==(LibTrixi.VTK_LAGRANGE_QUADRILATERAL), piece.types)
+    @test piece.offsets == collect(0:(nnodes^2):(nnodes^2 * LibTrixi.ncells(piece)))
+
+    for cell in 1:LibTrixi.ncells(piece)
+        cell_points = piece.connectivity[(piece.offsets[cell] + 1):piece.offsets[cell + 1]]
+        @test sort(cell_points) == piece.offsets[cell]:(piece.offsets[cell + 1] - 1)
+
+        # the first four points are the vertices of the cell in counterclockwise order
+        x = piece.points[1:2, cell_points .+ 1]
+        vertices = x[:, 1:4]
+        is_corner(v) = all(d -> any(e -> isapprox(v[d], e, atol = 1e-12),
+                                    extrema(x[d, :])), 1:2)
+        @test all(is_corner, eachcol(vertices))
+        area = sum(vertices[1, i] * vertices[2, mod1(i + 1, 4)] -
+                   vertices[1, mod1(i + 1, 4)] * vertices[2, i] for i in 1:4) / 2
+        @test area > 0
+    end
+end
+
+
+@testset verbose=true showtiming=true "Setup phases" begin
+
+    # the mesh was refined to the initial condition with the threaded setup path
+    threaded_handle = trixi_initialize_simulation(libelixir_threaded)
+    @test trixi_nelements(threaded_handle) == trixi_nelements(handle)
+    for phase in ("libelixir", "init_simstate", "mesh", "initial_condition", "initial_amr",
+                  "total")
+        @test trixi_get_setup_time(threaded_handle, Cstring(pointer(phase))) >= 0
+    end
+    @test isnan(trixi_get_setup_time(threaded_handle, Cstring(pointer("unknown"))))
+    @test isnan(trixi_get_setup_time(handle, Cstring(pointer("initial_amr"))))
+    simstate_threaded = LibTrixi.simstates[threaded_handle]
+    @test trixi_get_setup_time_jl(simstate_threaded, "total") >=
+          trixi_get_setup_time_jl(simstate_threaded, "init_simstate")
+
+    # the threaded initial condition agrees with Trixi's
+    u_ode = copy(simstate_threaded.integrator.u)
+    LibTrixi.compute_initial_condition!(u_ode, simstate_threaded.semi, 0.0)
+    u_trixi = Trixi.compute_coefficients(0.0, simstate_threaded.semi)
+    @test u_ode ≈ u_trixi
+    @test simstate_threaded.integrator.u ≈ LibTrixi.simstates[handle].integrator.u
+    trixi_finalize_simulation(threaded_handle)
+
+    # setup phases are only recorded during the setup
+    @test LibTrixi.setup_phase(() -> 42, "unrecorded") == 42
+    @test isnothing(LibTrixi.setup_timings[])
+end
+
+
+@testset verbose=true showtiming=true "Initial state" begin
+
+    # the initial adaptation of the AMR callback would overwrite the host data
+    amr_handle = trixi_initialize_simulation(libelixir)
+    trixi_step(amr_handle)
+    simstate = LibTrixi.simstates[amr_handle]
+    data = copy(simstate.integrator.u)
+    @test_throws "adapt_initial_condition = false" trixi_set_initial_state_jl(simstate, 0.0,
+                                                                              0.2, data)
+    @test simstate.integrator.u == data
+    @test simstate.integrator.iter == 1
+
+    # reinitialization with the initial condition still adapts the mesh to it
+    mesh_epoch = simstate.mesh_epoch
+    trixi_reinitialize(amr_handle, 0.0, 0.2)
+    @test simstate.mesh_epoch == mesh_epoch + 1
+    trixi_finalize_simulation(amr_handle)
+
+    # without initial adaptation, the host data is used as it is
+    threaded_handle = trixi_initialize_simulation(libelixir_threaded)
+    trixi_step(threaded_handle)
+    simstate = LibTrixi.simstates[threaded_handle]
+    data = copy(simstate.integrator.u)
+    trixi_set_initial_state(threaded_handle, 0.0, 0.2, pointer(data))
+    @test simstate.integrator.u == data
+    @test simstate.integrator.t == 0.0
+    trixi_finalize_simulation(threaded_handle)
+end
+
+
+@testset verbose=true showtiming=true "AMR autotuning" begin
+
+    autotune_handle = trixi_initialize_simulation(libelixir)
+    @test trixi_get_amr_interval(autotune_handle) == 10
+
+    # start from the setup interval clamped to the bounds
+    trixi_set_amr_autotuning(autotune_handle, Int32(2), Int32(4), 0.1)
+    simstate = LibTrixi.simstates[autotune_handle]
+    tuner = LibTrixi.amr_autotuner(simstate)
+    @test tuner isa LibTrixi.AMRAutotuner
+    @test trixi_get_amr_interval(autotune_handle) == 4
+
+    mesh_epoch = simstate.mesh_epoch
+    for _ in 1:20
+        trixi_step(autotune_handle)
+    end
+    @test tuner.n_adaptations > 0
+    @test simstate.mesh_epoch == mesh_epoch + tuner.n_adaptations
+    @test 2 <= trixi_get_amr_interval(autotune_handle) <= 4
+
+    # restore the fixed interval
+    trixi_set_amr_autotuning(autotune_handle, Int32(0), Int32(0), 0.1)
+    @test isnothing(LibTrixi.amr_autotuner(LibTrixi.simstates[autotune_handle]))
+    @test trixi_get_amr_interval(autotune_handle) == 10
+    trixi_step(autotune_handle)
+
+    @test_throws ErrorException trixi_set_amr_autotuning_jl(simstate_jl, 4, 2)
+
+    trixi_finalize_simulation(autotune_handle)
+end
+
+
 # finalize simulation from julia
 trixi_finalize_simulation_jl(simstate_jl)
 
@@ -7,11 +7,11 @@ int main ( int argc, char *argv[] ) {
 
     if ( argc < 2 ) {
         fprintf(stderr, "ERROR: missing arguments: PROJECT_DIR LIBELIXIR_PATH\n\n");
-        fprintf(stderr, "usage: %s PROJECT_DIR LIBELIXIR_PATH\n", argv[0]);
+        fprintf(stderr, "usage: %s PROJECT_DIR LIBELIXIR_PATH [SHM_NAME]\n", argv[0]);
         return 2;
     } else if ( argc < 3 ) {
         fprintf(stderr, "ERROR: missing argument: LIBELIXIR_PATH\n\n");
-        fprintf(stderr, "usage: %s PROJECT_DIR LIBELIXIR_PATH\n", argv[0]);
+        fprintf(stderr, "usage: %s PROJECT_DIR LIBELIXIR_PATH [SHM_NAME]\n", argv[0]);
         return 2;
     }
 
@@ -28,6 +28,14 @@ int main ( int argc, char *argv[] ) {
     int nvariables = trixi_nvariables( handle );
     printf("\n*** Trixi controller ***   nvariables %d\n", nvariables);
 
+    // Optionally publish the first variable to shared memory every 10 steps, to be read
+    // by, e.g., trixi_shm_consumer
+    if ( argc > 3 ) {
+        int variable_ids[] = { 1 };
+        printf("\n*** Trixi controller ***   Publish to shared memory %s\n", argv[3]);
+        trixi_set_shm_publication( handle, argv[3], 10, 1, variable_ids, 2 );
+    }
+
     // Main loop
     int steps = 0;
     int nelements = 0;
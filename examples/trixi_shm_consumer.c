@@ -0,0 +1,70 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <trixi_shm.h>
+
+int main ( int argc, char *argv[] ) {
+
+    if ( argc < 2 ) {
+        fprintf(stderr, "ERROR: missing argument: SHM_NAME\n\n");
+        fprintf(stderr, "usage: %s SHM_NAME\n", argv[0]);
+        return 2;
+    }
+
+    // Wait for the simulation to create the segment
+    printf("\n*** Trixi consumer ***   Open shared memory %s\n", argv[1]);
+    trixi_shm_consumer * consumer = NULL;
+    for (int attempt = 0; consumer == NULL && attempt < 600; ++attempt) {
+        consumer = trixi_shm_open( argv[1] );
+        if ( consumer == NULL ) {
+            usleep(100000);
+        }
+    }
+    if ( consumer == NULL ) {
+        fprintf(stderr, "ERROR: cannot open %s: %s\n", argv[1], strerror(errno));
+        return 1;
+    }
+
+    printf("\n*** Trixi consumer ***   nvariables %d\n", trixi_shm_nvariables( consumer ));
+
+    // Main loop: report the first variable of every new snapshot, reading it in place
+    int64_t last_iter = -1;
+    while ( 1 ) {
+        int closed = trixi_shm_is_closed( consumer );
+
+        trixi_shm_snapshot snapshot;
+        int ret = trixi_shm_acquire( consumer, &snapshot );
+        if ( ret == TRIXI_SHM_OK && snapshot.iter != last_iter ) {
+            double min = snapshot.data[0];
+            double max = snapshot.data[0];
+            for (uint64_t i = 1; i < snapshot.ndofs; ++i) {
+                min = snapshot.data[i] < min ? snapshot.data[i] : min;
+                max = snapshot.data[i] > max ? snapshot.data[i] : max;
+            }
+
+            // Discard the values if the simulation has overwritten them meanwhile
+            if ( trixi_shm_validate( &snapshot ) ) {
+                printf("t = %f, step %ld, ndofs %lu: %f <= u <= %f\n", snapshot.time,
+                       (long) snapshot.iter, (unsigned long) snapshot.ndofs, min, max);
+                last_iter = snapshot.iter;
+            }
+        } else if ( ret == TRIXI_SHM_ERROR && errno != ENOENT && errno != EAGAIN ) {
+            fprintf(stderr, "ERROR: cannot read %s: %s\n", argv[1], strerror(errno));
+            break;
+        }
+
+        if ( closed ) {
+            break;
+        }
+        usleep(10000);
+    }
+
+    printf("\n*** Trixi consumer ***   Last snapshot after step %ld\n", (long) last_iter);
+
+    trixi_shm_close( consumer );
+
+    return 0;
+}
@@ -1,5 +1,6 @@
 #include "trixi.h"
 #include "auxiliary.h"
+#include "signals.h"
 
 /******************************************************************************************/
 /* Function pointers                                                                      */
@@ -34,6 +35,51 @@ enum {
     TRIXI_FTPR_EVAL_JULIA,
     TRIXI_FTPR_GET_T8CODE_FOREST,
     TRIXI_FPTR_GET_SIMULATION_TIME,
+    TRIXI_FPTR_SAVE_VTKHDF,
+    TRIXI_FPTR_CREATE_NESTING,
+    TRIXI_FPTR_NESTING_INTERPOLATE,
+    TRIXI_FPTR_NESTING_FEEDBACK,
+    TRIXI_FPTR_FINALIZE_NESTING,
+    TRIXI_FPTR_SCHEDULER_RUN,
+    TRIXI_FPTR_SET_POLYDEG,
+    TRIXI_FPTR_SET_STRAGGLER_WATCHDOG,
+    TRIXI_FPTR_FOREACH_ELEMENT_BLOCK,
+    TRIXI_FPTR_CREATE_ENSEMBLE,
+    TRIXI_FPTR_NMEMBERS,
+    TRIXI_FPTR_LOAD_MEMBER_PRIMITIVE_VARS,
+    TRIXI_FPTR_STORE_MEMBER_CONSERVATIVE_VARS,
+    TRIXI_FPTR_INITIALIZE_SIMULATION_F32,
+    TRIXI_FPTR_LOAD_PRIMITIVE_VARS_F32,
+    TRIXI_FPTR_LOAD_ELEMENT_AVERAGED_PRIMITIVE_VARS_F32,
+    TRIXI_FPTR_REGISTER_DATA_F32,
+    TRIXI_FPTR_SET_LOG_SINK,
+    TRIXI_FPTR_LOG_MESSAGE,
+    TRIXI_FPTR_SET_PREEMPTION,
+    TRIXI_FPTR_IS_PREEMPTED,
+    TRIXI_FPTR_DEFINE_OUTPUT_VARIABLE,
+    TRIXI_FPTR_DEFINE_OUTPUT_VARIABLE_CALLBACK,
+    TRIXI_FPTR_LOAD_VARIABLE,
+    TRIXI_FPTR_SET_ELEMENT_ORDERING,
+    TRIXI_FPTR_TRANSFER_SOLUTION,
+    TRIXI_FPTR_SET_OUTPUT_AGGREGATION,
+    TRIXI_FPTR_SET_ENERGY_ACCOUNTING,
+    TRIXI_FPTR_GET_ENERGY_STATS,
+    TRIXI_FPTR_SET_AMR_AUTOTUNING,
+    TRIXI_FPTR_GET_AMR_INTERVAL,
+    TRIXI_FPTR_SET_BUFFER_STORAGE,
+    TRIXI_FPTR_ALLOCATE_DATA,
+    TRIXI_FPTR_PLACE_NUMA,
+    TRIXI_FPTR_GET_NUMA_PLACEMENT,
+    TRIXI_FPTR_SET_ALLOCATOR,
+    TRIXI_FPTR_SET_DEFERRED_TEARDOWN,
+    TRIXI_FPTR_COLLECT_GARBAGE,
+    TRIXI_FPTR_REINITIALIZE,
+    TRIXI_FPTR_SET_INITIAL_STATE,
+    TRIXI_FPTR_SET_HEALTH_CHECK,
+    TRIXI_FPTR_GET_HEALTH_STATUS,
+    TRIXI_FPTR_SET_BACKGROUND_COMPILATION,
+    TRIXI_FPTR_GET_SETUP_TIME,
+    TRIXI_FPTR_SET_SHM_PUBLICATION,
 
     // The last one is for the array size
     TRIXI_NUM_FPTRS
@@ -71,7 +117,52 @@ static const char* trixi_function_pointer_names[] = {
     [TRIXI_FTPR_VERSION_JULIA_EXTENDED]               = "trixi_version_julia_extended_cfptr",
     [TRIXI_FTPR_EVAL_JULIA]                           = "trixi_eval_julia_cfptr",
     [TRIXI_FTPR_GET_T8CODE_FOREST]                    = "trixi_get_t8code_forest_cfptr",
-    [TRIXI_FPTR_GET_SIMULATION_TIME]                  = "trixi_get_simulation_time_cfptr"
+    [TRIXI_FPTR_GET_SIMULATION_TIME]                  = "trixi_get_simulation_time_cfptr",
+    [TRIXI_FPTR_SAVE_VTKHDF]                          = "trixi_save_vtkhdf_cfptr",
+    [TRIXI_FPTR_CREATE_NESTING]                       = "trixi_create_nesting_cfptr",
+    [TRIXI_FPTR_NESTING_INTERPOLATE]                  = "trixi_nesting_interpolate_cfptr",
+    [TRIXI_FPTR_NESTING_FEEDBACK]                     = "trixi_nesting_feedback_cfptr",
+    [TRIXI_FPTR_FINALIZE_NESTING]                     = "trixi_finalize_nesting_cfptr",
+    [TRIXI_FPTR_SCHEDULER_RUN]                        = "trixi_scheduler_run_cfptr",
+    [TRIXI_FPTR_SET_POLYDEG]                          = "trixi_set_polydeg_cfptr",
+    [TRIXI_FPTR_SET_STRAGGLER_WATCHDOG]               = "trixi_set_straggler_watchdog_cfptr",
+    [TRIXI_FPTR_FOREACH_ELEMENT_BLOCK]                = "trixi_foreach_element_block_cfptr",
+    [TRIXI_FPTR_CREATE_ENSEMBLE]                      = "trixi_create_ensemble_cfptr",
+    [TRIXI_FPTR_NMEMBERS]                             = "trixi_nmembers_cfptr",
+    [TRIXI_FPTR_LOAD_MEMBER_PRIMITIVE_VARS]           = "trixi_load_member_primitive_vars_cfptr",
+    [TRIXI_FPTR_STORE_MEMBER_CONSERVATIVE_VARS]       = "trixi_store_member_conservative_vars_cfptr",
+    [TRIXI_FPTR_INITIALIZE_SIMULATION_F32]            = "trixi_initialize_simulation_f32_cfptr",
+    [TRIXI_FPTR_LOAD_PRIMITIVE_VARS_F32]              = "trixi_load_primitive_vars_f32_cfptr",
+    [TRIXI_FPTR_LOAD_ELEMENT_AVERAGED_PRIMITIVE_VARS_F32] = "trixi_load_element_averaged_primitive_vars_f32_cfptr",
+    [TRIXI_FPTR_REGISTER_DATA_F32]                    = "trixi_register_data_f32_cfptr",
+    [TRIXI_FPTR_SET_LOG_SINK]                         = "trixi_set_log_sink_cfptr",
+    [TRIXI_FPTR_LOG_MESSAGE]                          = "trixi_log_message_cfptr",
+    [TRIXI_FPTR_SET_PREEMPTION]                       = "trixi_set_preemption_cfptr",
+    [TRIXI_FPTR_IS_PREEMPTED]                         = "trixi_is_preempted_cfptr",
+    [TRIXI_FPTR_DEFINE_OUTPUT_VARIABLE]               = "trixi_define_output_variable_cfptr",
+    [TRIXI_FPTR_DEFINE_OUTPUT_VARIABLE_CALLBACK]      = "trixi_define_output_variable_callback_cfptr",
+    [TRIXI_FPTR_LOAD_VARIABLE]                        = "trixi_load_variable_cfptr",
+    [TRIXI_FPTR_SET_ELEMENT_ORDERING]                 = "trixi_set_element_ordering_cfptr",
+    [TRIXI_FPTR_TRANSFER_SOLUTION]                    = "trixi_transfer_solution_cfptr",
+    [TRIXI_FPTR_SET_OUTPUT_AGGREGATION]               = "trixi_set_output_aggregation_cfptr",
+    [TRIXI_FPTR_SET_ENERGY_ACCOUNTING]                = "trixi_set_energy_accounting_cfptr",
+    [TRIXI_FPTR_GET_ENERGY_STATS]                     = "trixi_get_energy_stats_cfptr",
+    [TRIXI_FPTR_SET_AMR_AUTOTUNING]                   = "trixi_set_amr_autotuning_cfptr",
+    [TRIXI_FPTR_GET_AMR_INTERVAL]                     = "trixi_get_amr_interval_cfptr",
+    [TRIXI_FPTR_SET_BUFFER_STORAGE]                   = "trixi_set_buffer_storage_cfptr",
+    [TRIXI_FPTR_ALLOCATE_DATA]                        = "trixi_allocate_data_cfptr",
+    [TRIXI_FPTR_PLACE_NUMA]                           = "trixi_place_numa_cfptr",
+    [TRIXI_FPTR_GET_NUMA_PLACEMENT]                   = "trixi_get_numa_placement_cfptr",
+    [TRIXI_FPTR_SET_ALLOCATOR]                        = "trixi_set_allocator_cfptr",
+    [TRIXI_FPTR_SET_DEFERRED_TEARDOWN]                = "trixi_set_deferred_teardown_cfptr",
+    [TRIXI_FPTR_COLLECT_GARBAGE]                      = "trixi_collect_garbage_cfptr",
+    [TRIXI_FPTR_REINITIALIZE]                         = "trixi_reinitialize_cfptr",
+    [TRIXI_FPTR_SET_INITIAL_STATE]                    = "trixi_set_initial_state_cfptr",
+    [TRIXI_FPTR_SET_HEALTH_CHECK]                     = "trixi_set_health_check_cfptr",
+    [TRIXI_FPTR_GET_HEALTH_STATUS]                    = "trixi_get_health_status_cfptr",
+    [TRIXI_FPTR_SET_BACKGROUND_COMPILATION]           = "trixi_set_background_compilation_cfptr",
+    [TRIXI_FPTR_GET_SETUP_TIME]                       = "trixi_get_setup_time_cfptr",
+    [TRIXI_FPTR_SET_SHM_PUBLICATION]                  = "trixi_set_shm_publication_cfptr"
 };
 
 // Track initialization/finalization status to prevent unhelpful errors
@@ -113,6 +204,9 @@ void trixi_initialize(const char * project_directory, const char * depot_path) {
     // Update JULIA_DEPOT_PATH environment variable before initializing Julia
     update_depot_path(project_directory, depot_path);
 
+    // Start waiting for preemption signals ahead of Julia's signal listener
+    start_signal_thread();
+
     // Init Julia
     jl_init();
 
@@ -138,10 +232,16 @@ void trixi_initialize(const char * project_directory, const char * depot_path) {
     store_function_pointers(TRIXI_NUM_FPTRS, trixi_function_pointer_names,
                             trixi_function_pointers);
 
-    // Show version info
+    // Show depot path and version info through the log sink of the library
     if (show_debug_output()) {
-        printf("\nlibtrixi %s\n\n", trixi_version_library());
-        printf("Loaded Julia packages:\n%s\n\n", trixi_version_julia());
+        char message[1024];
+        snprintf(message, 1024, "JULIA_DEPOT_PATH set to \"%s\"",
+                 getenv("JULIA_DEPOT_PATH"));
+        trixi_log_message(TRIXI_LOG_DEBUG, message);
+        snprintf(message, 1024, "libtrixi %s", trixi_version_library());
+        trixi_log_message(TRIXI_LOG_DEBUG, message);
+        trixi_log_message(TRIXI_LOG_DEBUG, "Loaded Julia packages:");
+        trixi_log_message(TRIXI_LOG_DEBUG, trixi_version_julia());
     }
 
     // Mark as initialized
@@ -168,7 +268,7 @@ void trixi_finalize() {
     }
 
     if (show_debug_output()) {
-        printf("libtrixi: finalize\n");
+        trixi_log_message(TRIXI_LOG_DEBUG, "libtrixi: finalize");
     }
 
     // Reset function pointers
@@ -361,6 +461,70 @@ int trixi_initialize_simulation(const char * libelixir) {
 }
 
 
+/**
+ * @anchor trixi_initialize_simulation_f32_api_c
+ *
+ * @brief Set up Trixi simulation in single precision
+ *
+ * Set up a Trixi simulation like @ref trixi_initialize_simulation_api_c
+ * "trixi_initialize_simulation", but store the solution in single precision. If
+ * `geometry_f64` is nonzero, the DG basis and the geometric data derived from it are kept in
+ * double precision (mixed precision), otherwise they are converted to single precision as
+ * well. The simulation time is always kept in double precision.
+ *
+ * The simulation is set up directly in the requested precision if `init_simstate` of the
+ * libelixir accepts the keyword arguments `RealT` (basis and geometry) and `uEltype`
+ * (solution). Otherwise, it is set up in double precision first and converted afterwards,
+ * which temporarily needs the memory of both setups.
+ *
+ * Use the `_f32` variants of the data access functions to exchange single precision data.
+ *
+ * @param[in]  libelixir     Path to libelexir file.
+ * @param[in]  geometry_f64  keep geometry in double precision if nonzero
+ *
+ * @return handle (integer) to Trixi simulation instance
+ */
+int trixi_initialize_simulation_f32(const char * libelixir, int geometry_f64) {
+
+    // Get function pointer
+    int (*initialize_simulation_f32)(const char *, int) =
+        trixi_function_pointers[TRIXI_FPTR_INITIALIZE_SIMULATION_F32];
+
+    // Call function
+    return initialize_simulation_f32(libelixir, geometry_f64);
+}
+
+
+/**
+ * @anchor trixi_get_setup_time_api_c
+ *
+ * @brief Return the wall time of an initialization phase
+ *
+ * The phases recorded during @ref trixi_initialize_simulation_api_c
+ * "trixi_initialize_simulation" are `libelixir` (loading the libelixir), `init_simstate`
+ * (running its setup function), `background_compilation` (see
+ * @ref trixi_set_background_compilation_api_c "trixi_set_background_compilation"), and
+ * `total`. Libelixirs that set up the initial condition and the initial AMR with
+ * `semidiscretize_threaded` add `initial_condition` and `initial_amr`, and may time further
+ * phases with `setup_phase`. The phases listed here and `mesh` are also logged at the end
+ * of the setup.
+ *
+ * @param[in]  handle  simulation handle
+ * @param[in]  phase   name of the phase
+ *
+ * @return wall time of the phase in seconds on this rank, NaN if it was not recorded
+ */
+double trixi_get_setup_time(int handle, const char * phase) {
+
+    // Get function pointer
+    double (*get_setup_time)(int, const char *) =
+        trixi_function_pointers[TRIXI_FPTR_GET_SETUP_TIME];
+
+    // Call function
+    return get_setup_time(handle, phase);
+}
+
+
 /**
  * @anchor trixi_is_finished_api_c
  *
@@ -383,401 +547,1631 @@ int trixi_is_finished(int handle) {
 
 
 /**
- * @anchor trixi_step_api_c
+ * @anchor trixi_is_preempted_api_c
  *
- * @brief Perform next simulation step
+ * @brief Check if simulation was stopped by preemption
  *
- * Let the simulation identified by handle advance by one step.
+ * Checks if the simulation identified by handle was stopped before its final time and a
+ * checkpoint was written, see @ref trixi_set_preemption_api_c "trixi_set_preemption".
  *
  * @param[in]  handle  simulation handle
+ *
+ * @return 1 if preempted, 0 if not
  */
-void trixi_step(int handle) {
+int trixi_is_preempted(int handle) {
 
     // Get function pointer
-    int (*step)(int) = trixi_function_pointers[TRIXI_FTPR_STEP];
+    int (*is_preempted)(int) = trixi_function_pointers[TRIXI_FPTR_IS_PREEMPTED];
 
     // Call function
-    step( handle );
+    return is_preempted( handle );
 }
 
 
 /**
- * @anchor trixi_finalize_simulation_api_c
+ * @anchor trixi_step_api_c
  *
- * @brief Finalize simulation
+ * @brief Perform next simulation step
  *
- * Finalize the simulation identified by handle. This will also release the handle.
+ * Let the simulation identified by handle advance by one step.
  *
  * @param[in]  handle  simulation handle
  */
-void trixi_finalize_simulation(int handle) {
+void trixi_step(int handle) {
 
     // Get function pointer
-    void (*finalize_simulation)(int) =
-        trixi_function_pointers[TRIXI_FTPR_FINALIZE_SIMULATION];
+    int (*step)(int) = trixi_function_pointers[TRIXI_FTPR_STEP];
 
     // Call function
-    finalize_simulation(handle);
+    step( handle );
 }
 
 
+/**
+ * @anchor trixi_scheduler_run_api_c
+ *
+ * @brief Advance several simulations with individual time steps to common sync times
+ *
+ * All simulations given in `handles` are advanced until they are finished. Each simulation
+ * uses its own time step, but all simulations are synchronized every `sync_interval` units
+ * of simulation time, starting from the earliest current time. At every synchronization
+ * time, `coupling(time, userdata)` is called (unless `coupling` is a null pointer), e.g.,
+ * to exchange data between the simulations.
+ *
+ * Between synchronization times, the simulations are independent of each other. If Julia
+ * runs with multiple threads and MPI is not used, they are advanced concurrently. Output
+ * through the sink of @ref trixi_set_log_sink_api_c "trixi_set_log_sink" is serialized in
+ * this case, and `coupling` is always called from the calling thread.
+ *
+ * @param[in]  nhandles       number of simulation handles
+ * @param[in]  handles        simulation handles
+ * @param[in]  sync_interval  time between synchronization points
+ * @param[in]  coupling       function called at each synchronization point (may be null)
+ * @param[in]  userdata       pointer passed through to `coupling`
+ */
+void trixi_scheduler_run(int nhandles, const int * handles, double sync_interval,
+                         trixi_sync_callback_t coupling, void * userdata) {
+
+    // Get function pointer
+    void (*scheduler_run)(int, const int *, double, trixi_sync_callback_t, void *) =
+        trixi_function_pointers[TRIXI_FPTR_SCHEDULER_RUN];
+
+    // Call function
+    scheduler_run(nhandles, handles, sync_interval, coupling, userdata);
+}
 
-/******************************************************************************************/
-/* Simulation data                                                                        */
-/******************************************************************************************/
 
 /**
- * @anchor trixi_calculate_dt_api_c
+ * @anchor trixi_set_polydeg_api_c
  *
- * @brief Get time step length
+ * @brief Change polynomial degree of the DG solver
  *
- * Get the current time step length of the simulation identified by handle.
+ * Basis, solver cache, and time integrator are rebuilt for the new degree, and the
+ * solution is projected to the new basis. Increasing the degree is exact, decreasing it
+ * is an L2 projection. All registered data vectors are removed from the registry, since
+ * they may depend on the old nodes: host memory is no longer referenced, and pointers
+ * returned by @ref trixi_allocate_data_api_c "trixi_allocate_data" become invalid. Data has
+ * to be registered or allocated again at the same indices, before
+ * @ref trixi_step_api_c "trixi_step" can be called again.
  *
- * @param[in]  handle  simulation handle
+ * The handle remains valid, but all sizes depending on the number of nodes change. With
+ * MPI, this function has to be called collectively by all ranks.
  *
- * @return Time step length
+ * @param[in]  handle   simulation handle
+ * @param[in]  polydeg  new polynomial degree
  */
-double trixi_calculate_dt(int handle) {
+void trixi_set_polydeg(int handle, int polydeg) {
 
     // Get function pointer
-    double (*calculate_dt)(int) = trixi_function_pointers[TRIXI_FTPR_CALCULATE_DT];;
+    void (*set_polydeg)(int, int) = trixi_function_pointers[TRIXI_FPTR_SET_POLYDEG];
 
     // Call function
-    return calculate_dt( handle );
+    set_polydeg(handle, polydeg);
 }
 
 
 /**
- * @anchor trixi_ndims_api_c
+ * @anchor trixi_set_amr_autotuning_api_c
  *
- * @brief Return number of spatial dimensions
+ * @brief Tune the AMR interval online
  *
- * @param[in]  handle  simulation handle
+ * The interval of the AMR callback is adjusted within the given bounds based on the
+ * measured cost of regular steps and adaptations: It is doubled if an adaptation did not
+ * change the mesh, increased by one if the adaptation time amortized over the interval
+ * exceeds target_overhead times the regular step time, and decreased by one otherwise.
+ * Every change is reported as a log message. If min_interval is not positive, the fixed
+ * interval of the simulation setup is restored.
+ *
+ * The time integrator is recreated, but the handle remains valid. With MPI, this function
+ * has to be called collectively by all ranks.
+ *
+ * @param[in]  handle           simulation handle
+ * @param[in]  min_interval     smallest AMR interval, disables autotuning if not positive
+ * @param[in]  max_interval     largest AMR interval
+ * @param[in]  target_overhead  acceptable adaptation cost relative to the step cost
  */
-int trixi_ndims(int handle) {
+void trixi_set_amr_autotuning(int handle, int min_interval, int max_interval,
+                              double target_overhead) {
 
     // Get function pointer
-    int (*ndims)(int) = trixi_function_pointers[TRIXI_FTPR_NDIMS];
+    void (*set_amr_autotuning)(int, int, int, double) =
+        trixi_function_pointers[TRIXI_FPTR_SET_AMR_AUTOTUNING];
 
     // Call function
-    return ndims(handle);
+    set_amr_autotuning(handle, min_interval, max_interval, target_overhead);
 }
 
 
 /**
- * @anchor trixi_nelements_api_c
- *
- * @brief Return number of local elements.
+ * @anchor trixi_get_amr_interval_api_c
  *
- * These usually differ from the global count when doing parallel computations.
+ * @brief Return current AMR interval
  *
  * @param[in]  handle  simulation handle
  *
- * @see trixi_nelementsglobal_api_c
+ * @return Number of steps between two adaptations
  */
-int trixi_nelements(int handle) {
+int trixi_get_amr_interval(int handle) {
 
     // Get function pointer
-    int (*nelements)(int) = trixi_function_pointers[TRIXI_FPTR_NELEMENTS];
+    int (*get_amr_interval)(int) = trixi_function_pointers[TRIXI_FPTR_GET_AMR_INTERVAL];
 
     // Call function
-    return nelements(handle);
+    return get_amr_interval(handle);
 }
 
 
 /**
- * @anchor trixi_nelementsglobal_api_c
- *
- * @brief Return global number of elements.
- *
- * These usually differ from the local count when doing parallel computations.
- *
- * @param[in]  handle  simulation handle
- *
- * @see trixi_nelements_api_c
+ * @anchor trixi_set_straggler_watchdog_api_c
+ *
+ * @brief Enable or disable detection of slow ranks
+ *
+ * During each step, the time spent on computation (i.e., excluding the time waiting for
+ * MPI communication) is measured on every rank. Every `interval` steps, the compute times
+ * are gathered on the root rank with a non-blocking gather, which is evaluated after the
+ * first step in which it has completed, at the latest at the next check or when the
+ * watchdog is disabled or the simulation is finalized. Ranks whose compute time
+ * exceeds `threshold` times the median compute time are reported on the root rank by
+ * calling `report(rank, compute_time, median_time, userdata)`. If `report` is a null
+ * pointer, a line is printed instead. A non-positive `interval` disables the watchdog.
+ *
+ * With MPI, this function has to be called collectively by all ranks.
+ *
+ * @param[in]  handle     simulation handle
+ * @param[in]  interval   number of steps between checks (disable if not positive)
+ * @param[in]  threshold  factor of the median compute time above which ranks are reported
+ * @param[in]  report     function called for each slow rank (may be null)
+ * @param[in]  userdata   pointer passed through to `report`
  */
-int trixi_nelementsglobal(int handle) {
+void trixi_set_straggler_watchdog(int handle, int interval, double threshold,
+                                  trixi_straggler_callback_t report, void * userdata) {
 
     // Get function pointer
-    int (*nelementsglobal)(int) = trixi_function_pointers[TRIXI_FPTR_NELEMENTS_GLOBAL];
+    void (*set_straggler_watchdog)(int, int, double, trixi_straggler_callback_t, void *) =
+        trixi_function_pointers[TRIXI_FPTR_SET_STRAGGLER_WATCHDOG];
 
     // Call function
-    return nelementsglobal(handle);
+    set_straggler_watchdog(handle, interval, threshold, report, userdata);
 }
 
 
 /**
- * @anchor trixi_ndofs_api_c
- *
- * @brief Return number of local degrees of freedom.
+ * @anchor trixi_set_preemption_api_c
+ *
+ * @brief Stop the simulation with a checkpoint before it is preempted
+ *
+ * After each step, all ranks agree on whether the simulation has to be stopped. This is the
+ * case if the next step would exceed `walltime_budget` seconds since this call (estimated
+ * from the longest step so far), or if `handle_signals` is nonzero and SIGTERM or SIGUSR1
+ * was received by any rank. Then, a restart file and the mesh are written to
+ * `checkpoint_directory`, and the simulation is reported as finished by
+ * @ref trixi_is_finished_api_c "trixi_is_finished" and as preempted by
+ * @ref trixi_is_preempted_api_c "trixi_is_preempted". A non-positive budget is ignored.
+ *
+ * While at least one simulation handles signals, SIGTERM and SIGUSR1 are received by a
+ * thread that libtrixi starts in @ref trixi_initialize_api_c "trixi_initialize", i.e., the
+ * process is neither terminated nor interrupted. A signal applies to all simulations that
+ * handle signals and is cleared by the preemption it causes. Once the last of them is
+ * finalized, the signals are handled by Julia again. Use, e.g., `sbatch --signal=USR1@120`
+ * to receive a signal ahead of the end of a job. With MPI, this function has to be called
+ * collectively by all ranks.
+ *
+ * @param[in]  handle                simulation handle
+ * @param[in]  walltime_budget       available wall time in seconds (ignored if not positive)
+ * @param[in]  handle_signals        stop on SIGTERM or SIGUSR1 if nonzero
+ * @param[in]  checkpoint_directory  directory for restart and mesh files
+ */
+void trixi_set_preemption(int handle, double walltime_budget, int handle_signals,
+                          const char * checkpoint_directory) {
+
+    // Get function pointer
+    void (*set_preemption)(int, double, int, const char *) =
+        trixi_function_pointers[TRIXI_FPTR_SET_PREEMPTION];
+
+    // Call function
+    set_preemption(handle, walltime_budget, handle_signals, checkpoint_directory);
+}
+
+
+/**
+ * @anchor trixi_set_health_check_api_c
+ *
+ * @brief Check the solution for non-finite or non-physical values
+ *
+ * Every `interval` steps, the solution is checked for non-finite values and, if the
+ * equations define them, for non-positive density and pressure. The first `nreport`
+ * offending elements of each rank are logged with their coordinates. Depending on `action`,
+ * the simulation then continues (@ref TRIXI_HEALTH_REPORT), or is considered finished
+ * either with the offending solution (@ref TRIXI_HEALTH_STOP) or with the solution before
+ * the offending step (@ref TRIXI_HEALTH_ROLLBACK), which requires a copy of the solution
+ * before each checked step. The status is returned by
+ * @ref trixi_get_health_status_api_c "trixi_get_health_status". A non-positive interval
+ * disables the check.
+ *
+ * With MPI, this function has to be called collectively by all ranks.
+ *
+ * @param[in]  handle    simulation handle
+ * @param[in]  interval  number of steps between two checks (disabled if not positive)
+ * @param[in]  action    action on failure, one of `TRIXI_HEALTH_{REPORT,STOP,ROLLBACK}`
+ * @param[in]  nreport   maximum number of offending elements reported per rank, positive
+ */
+void trixi_set_health_check(int handle, int interval, int action, int nreport) {
+
+    // Get function pointer
+    void (*set_health_check)(int, int, int, int) =
+        trixi_function_pointers[TRIXI_FPTR_SET_HEALTH_CHECK];
+
+    // Call function
+    set_health_check(handle, interval, action, nreport);
+}
+
+
+/**
+ * @anchor trixi_get_health_status_api_c
  *
- * These usually differ from the global count when doing parallel computations.
+ * @brief Return the status found by the first failed health check
  *
  * @param[in]  handle  simulation handle
  *
- * @see trixi_ndofsglobal_api_c
+ * @return One of `TRIXI_HEALTH_{OK,PRESSURE,DENSITY,NONFINITE}`, the most severe status of
+ *         all ranks
  */
-int trixi_ndofs(int handle) {
+int trixi_get_health_status(int handle) {
 
     // Get function pointer
-    int (*ndofs)(int) = trixi_function_pointers[TRIXI_FPTR_NDOFS];
+    int (*get_health_status)(int) = trixi_function_pointers[TRIXI_FPTR_GET_HEALTH_STATUS];
 
     // Call function
-    return ndofs(handle);
+    return get_health_status(handle);
 }
 
 
 /**
- * @anchor trixi_ndofsglobal_api_c
+ * @anchor trixi_set_energy_accounting_api_c
  *
- * @brief Return global number of degrees of freedom.
+ * @brief Enable or disable energy accounting for each step
  *
- * These usually differ from the local count when doing parallel computations.
+ * If enabled, the energy consumed during each step is measured with the RAPL counters of
+ * the Linux powercap interface (`/sys/class/powercap`). The counters cover whole CPU
+ * packages, so they are read by one rank per compute node. If they are not readable on all
+ * nodes, no energy is recorded and
+ * @ref trixi_get_energy_stats_api_c "trixi_get_energy_stats" reports them as unavailable.
+ * Enabling the accounting again resets the statistics. The statistics are also reported in
+ * the summary output when the simulation is finalized.
  *
- * @param[in]  handle  simulation handle
+ * With MPI, this function has to be called collectively by all ranks.
  *
- * @see trixi_ndofs_api_c
+ * @param[in]  handle   simulation handle
+ * @param[in]  enabled  measure energy if nonzero
  */
-int trixi_ndofsglobal(int handle) {
+void trixi_set_energy_accounting(int handle, int enabled) {
 
     // Get function pointer
-    int (*ndofsglobal)(int) = trixi_function_pointers[TRIXI_FPTR_NDOFS_GLOBAL];
+    void (*set_energy_accounting)(int, int) =
+        trixi_function_pointers[TRIXI_FPTR_SET_ENERGY_ACCOUNTING];
 
     // Call function
-    return ndofsglobal(handle);
+    set_energy_accounting(handle, enabled);
 }
 
 
 /**
- * @anchor trixi_ndofselement_api_c
+ * @anchor trixi_get_energy_stats_api_c
  *
- * @brief Return number of degrees of freedom per element.
+ * @brief Return energy consumption since energy accounting was enabled
  *
- * @param[in]  handle  simulation handle
+ * The energy in joules consumed on all nodes during all steps, the energy per step, and the
+ * energy per update of a single degree of freedom (based on the global number of degrees of
+ * freedom) are stored in `energy`, `energy_per_step`, and `energy_per_dof_update`. If no
+ * energy counters are available, all values are NaN.
+ *
+ * With MPI, this function has to be called collectively by all ranks.
+ *
+ * @param[in]  handle                 simulation handle
+ * @param[out] energy                 total energy in joules
+ * @param[out] energy_per_step        energy per step in joules
+ * @param[out] energy_per_dof_update  energy per degree of freedom and step in joules
+ *
+ * @return 1 if energy counters are available, 0 if not
  */
-int trixi_ndofselement(int handle) {
+int trixi_get_energy_stats(int handle, double * energy, double * energy_per_step,
+                           double * energy_per_dof_update) {
 
     // Get function pointer
-    int (*ndofselement)(int) = trixi_function_pointers[TRIXI_FPTR_NDOFS_ELEMENT];
+    int (*get_energy_stats)(int, double *, double *, double *) =
+        trixi_function_pointers[TRIXI_FPTR_GET_ENERGY_STATS];
 
     // Call function
-    return ndofselement(handle);
+    return get_energy_stats(handle, energy, energy_per_step, energy_per_dof_update);
 }
 
 
 /**
- * @anchor trixi_nvariables_api_c
+ * @anchor trixi_place_numa_api_c
  *
- * @brief Return number of (conservative) variables
+ * @brief Place simulation data on the NUMA nodes of the threads processing it
+ *
+ * The memory pages of the solution, the stage vectors of the time integrator, and the
+ * solver cache are moved with the same partition of elements over threads as used by the
+ * threaded loops, which is equivalent to initializing them in parallel (first touch). This
+ * should be called right after initialization, and again if arrays are reallocated, e.g.,
+ * after AMR. Threads have to be pinned to cores for a lasting effect. On systems without
+ * NUMA support, nothing is done.
  *
  * @param[in]  handle  simulation handle
  */
-int trixi_nvariables(int handle) {
+void trixi_place_numa(int handle) {
 
     // Get function pointer
-    int (*nvariables)(int) = trixi_function_pointers[TRIXI_FTPR_NVARIABLES];
+    void (*place_numa)(int) = trixi_function_pointers[TRIXI_FPTR_PLACE_NUMA];
 
     // Call function
-    return nvariables(handle);
+    place_numa(handle);
 }
 
 
 /**
- * @anchor trixi_nnodes_api_c
+ * @anchor trixi_get_numa_placement_api_c
  *
- * @brief Return number of quadrature nodes per dimension.
+ * @brief Return NUMA placement statistics of simulation data
  *
- * @param[in]  handle  simulation handle
+ * For the data considered by @ref trixi_place_numa_api_c "trixi_place_numa" on this rank,
+ * the number of memory pages on each NUMA node and the fraction of pages residing on the
+ * node of the thread processing them are determined. Pages not touched yet are not counted.
+ *
+ * @param[in]  handle          simulation handle
+ * @param[in]  nnodes          size of pages, may be 0 to query the number of nodes
+ * @param[out] pages           number of pages on each of the first nnodes NUMA nodes
+ * @param[out] local_fraction  fraction of pages on the node of the processing thread
+ *                             (NaN without NUMA support)
+ *
+ * @return Number of NUMA nodes holding pages (0 without NUMA support)
  */
-int trixi_nnodes(int handle) {
+int trixi_get_numa_placement(int handle, int nnodes, int * pages, double * local_fraction) {
 
     // Get function pointer
-    int (*nnodes)(int) = trixi_function_pointers[TRIXI_FPTR_NNODES];
+    int (*get_numa_placement)(int, int, int *, double *) =
+        trixi_function_pointers[TRIXI_FPTR_GET_NUMA_PLACEMENT];
 
     // Call function
-    return nnodes(handle);
+    return get_numa_placement(handle, nnodes, pages, local_fraction);
 }
 
 
 /**
- * @anchor trixi_load_node_reference_coordinates_api_c
+ * @anchor trixi_set_deferred_teardown_api_c
  *
- * @brief Get reference coordinates of 1D quadrature nodes.
+ * @brief Defer teardown of finalized simulations
  *
- * The reference coordinates in [-1,1] of the quadrature nodes in the current DG scheme are
- * stored in the provided array `node_coords`. The given array has to be of correct size,
- * i.e. `nnodes`, and memory has to be allocated beforehand.
+ * With deferred teardown, @ref trixi_finalize_simulation_api_c "trixi_finalize_simulation"
+ * still releases the handle immediately, but the finalization of p4est meshes and the full
+ * garbage collection are postponed until batch_size simulations have been finalized or
+ * @ref trixi_collect_garbage_api_c "trixi_collect_garbage" is called. This avoids a full
+ * garbage collection per simulation when many short simulations are run. Pending teardowns
+ * are processed when the mode is changed and by @ref trixi_finalize_api_c "trixi_finalize".
  *
- * @param[in]   handle       simulation handle
- * @param[out]  node_coords  node reference coordinates
+ * With MPI, this function has to be called collectively by all ranks.
+ *
+ * @param[in]  enabled     defer teardown if nonzero, free memory at each finalization if 0
+ * @param[in]  batch_size  number of finalized simulations that are released together,
+ *                         only on request if not positive
  */
-void trixi_load_node_reference_coordinates(int handle, double* node_coords) {
+void trixi_set_deferred_teardown(int enabled, int batch_size) {
 
     // Get function pointer
-    void (*load_node_reference_coordinates)(int, double *) = trixi_function_pointers[TRIXI_FPTR_LOAD_NODE_REFERENCE_COORDINATES];
+    void (*set_deferred_teardown)(int, int) =
+        trixi_function_pointers[TRIXI_FPTR_SET_DEFERRED_TEARDOWN];
 
     // Call function
-    return load_node_reference_coordinates(handle, node_coords);
+    set_deferred_teardown(enabled, batch_size);
 }
 
 
 /**
- * @anchor trixi_load_node_weights_api_c
- *
- * @brief Get weights of 1D quadrature nodes.
+ * @anchor trixi_collect_garbage_api_c
  *
- * The weights of the quadrature nodes in the current DG scheme are stored in the provided
- * array `node_weights`. The given array has to be of correct size, i.e. `nnodes`, and
- * memory has to be allocated beforehand.
+ * @brief Free memory of finalized simulations
  *
- * @param[in]   handle        simulation handle
- * @param[out]  node_weights  node weights
+ * Process all pending teardowns of simulations finalized with deferred teardown and run a
+ * full garbage collection. With MPI, this function has to be called collectively by all
+ * ranks.
  */
-void trixi_load_node_weights(int handle, double* node_weights) {
+void trixi_collect_garbage() {
 
     // Get function pointer
-    void (*load_node_weights)(int, double *) = trixi_function_pointers[TRIXI_FPTR_LOAD_NODE_WEIGHTS];
+    void (*collect_garbage)() = trixi_function_pointers[TRIXI_FPTR_COLLECT_GARBAGE];
 
     // Call function
-    return load_node_weights(handle, node_weights);
+    collect_garbage();
 }
 
 
 /**
- * @anchor trixi_load_primitive_vars_api_c
- *
- * @brief Load primitive variable
+ * @anchor trixi_set_background_compilation_api_c
  *
- * The values for the primitive variable at position `variable_id` at every degree of
- * freedom are stored in the given array `data`.
+ * @brief Compile methods of a simulation in the background during its setup
  *
- * The given array has to be of correct size (ndofs) and memory has to be allocated
- * beforehand.
+ * The signatures of the methods needed for the time steps and the most common data access
+ * functions are recorded in a trace file per libelixir in `trace_directory` whenever
+ * @ref trixi_initialize_simulation_api_c "trixi_initialize_simulation" is called. If a
+ * trace exists, e.g., from a previous run of the host program, these methods are compiled
+ * on a background thread while the libelixir builds the mesh, the initial condition, and
+ * the initial refinement, such that the time to the first step is reduced. This requires
+ * Julia to run with more than one thread, e.g., with `JULIA_NUM_THREADS=2`.
  *
- * @param[in]  handle       simulation handle
- * @param[in]  variable_id  index of variable
- * @param[out] data         values for all degrees of freedom
+ * @param[in]  trace_directory  directory for the trace files, disables background
+ *                              compilation if empty
  */
-void trixi_load_primitive_vars(int handle, int variable_id, double * data) {
+void trixi_set_background_compilation(const char * trace_directory) {
 
     // Get function pointer
-    void (*load_primitive_vars)(int, int, double *) =
-        trixi_function_pointers[TRIXI_FTPR_LOAD_PRIMITIVE_VARS];
+    void (*set_background_compilation)(const char *) =
+        trixi_function_pointers[TRIXI_FPTR_SET_BACKGROUND_COMPILATION];
 
     // Call function
-    load_primitive_vars(handle, variable_id, data);
+    set_background_compilation(trace_directory);
 }
 
 
 /**
- * @anchor trixi_load_element_averaged_primitive_vars_api_c
+ * @anchor trixi_create_ensemble_api_c
  *
- * @brief Load element averages for primitive variable
+ * @brief Create an ensemble of copies of a simulation
  *
- * Element averaged values for the primitive variable at position `variable_id` for each
- * element are stored in the given array `data`.
+ * The ensemble consists of `nmembers` copies of the simulation identified by `handle`,
+ * which share the mesh and the solver cache. The conservative variables of all members are
+ * stored with the member index innermost, such that a single call to `trixi_step` advances
+ * all members with one pass over the mesh, using a common time step. Initially, all
+ * members hold the current solution of the given simulation, which stays valid and
+ * independent of the ensemble. Of its callbacks, only the step size callback is used.
  *
- * The given array has to be of correct size (nelements) and memory has to be allocated
- * beforehand.
+ * Individual members are accessed with @ref trixi_store_member_conservative_vars_api_c
+ * "trixi_store_member_conservative_vars" and @ref trixi_load_member_primitive_vars_api_c
+ * "trixi_load_member_primitive_vars". The returned handle is released with
+ * @ref trixi_finalize_simulation_api_c "trixi_finalize_simulation". The ensemble and the
+ * given simulation may be finalized in any order, since the mesh they share is only
+ * released with the last of them.
  *
- * @param[in]  handle       simulation handle
- * @param[in]  variable_id  index of variable
- * @param[out] data         element averaged values for all elements
+ * @param[in]  handle    simulation handle
+ * @param[in]  nmembers  number of ensemble members
+ *
+ * @return handle to the ensemble
  */
-void trixi_load_element_averaged_primitive_vars(int handle, int variable_id, double * data) {
+int trixi_create_ensemble(int handle, int nmembers) {
 
     // Get function pointer
-    void (*load_element_averaged_primitive_vars)(int, int, double *) =
-        trixi_function_pointers[TRIXI_FTPR_LOAD_ELEMENT_AVERAGED_PRIMITIVE_VARS];
+    int (*create_ensemble)(int, int) = trixi_function_pointers[TRIXI_FPTR_CREATE_ENSEMBLE];
 
     // Call function
-    load_element_averaged_primitive_vars(handle, variable_id, data);
+    return create_ensemble(handle, nmembers);
 }
 
 
 /**
- * @anchor trixi_register_data_api_c
+ * @anchor trixi_reinitialize_api_c
  *
- * @brief Store data vector in current simulation's registry
+ * @brief Restart simulation from the initial condition
  *
- * A reference to the passed data array `data` will be stored in the registry of the
- * simulation given by `simstate_handle` at given `index`. The registry object has to be
- * created in `init_simstate()` of the running libelixir and can be used throughout the
- * simulation.
+ * The simulation is reset to time t0 with final time tend, and the solution is set to the
+ * initial condition of the libelixir. Mesh, solver cache, and time integrator are reused,
+ * such that only the initial condition is evaluated, which makes this much cheaper than
+ * finalizing and initializing the simulation again, e.g., in parameter sweeps. If the time
+ * span changes, the time integrator is recreated. Step counters, time step, callbacks, and
+ * the preemption state are reset, such that a preempted simulation can be restarted with
+ * a new wall-time budget. The current mesh is kept, i.e., after AMR the initial condition
+ * is evaluated on the adapted mesh.
  *
- * The registry object has to exist, has to be of type `LibTrixiDataRegistry`, and has to
- * hold enough data references such that access at `index` is valid.
- * Memory storage remains on the user side. It must not be deallocated as long as it might
- * be accessed via the registry. The size of `data` has to match `size`.
+ * With MPI, this function has to be called collectively by all ranks.
  *
  * @param[in]  handle  simulation handle
- * @param[in]  index   index in registry where data vector will be stored
- * @param[in]  size    size of given data vector
- * @param[in]  data    data vector to store
+ * @param[in]  t0      new initial time
+ * @param[in]  tend    new final time
  */
-void trixi_register_data(int handle, int index, int size, const double * data) {
+void trixi_reinitialize(int handle, double t0, double tend) {
 
     // Get function pointer
-    void (*register_data)(int, int, int, const double *) =
-        trixi_function_pointers[TRIXI_FTPR_REGISTER_DATA];
+    void (*reinitialize)(int, double, double) =
+        trixi_function_pointers[TRIXI_FPTR_REINITIALIZE];
 
     // Call function
-    register_data(handle, index, size, data);
+    reinitialize(handle, t0, tend);
 }
 
 
 /**
- * @anchor trixi_get_simulation_time_api_c
+ * @anchor trixi_set_initial_state_api_c
  *
- * @brief Return current physical time.
+ * @brief Restart simulation from given conservative variables
  *
- * @param[in]  handle  simulation handle
+ * Same as @ref trixi_reinitialize_api_c "trixi_reinitialize", but the solution is copied
+ * from data instead of evaluating the initial condition. All conservative variables of a
+ * degree of freedom are stored contiguously, with the elements in the order set by
+ * @ref trixi_set_element_ordering_api_c "trixi_set_element_ordering". Not supported for
+ * ensembles, and for simulations with an AMR callback that adapts the initial condition,
+ * since this would overwrite the given data.
  *
- * @return physical time
+ * @param[in]  handle  simulation handle
+ * @param[in]  t0      new initial time
+ * @param[in]  tend    new final time
+ * @param[in]  data    conservative variables, of size ndofs * nvariables
  */
-double trixi_get_simulation_time(int handle) {
+void trixi_set_initial_state(int handle, double t0, double tend, const double * data) {
 
     // Get function pointer
-    double (*get_simulation_time)(int) =
-        trixi_function_pointers[TRIXI_FPTR_GET_SIMULATION_TIME];
+    void (*set_initial_state)(int, double, double, const double *) =
+        trixi_function_pointers[TRIXI_FPTR_SET_INITIAL_STATE];
 
     // Call function
-    return get_simulation_time(handle);
+    set_initial_state(handle, t0, tend, data);
 }
 
 
-
-/******************************************************************************************/
-/* T8code                                                                                 */
-/******************************************************************************************/
-
-/** Get t8code forest
- *
- *  For Trixi simulations on t8code meshes, the t8code forest is returned.
+/**
+ * @anchor trixi_finalize_simulation_api_c
  *
- *  \param[in] handle simulation handle
+ * @brief Finalize simulation
  *
- *  \warning The interface to t8code is experimental and implementation details may change
- *           at any time without warning.
+ * Finalize the simulation identified by handle. This will also release the handle.
  *
- *  \return t8code forest
+ * @param[in]  handle  simulation handle
  */
-t8_forest_t trixi_get_t8code_forest(int handle) {
+void trixi_finalize_simulation(int handle) {
 
     // Get function pointer
-    t8_forest_t (*get_t8code_forest)(int) =
-        trixi_function_pointers[TRIXI_FTPR_GET_T8CODE_FOREST];
+    void (*finalize_simulation)(int) =
+        trixi_function_pointers[TRIXI_FTPR_FINALIZE_SIMULATION];
 
     // Call function
-    return get_t8code_forest(handle);
+    finalize_simulation(handle);
 }
 
 
 
 /******************************************************************************************/
-/* Misc                                                                                   */
+/* Simulation data                                                                        */
+/******************************************************************************************/
+
+/**
+ * @anchor trixi_calculate_dt_api_c
+ *
+ * @brief Get time step length
+ *
+ * Get the current time step length of the simulation identified by handle.
+ *
+ * @param[in]  handle  simulation handle
+ *
+ * @return Time step length
+ */
+double trixi_calculate_dt(int handle) {
+
+    // Get function pointer
+    double (*calculate_dt)(int) = trixi_function_pointers[TRIXI_FTPR_CALCULATE_DT];;
+
+    // Call function
+    return calculate_dt( handle );
+}
+
+
+/**
+ * @anchor trixi_ndims_api_c
+ *
+ * @brief Return number of spatial dimensions
+ *
+ * @param[in]  handle  simulation handle
+ */
+int trixi_ndims(int handle) {
+
+    // Get function pointer
+    int (*ndims)(int) = trixi_function_pointers[TRIXI_FTPR_NDIMS];
+
+    // Call function
+    return ndims(handle);
+}
+
+
+/**
+ * @anchor trixi_nelements_api_c
+ *
+ * @brief Return number of local elements.
+ *
+ * These usually differ from the global count when doing parallel computations.
+ *
+ * @param[in]  handle  simulation handle
+ *
+ * @see trixi_nelementsglobal_api_c
+ */
+int trixi_nelements(int handle) {
+
+    // Get function pointer
+    int (*nelements)(int) = trixi_function_pointers[TRIXI_FPTR_NELEMENTS];
+
+    // Call function
+    return nelements(handle);
+}
+
+
+/**
+ * @anchor trixi_nelementsglobal_api_c
+ *
+ * @brief Return global number of elements.
+ *
+ * These usually differ from the local count when doing parallel computations.
+ *
+ * @param[in]  handle  simulation handle
+ *
+ * @see trixi_nelements_api_c
+ */
+int trixi_nelementsglobal(int handle) {
+
+    // Get function pointer
+    int (*nelementsglobal)(int) = trixi_function_pointers[TRIXI_FPTR_NELEMENTS_GLOBAL];
+
+    // Call function
+    return nelementsglobal(handle);
+}
+
+
+/**
+ * @anchor trixi_ndofs_api_c
+ *
+ * @brief Return number of local degrees of freedom.
+ *
+ * These usually differ from the global count when doing parallel computations.
+ *
+ * @param[in]  handle  simulation handle
+ *
+ * @see trixi_ndofsglobal_api_c
+ */
+int trixi_ndofs(int handle) {
+
+    // Get function pointer
+    int (*ndofs)(int) = trixi_function_pointers[TRIXI_FPTR_NDOFS];
+
+    // Call function
+    return ndofs(handle);
+}
+
+
+/**
+ * @anchor trixi_ndofsglobal_api_c
+ *
+ * @brief Return global number of degrees of freedom.
+ *
+ * These usually differ from the local count when doing parallel computations.
+ *
+ * @param[in]  handle  simulation handle
+ *
+ * @see trixi_ndofs_api_c
+ */
+int trixi_ndofsglobal(int handle) {
+
+    // Get function pointer
+    int (*ndofsglobal)(int) = trixi_function_pointers[TRIXI_FPTR_NDOFS_GLOBAL];
+
+    // Call function
+    return ndofsglobal(handle);
+}
+
+
+/**
+ * @anchor trixi_ndofselement_api_c
+ *
+ * @brief Return number of degrees of freedom per element.
+ *
+ * @param[in]  handle  simulation handle
+ */
+int trixi_ndofselement(int handle) {
+
+    // Get function pointer
+    int (*ndofselement)(int) = trixi_function_pointers[TRIXI_FPTR_NDOFS_ELEMENT];
+
+    // Call function
+    return ndofselement(handle);
+}
+
+
+/**
+ * @anchor trixi_nvariables_api_c
+ *
+ * @brief Return number of (conservative) variables
+ *
+ * @param[in]  handle  simulation handle
+ */
+int trixi_nvariables(int handle) {
+
+    // Get function pointer
+    int (*nvariables)(int) = trixi_function_pointers[TRIXI_FTPR_NVARIABLES];
+
+    // Call function
+    return nvariables(handle);
+}
+
+
+/**
+ * @anchor trixi_nmembers_api_c
+ *
+ * @brief Return number of ensemble members (1 if the simulation is not an ensemble)
+ *
+ * @param[in]  handle  simulation handle
+ */
+int trixi_nmembers(int handle) {
+
+    // Get function pointer
+    int (*nmembers)(int) = trixi_function_pointers[TRIXI_FPTR_NMEMBERS];
+
+    // Call function
+    return nmembers(handle);
+}
+
+
+/**
+ * @anchor trixi_nnodes_api_c
+ *
+ * @brief Return number of quadrature nodes per dimension.
+ *
+ * @param[in]  handle  simulation handle
+ */
+int trixi_nnodes(int handle) {
+
+    // Get function pointer
+    int (*nnodes)(int) = trixi_function_pointers[TRIXI_FPTR_NNODES];
+
+    // Call function
+    return nnodes(handle);
+}
+
+
+/**
+ * @anchor trixi_load_node_reference_coordinates_api_c
+ *
+ * @brief Get reference coordinates of 1D quadrature nodes.
+ *
+ * The reference coordinates in [-1,1] of the quadrature nodes in the current DG scheme are
+ * stored in the provided array `node_coords`. The given array has to be of correct size,
+ * i.e. `nnodes`, and memory has to be allocated beforehand.
+ *
+ * @param[in]   handle       simulation handle
+ * @param[out]  node_coords  node reference coordinates
+ */
+void trixi_load_node_reference_coordinates(int handle, double* node_coords) {
+
+    // Get function pointer
+    void (*load_node_reference_coordinates)(int, double *) = trixi_function_pointers[TRIXI_FPTR_LOAD_NODE_REFERENCE_COORDINATES];
+
+    // Call function
+    return load_node_reference_coordinates(handle, node_coords);
+}
+
+
+/**
+ * @anchor trixi_load_node_weights_api_c
+ *
+ * @brief Get weights of 1D quadrature nodes.
+ *
+ * The weights of the quadrature nodes in the current DG scheme are stored in the provided
+ * array `node_weights`. The given array has to be of correct size, i.e. `nnodes`, and
+ * memory has to be allocated beforehand.
+ *
+ * @param[in]   handle        simulation handle
+ * @param[out]  node_weights  node weights
+ */
+void trixi_load_node_weights(int handle, double* node_weights) {
+
+    // Get function pointer
+    void (*load_node_weights)(int, double *) = trixi_function_pointers[TRIXI_FPTR_LOAD_NODE_WEIGHTS];
+
+    // Call function
+    return load_node_weights(handle, node_weights);
+}
+
+
+/**
+ * @anchor trixi_load_primitive_vars_api_c
+ *
+ * @brief Load primitive variable
+ *
+ * The values for the primitive variable at position `variable_id` at every degree of
+ * freedom are stored in the given array `data`.
+ *
+ * The given array has to be of correct size (ndofs) and memory has to be allocated
+ * beforehand.
+ *
+ * @param[in]  handle       simulation handle
+ * @param[in]  variable_id  index of variable
+ * @param[out] data         values for all degrees of freedom
+ */
+void trixi_load_primitive_vars(int handle, int variable_id, double * data) {
+
+    // Get function pointer
+    void (*load_primitive_vars)(int, int, double *) =
+        trixi_function_pointers[TRIXI_FTPR_LOAD_PRIMITIVE_VARS];
+
+    // Call function
+    load_primitive_vars(handle, variable_id, data);
+}
+
+
+/**
+ * @anchor trixi_load_primitive_vars_f32_api_c
+ *
+ * @brief Load primitive variable in single precision
+ *
+ * Same as @ref trixi_load_primitive_vars_api_c "trixi_load_primitive_vars", but for a
+ * single precision array `data` of size ndofs.
+ *
+ * @param[in]  handle       simulation handle
+ * @param[in]  variable_id  index of variable
+ * @param[out] data         values for all degrees of freedom
+ */
+void trixi_load_primitive_vars_f32(int handle, int variable_id, float * data) {
+
+    // Get function pointer
+    void (*load_primitive_vars_f32)(int, int, float *) =
+        trixi_function_pointers[TRIXI_FPTR_LOAD_PRIMITIVE_VARS_F32];
+
+    // Call function
+    load_primitive_vars_f32(handle, variable_id, data);
+}
+
+
+/**
+ * @anchor trixi_load_member_primitive_vars_api_c
+ *
+ * @brief Load primitive variable of a single ensemble member
+ *
+ * The values for the primitive variable at position `variable_id` of ensemble member
+ * `member` (starting at 1) at every degree of freedom are stored in the given array
+ * `data`. Here, `variable_id` refers to the variables of a single member.
+ *
+ * The given array has to be of correct size (ndofs) and memory has to be allocated
+ * beforehand.
+ *
+ * @param[in]  handle       simulation handle
+ * @param[in]  member       index of ensemble member
+ * @param[in]  variable_id  index of variable
+ * @param[out] data         values for all degrees of freedom
+ */
+void trixi_load_member_primitive_vars(int handle, int member, int variable_id,
+                                      double * data) {
+
+    // Get function pointer
+    void (*load_member_primitive_vars)(int, int, int, double *) =
+        trixi_function_pointers[TRIXI_FPTR_LOAD_MEMBER_PRIMITIVE_VARS];
+
+    // Call function
+    load_member_primitive_vars(handle, member, variable_id, data);
+}
+
+
+/**
+ * @anchor trixi_store_member_conservative_vars_api_c
+ *
+ * @brief Set conservative variables of a single ensemble member
+ *
+ * The conservative variables of ensemble member `member` (starting at 1) are overwritten
+ * with the values in `data`, which are given in the same layout as the solution of a single
+ * simulation, i.e., all variables of a degree of freedom are stored contiguously.
+ *
+ * The given array has to be of size ndofs * nvariables / nmembers.
+ *
+ * @param[in]  handle  simulation handle
+ * @param[in]  member  index of ensemble member
+ * @param[in]  data    conservative variables for all degrees of freedom
+ */
+void trixi_store_member_conservative_vars(int handle, int member, const double * data) {
+
+    // Get function pointer
+    void (*store_member_conservative_vars)(int, int, const double *) =
+        trixi_function_pointers[TRIXI_FPTR_STORE_MEMBER_CONSERVATIVE_VARS];
+
+    // Call function
+    store_member_conservative_vars(handle, member, data);
+}
+
+
+/**
+ * @anchor trixi_load_element_averaged_primitive_vars_api_c
+ *
+ * @brief Load element averages for primitive variable
+ *
+ * Element averaged values for the primitive variable at position `variable_id` for each
+ * element are stored in the given array `data`.
+ *
+ * The given array has to be of correct size (nelements) and memory has to be allocated
+ * beforehand.
+ *
+ * @param[in]  handle       simulation handle
+ * @param[in]  variable_id  index of variable
+ * @param[out] data         element averaged values for all elements
+ */
+void trixi_load_element_averaged_primitive_vars(int handle, int variable_id, double * data) {
+
+    // Get function pointer
+    void (*load_element_averaged_primitive_vars)(int, int, double *) =
+        trixi_function_pointers[TRIXI_FTPR_LOAD_ELEMENT_AVERAGED_PRIMITIVE_VARS];
+
+    // Call function
+    load_element_averaged_primitive_vars(handle, variable_id, data);
+}
+
+
+/**
+ * @anchor trixi_load_element_averaged_primitive_vars_f32_api_c
+ *
+ * @brief Load element averages for primitive variable in single precision
+ *
+ * Same as @ref trixi_load_element_averaged_primitive_vars_api_c
+ * "trixi_load_element_averaged_primitive_vars", but for a single precision array `data` of
+ * size nelements.
+ *
+ * @param[in]  handle       simulation handle
+ * @param[in]  variable_id  index of variable
+ * @param[out] data         averaged values for all elements
+ */
+void trixi_load_element_averaged_primitive_vars_f32(int handle, int variable_id,
+                                                    float * data) {
+
+    // Get function pointer
+    void (*load_element_averaged_primitive_vars_f32)(int, int, float *) =
+        trixi_function_pointers[TRIXI_FPTR_LOAD_ELEMENT_AVERAGED_PRIMITIVE_VARS_F32];
+
+    // Call function
+    load_element_averaged_primitive_vars_f32(handle, variable_id, data);
+}
+
+
+/**
+ * @anchor trixi_define_output_variable_api_c
+ *
+ * @brief Define output variable given by Julia code
+ *
+ * Defines a variable that is computed node-wise from the conservative variables. The string
+ * `expression` is Julia code that evaluates to a function `(u, equations) -> value`, where
+ * `u` holds the conservative variables at a single node, e.g., `"Trixi.entropy"`. It is
+ * compiled once, after which the variable can be loaded with
+ * @ref trixi_load_variable_api_c "trixi_load_variable" using the returned handle. Defining
+ * a variable with an existing name replaces the previous definition and returns the same
+ * handle.
+ *
+ * @param[in]  handle      simulation handle
+ * @param[in]  name        name of the variable
+ * @param[in]  expression  Julia code for the conversion
+ *
+ * @return handle of the output variable
+ */
+int trixi_define_output_variable(int handle, const char * name, const char * expression) {
+
+    // Get function pointer
+    int (*define_output_variable)(int, const char *, const char *) =
+        trixi_function_pointers[TRIXI_FPTR_DEFINE_OUTPUT_VARIABLE];
+
+    // Call function
+    return define_output_variable(handle, name, expression);
+}
+
+
+/**
+ * @anchor trixi_define_output_variable_callback_api_c
+ *
+ * @brief Define output variable given by a C function
+ *
+ * Same as @ref trixi_define_output_variable_api_c "trixi_define_output_variable", but the
+ * value at each node is computed as `func(u, nvariables, userdata)`, where `u` points to the
+ * `nvariables` conservative variables at the node. If Julia runs with multiple threads,
+ * `func` is called concurrently and must be thread-safe.
+ *
+ * @param[in]  handle    simulation handle
+ * @param[in]  name      name of the variable
+ * @param[in]  func      function computing the value at a node
+ * @param[in]  userdata  pointer passed through to `func`
+ *
+ * @return handle of the output variable
+ */
+int trixi_define_output_variable_callback(int handle, const char * name,
+                                          trixi_output_variable_callback_t func,
+                                          void * userdata) {
+
+    // Get function pointer
+    int (*define_output_variable_callback)(int, const char *,
+                                           trixi_output_variable_callback_t, void *) =
+        trixi_function_pointers[TRIXI_FPTR_DEFINE_OUTPUT_VARIABLE_CALLBACK];
+
+    // Call function
+    return define_output_variable_callback(handle, name, func, userdata);
+}
+
+
+/**
+ * @anchor trixi_load_variable_api_c
+ *
+ * @brief Load output variable
+ *
+ * The values of the output variable `variable_handle`, as returned by
+ * @ref trixi_define_output_variable_api_c "trixi_define_output_variable", at every degree of
+ * freedom are computed in a single pass over the solution and stored in the given array
+ * `data`, in the same order as in `trixi_load_primitive_vars`.
+ *
+ * The given array has to be of correct size (ndofs) and memory has to be allocated
+ * beforehand.
+ *
+ * @param[in]  handle           simulation handle
+ * @param[in]  variable_handle  handle of the output variable
+ * @param[out] data             values for all degrees of freedom
+ */
+void trixi_load_variable(int handle, int variable_handle, double * data) {
+
+    // Get function pointer
+    void (*load_variable)(int, int, double *) =
+        trixi_function_pointers[TRIXI_FPTR_LOAD_VARIABLE];
+
+    // Call function
+    load_variable(handle, variable_handle, data);
+}
+
+
+/**
+ * @anchor trixi_set_element_ordering_api_c
+ *
+ * @brief Set the order of elements in all data exchanged with the host
+ *
+ * The data of the `i`-th local element in Trixi's order is stored at position
+ * `ordering[i]` (starting at 1) in all arrays loaded from or stored into the simulation,
+ * e.g., by `trixi_load_primitive_vars` or `trixi_load_element_averaged_primitive_vars`. The
+ * permutation is applied directly when copying the data, i.e., without an extra pass. If
+ * `ordering` is a null pointer, Trixi's order is restored.
+ *
+ * The ordering is only valid as long as the mesh does not change. After the mesh was
+ * changed, e.g., by AMR, data can only be exchanged after the ordering was set again.
+ * Blocks streamed by @ref trixi_foreach_element_block_api_c "trixi_foreach_element_block"
+ * always use Trixi's order.
+ *
+ * Registered data vectors are read by the libelixir in Trixi's order and are not permuted.
+ * Therefore, an ordering cannot be set while data with one value per element or per degree
+ * of freedom is registered, and such data cannot be registered while an ordering is set.
+ *
+ * @param[in]  handle     simulation handle
+ * @param[in]  nelements  number of local elements
+ * @param[in]  ordering   position of each element in host data (may be null)
+ */
+void trixi_set_element_ordering(int handle, int nelements, const int * ordering) {
+
+    // Get function pointer
+    void (*set_element_ordering)(int, int, const int *) =
+        trixi_function_pointers[TRIXI_FPTR_SET_ELEMENT_ORDERING];
+
+    // Call function
+    set_element_ordering(handle, nelements, ordering);
+}
+
+
+/**
+ * @anchor trixi_foreach_element_block_api_c
+ *
+ * @brief Stream primitive variables in blocks of elements to a callback
+ *
+ * The elements are processed in blocks of at most `block_size` elements. For each block,
+ * the primitive variables at the `nvars` positions given in `variable_ids` are stored in a
+ * small buffer, which is reused for all blocks, and
+ * `callback(element_offset, nelements, data, userdata)` is called. Here, `element_offset`
+ * is the number of elements preceding the block and `nelements` is the number of elements
+ * in the block. For the `k`-th requested variable (zero-based), the values at all degrees
+ * of freedom of the block are stored contiguously at `data + k * nelements * ndofselement`,
+ * in the same order as in `trixi_load_primitive_vars`.
+ *
+ * The buffer is only valid during the callback. Compared to loading complete arrays, only
+ * `block_size * ndofselement * nvars` values of extra memory are required.
+ *
+ * @param[in]  handle        simulation handle
+ * @param[in]  block_size    maximum number of elements per block
+ * @param[in]  nvars         number of variables
+ * @param[in]  variable_ids  indices of primitive variables
+ * @param[in]  callback      function called for each block
+ * @param[in]  userdata      pointer passed through to `callback`
+ */
+void trixi_foreach_element_block(int handle, int block_size, int nvars,
+                                 const int * variable_ids, trixi_block_callback_t callback,
+                                 void * userdata) {
+
+    // Get function pointer
+    void (*foreach_element_block)(int, int, int, const int *, trixi_block_callback_t,
+                                  void *) =
+        trixi_function_pointers[TRIXI_FPTR_FOREACH_ELEMENT_BLOCK];
+
+    // Call function
+    foreach_element_block(handle, block_size, nvars, variable_ids, callback, userdata);
+}
+
+
+/**
+ * @anchor trixi_register_data_api_c
+ *
+ * @brief Store data vector in current simulation's registry
+ *
+ * A reference to the passed data array `data` will be stored in the registry of the
+ * simulation given by `simstate_handle` at given `index`. The registry object has to be
+ * created in `init_simstate()` of the running libelixir and can be used throughout the
+ * simulation.
+ *
+ * The registry object has to exist, has to be of type `LibTrixiDataRegistry`, and has to
+ * hold enough data references such that access at `index` is valid.
+ * Memory storage remains on the user side. It must not be deallocated as long as it might
+ * be accessed via the registry. The size of `data` has to match `size`.
+ *
+ * @param[in]  handle  simulation handle
+ * @param[in]  index   index in registry where data vector will be stored
+ * @param[in]  size    size of given data vector
+ * @param[in]  data    data vector to store
+ */
+void trixi_register_data(int handle, int index, int size, const double * data) {
+
+    // Get function pointer
+    void (*register_data)(int, int, int, const double *) =
+        trixi_function_pointers[TRIXI_FTPR_REGISTER_DATA];
+
+    // Call function
+    register_data(handle, index, size, data);
+}
+
+
+/**
+ * @anchor trixi_register_data_f32_api_c
+ *
+ * @brief Store single precision data vector in current simulation's registry
+ *
+ * Same as @ref trixi_register_data_api_c "trixi_register_data", but for a single precision
+ * data vector. The registry object has to be of type `LibTrixiDataRegistryF32`.
+ *
+ * @param[in]  handle  simulation handle
+ * @param[in]  index   index in registry where data vector will be stored
+ * @param[in]  size    size of given data vector
+ * @param[in]  data    data vector to store
+ */
+void trixi_register_data_f32(int handle, int index, int size, const float * data) {
+
+    // Get function pointer
+    void (*register_data_f32)(int, int, int, const float *) =
+        trixi_function_pointers[TRIXI_FPTR_REGISTER_DATA_F32];
+
+    // Call function
+    register_data_f32(handle, index, size, data);
+}
+
+
+/**
+ * @anchor trixi_set_buffer_storage_api_c
+ *
+ * @brief Place library-managed buffers in file-backed memory maps
+ *
+ * All buffers allocated by the library afterwards, i.e., data vectors allocated with
+ * @ref trixi_allocate_data_api_c "trixi_allocate_data", are mapped from files in the given
+ * directory. With a directory on node-local NVMe, rarely used data can thus exceed the DRAM
+ * of a node, since the operating system pages it out to the file. The files are removed
+ * right after mapping. An empty directory restores regular memory.
+ *
+ * @param[in]  handle       simulation handle
+ * @param[in]  directory    directory for the mapped files, or "" for regular memory
+ * @param[in]  access_hint  one of TRIXI_ACCESS_NORMAL, TRIXI_ACCESS_SEQUENTIAL,
+ *                          TRIXI_ACCESS_RANDOM, or TRIXI_ACCESS_WILLNEED, passed to madvise
+ */
+void trixi_set_buffer_storage(int handle, const char * directory, int access_hint) {
+
+    // Get function pointer
+    void (*set_buffer_storage)(int, const char *, int) =
+        trixi_function_pointers[TRIXI_FPTR_SET_BUFFER_STORAGE];
+
+    // Call function
+    set_buffer_storage(handle, directory, access_hint);
+}
+
+
+/**
+ * @anchor trixi_allocate_data_api_c
+ *
+ * @brief Allocate data vector in current simulation's registry
+ *
+ * The zero-initialized vector is allocated in the buffer storage of the simulation, see
+ * @ref trixi_set_buffer_storage_api_c "trixi_set_buffer_storage". In contrast to
+ * @ref trixi_register_data_api_c "trixi_register_data", the memory is owned by the library
+ * and must not be freed. The pointer remains valid until another data vector is stored at
+ * the same index or the simulation is finalized.
+ *
+ * @param[in]  handle  simulation handle
+ * @param[in]  index   index in registry where data vector will be stored
+ * @param[in]  size    size of data vector
+ *
+ * @return Pointer to the data vector
+ */
+double * trixi_allocate_data(int handle, int index, int size) {
+
+    // Get function pointer
+    double * (*allocate_data)(int, int, int) =
+        trixi_function_pointers[TRIXI_FPTR_ALLOCATE_DATA];
+
+    // Call function
+    return allocate_data(handle, index, size);
+}
+
+
+/**
+ * @anchor trixi_get_simulation_time_api_c
+ *
+ * @brief Return current physical time.
+ *
+ * @param[in]  handle  simulation handle
+ *
+ * @return physical time
+ */
+double trixi_get_simulation_time(int handle) {
+
+    // Get function pointer
+    double (*get_simulation_time)(int) =
+        trixi_function_pointers[TRIXI_FPTR_GET_SIMULATION_TIME];
+
+    // Call function
+    return get_simulation_time(handle);
+}
+
+
+
+/******************************************************************************************/
+/* Simulation output                                                                      */
+/******************************************************************************************/
+
+/**
+ * @anchor trixi_save_vtkhdf_api_c
+ *
+ * @brief Write current solution to a VTKHDF file
+ *
+ * The primitive variables are written as point data of an unstructured grid with one
+ * high-order Lagrange cell per DG element. The resulting file can be opened directly in
+ * ParaView without any postprocessing. With MPI, each rank contributes one piece of the
+ * grid and the function has to be called collectively by all ranks.
+ *
+ * @param[in]  handle    simulation handle
+ * @param[in]  filename  path of the file to be written
+ */
+void trixi_save_vtkhdf(int handle, const char * filename) {
+
+    // Get function pointer
+    void (*save_vtkhdf)(int, const char *) = trixi_function_pointers[TRIXI_FPTR_SAVE_VTKHDF];
+
+    // Call function
+    save_vtkhdf(handle, filename);
+}
+
+
+/**
+ * @anchor trixi_set_output_aggregation_api_c
+ *
+ * @brief Enable or disable node-aggregated output
+ *
+ * If enabled, @ref trixi_save_vtkhdf_api_c "trixi_save_vtkhdf" collects the data of all
+ * ranks on a compute node (i.e., ranks that can share memory) on one aggregator rank per
+ * node. Only the aggregators write to the file, each one a single contiguous piece, which
+ * reduces the number of I/O requests and the load on the metadata servers of parallel file
+ * systems. Without an MPI-enabled HDF5 library, the first aggregator writes the pieces of
+ * all nodes.
+ *
+ * @param[in]  handle   simulation handle
+ * @param[in]  enabled  aggregate output if nonzero
+ */
+void trixi_set_output_aggregation(int handle, int enabled) {
+
+    // Get function pointer
+    void (*set_output_aggregation)(int, int) =
+        trixi_function_pointers[TRIXI_FPTR_SET_OUTPUT_AGGREGATION];
+
+    // Call function
+    set_output_aggregation(handle, enabled);
+}
+
+
+/**
+ * @anchor trixi_set_shm_publication_api_c
+ *
+ * @brief Publish snapshots of the solution to shared memory
+ *
+ * Every `interval` steps, the primitive variables `variable_ids` are written to a POSIX
+ * shared-memory segment, from which processes on the same compute node read them without
+ * copies using the consumer library declared in `trixi_shm.h`. The segment is named `name`
+ * with a single rank and `name.<rank>` with several ranks. It holds a ring of `nslots`
+ * snapshots, each guarded by a sequence lock, such that consumers never block the
+ * simulation and detect snapshots that are overwritten while they are read. Each variable
+ * is stored contiguously for all degrees of freedom of the rank, in the same order as for
+ * @ref trixi_load_primitive_vars_api_c "trixi_load_primitive_vars". The current solution is
+ * published right away, and the segment is removed when the simulation is finalized.
+ *
+ * @param[in]  handle        simulation handle
+ * @param[in]  name          name of the segment
+ * @param[in]  interval      number of steps between snapshots, disabled if not positive
+ * @param[in]  nvars         number of variables
+ * @param[in]  variable_ids  indices of primitive variables
+ * @param[in]  nslots        number of snapshots kept in the segment
+ */
+void trixi_set_shm_publication(int handle, const char * name, int interval, int nvars,
+                               const int * variable_ids, int nslots) {
+
+    // Get function pointer
+    void (*set_shm_publication)(int, const char *, int, int, const int *, int) =
+        trixi_function_pointers[TRIXI_FPTR_SET_SHM_PUBLICATION];
+
+    // Call function
+    set_shm_publication(handle, name, interval, nvars, variable_ids, nslots);
+}
+
+
+
+/******************************************************************************************/
+/* Nesting                                                                                */
+/******************************************************************************************/
+
+/**
+ * @anchor trixi_create_nesting_api_c
+ *
+ * @brief Couple a child simulation to a parent simulation
+ *
+ * The domain of the child simulation must be contained in the domain of the parent
+ * simulation. All point-location and interpolation operators between both meshes are
+ * precomputed here and are rebuilt automatically only if the mesh of either simulation
+ * changes. Both simulations must have the same number of dimensions and variables.
+ *
+ * In a relaxation zone of width `relaxation_width` along the boundary of the child domain,
+ * the child solution is relaxed towards the parent solution by
+ * `trixi_nesting_interpolate`. Inside the child domain but outside the relaxation zone,
+ * `trixi_nesting_feedback` blends the parent solution with the child solution using
+ * `feedback_weight`.
+ *
+ * With MPI, this function has to be called collectively by all ranks.
+ *
+ * @param[in]  parent_handle     simulation handle of the parent simulation
+ * @param[in]  child_handle      simulation handle of the child simulation
+ * @param[in]  relaxation_width  width of the relaxation zone (positive)
+ * @param[in]  feedback_weight   weight of the child solution in the feedback (in [0,1])
+ *
+ * @return handle to the nesting
+ */
+int trixi_create_nesting(int parent_handle, int child_handle, double relaxation_width,
+                         double feedback_weight) {
+
+    // Get function pointer
+    int (*create_nesting)(int, int, double, double) =
+        trixi_function_pointers[TRIXI_FPTR_CREATE_NESTING];
+
+    // Call function
+    return create_nesting(parent_handle, child_handle, relaxation_width, feedback_weight);
+}
+
+
+/**
+ * @anchor trixi_nesting_interpolate_api_c
+ *
+ * @brief Interpolate parent solution to the child relaxation zone
+ *
+ * The child solution is modified in place. With MPI, this function has to be called
+ * collectively by all ranks.
+ *
+ * @param[in]  nesting_handle  nesting handle
+ */
+void trixi_nesting_interpolate(int nesting_handle) {
+
+    // Get function pointer
+    void (*nesting_interpolate)(int) = trixi_function_pointers[TRIXI_FPTR_NESTING_INTERPOLATE];
+
+    // Call function
+    nesting_interpolate(nesting_handle);
+}
+
+
+/**
+ * @anchor trixi_nesting_feedback_api_c
+ *
+ * @brief Feed child solution back to the parent simulation
+ *
+ * The parent solution is modified in place. With MPI, this function has to be called
+ * collectively by all ranks.
+ *
+ * @param[in]  nesting_handle  nesting handle
+ */
+void trixi_nesting_feedback(int nesting_handle) {
+
+    // Get function pointer
+    void (*nesting_feedback)(int) = trixi_function_pointers[TRIXI_FPTR_NESTING_FEEDBACK];
+
+    // Call function
+    nesting_feedback(nesting_handle);
+}
+
+
+/**
+ * @anchor trixi_finalize_nesting_api_c
+ *
+ * @brief Release a nesting
+ *
+ * The coupled simulations are not affected.
+ *
+ * @param[in]  nesting_handle  nesting handle
+ */
+void trixi_finalize_nesting(int nesting_handle) {
+
+    // Get function pointer
+    void (*finalize_nesting)(int) = trixi_function_pointers[TRIXI_FPTR_FINALIZE_NESTING];
+
+    // Call function
+    finalize_nesting(nesting_handle);
+}
+
+
+/**
+ * @anchor trixi_transfer_solution_api_c
+ *
+ * @brief Transfer the solution of one simulation to another one on a different mesh
+ *
+ * The solution of the simulation `src_handle` is evaluated on the mesh of the simulation
+ * `dst_handle`, which may differ in resolution, mesh type, polynomial degree, and
+ * partitioning, and overwrites its solution. If `l2_projection` is zero, the solution is
+ * interpolated to the nodes of the destination, otherwise it is L2-projected onto the
+ * destination basis using Gauss points in each destination element. The destination domain
+ * has to be covered by the source domain. The simulation time of the destination is not
+ * changed.
+ *
+ * Both simulations need the same equations. With MPI, this function has to be called
+ * collectively by all ranks.
+ *
+ * @param[in]  src_handle     handle of the source simulation
+ * @param[in]  dst_handle     handle of the destination simulation
+ * @param[in]  l2_projection  L2-project instead of interpolating if nonzero
+ */
+void trixi_transfer_solution(int src_handle, int dst_handle, int l2_projection) {
+
+    // Get function pointer
+    void (*transfer_solution)(int, int, int) =
+        trixi_function_pointers[TRIXI_FPTR_TRANSFER_SOLUTION];
+
+    // Call function
+    transfer_solution(src_handle, dst_handle, l2_projection);
+}
+
+
+
+/******************************************************************************************/
+/* Logging                                                                                */
+/******************************************************************************************/
+
+/**
+ * @anchor trixi_set_log_sink_api_c
+ *
+ * @brief Route all output through a user-provided sink
+ *
+ * All messages of libtrixi are passed to `sink(level, message, userdata)`, where `message`
+ * is a null-terminated string that is only valid during the call. Only messages
+ * with a level of at least `min_level` (see `TRIXI_LOG_DEBUG` etc.) are passed on, and
+ * only by ranks that are a multiple of `rank_stride`, i.e., only by the root rank if
+ * `rank_stride` is zero.
+ *
+ * If `json` is nonzero, each message is a single-line JSON object with the fields `level`,
+ * `rank`, `walltime`, and `message`, plus further structured fields depending on the
+ * source of the message. For example, in simulations initialized while a sink is set, each
+ * execution of an analysis callback yields a record with `source` set to `analysis` and
+ * the fields `t`, `iter`, `dt`, `variables`, `l2_error`, and `linf_error`, and each
+ * execution of an alive callback a record with `source` set to `alive`.
+ *
+ * The standard output of the process is not redirected. Instead, the analysis and alive
+ * callbacks of simulations initialized while a sink is set emit records rather than
+ * printing, and the timer summary of the summary callback is passed to the sink when such
+ * a simulation is finalized. Output that Trixi prints while a libelixir sets up the
+ * simulation on the root rank is not affected. Passing a null pointer as `sink` restores
+ * the default behavior of printing to `stdout`, which is also done by
+ * @ref trixi_finalize_api_c "trixi_finalize".
+ *
+ * Calls of `sink` are serialized by libtrixi, i.e., `sink` does not need to be thread-safe.
+ * If @ref trixi_scheduler_run_api_c "trixi_scheduler_run" advances simulations
+ * concurrently, it may however be called from threads other than the calling one.
+ *
+ * @param[in]  sink         function called for each message (may be null)
+ * @param[in]  userdata     pointer passed through to `sink`
+ * @param[in]  min_level    minimum level of messages passed to `sink`
+ * @param[in]  rank_stride  only every `rank_stride`-th rank emits messages (root only if 0)
+ * @param[in]  json         format messages as JSON lines if nonzero
+ */
+void trixi_set_log_sink(trixi_log_callback_t sink, void * userdata, int min_level,
+                        int rank_stride, int json) {
+
+    // Get function pointer
+    void (*set_log_sink)(trixi_log_callback_t, void *, int, int, int) =
+        trixi_function_pointers[TRIXI_FPTR_SET_LOG_SINK];
+
+    // Call function
+    set_log_sink(sink, userdata, min_level, rank_stride, json);
+}
+
+
+/**
+ * @anchor trixi_log_message_api_c
+ *
+ * @brief Emit a message through the log sink
+ *
+ * The message is passed to the sink set with @ref trixi_set_log_sink_api_c
+ * "trixi_set_log_sink", subject to its level and rank filters, or printed to `stdout` if
+ * no sink is set.
+ *
+ * @param[in]  level    message level (see `TRIXI_LOG_DEBUG` etc.)
+ * @param[in]  message  null-terminated message
+ */
+void trixi_log_message(int level, const char * message) {
+
+    // Get function pointer
+    void (*log_message)(int, const char *) = trixi_function_pointers[TRIXI_FPTR_LOG_MESSAGE];
+
+    // Call function
+    log_message(level, message);
+}
+
+
+
+/******************************************************************************************/
+/* T8code                                                                                 */
+/******************************************************************************************/
+
+/** Get t8code forest
+ *
+ *  For Trixi simulations on t8code meshes, the t8code forest is returned.
+ *
+ *  \param[in] handle simulation handle
+ *
+ *  \warning The interface to t8code is experimental and implementation details may change
+ *           at any time without warning.
+ *
+ *  \return t8code forest
+ */
+t8_forest_t trixi_get_t8code_forest(int handle) {
+
+    // Get function pointer
+    t8_forest_t (*get_t8code_forest)(int) =
+        trixi_function_pointers[TRIXI_FTPR_GET_T8CODE_FOREST];
+
+    // Call function
+    return get_t8code_forest(handle);
+}
+
+
+
+/******************************************************************************************/
+/* Misc                                                                                   */
 /******************************************************************************************/
 
+/**
+ * @anchor trixi_set_allocator_api_c
+ *
+ * @brief Allocate library-managed buffers with a host allocator
+ *
+ * Memory for buffers allocated by the library afterwards, i.e., data vectors allocated with
+ * @ref trixi_allocate_data_api_c "trixi_allocate_data", is requested as
+ * `ptr = alloc_fn(size, userdata)` with size in bytes and released as
+ * `free_fn(ptr, userdata)`, such that allocation policies of the host (huge pages, NUMA
+ * pools, accounting) apply. A file-backed buffer storage set with
+ * @ref trixi_set_buffer_storage_api_c "trixi_set_buffer_storage" takes precedence.
+ *
+ * The memory has to be aligned for double values (64 bytes are recommended). Memory is
+ * released when Julia's garbage collector frees the buffer, which may happen on any thread
+ * and also after the simulation is finalized. Both functions thus have to be thread-safe
+ * and remain valid until @ref trixi_finalize_api_c "trixi_finalize" is called.
+ *
+ * @param[in]  alloc_fn  allocation function, or NULL to use Julia's allocator again
+ * @param[in]  free_fn   function releasing memory obtained from alloc_fn
+ * @param[in]  userdata  pointer passed through to alloc_fn and free_fn
+ */
+void trixi_set_allocator(trixi_alloc_callback_t alloc_fn, trixi_free_callback_t free_fn,
+                         void * userdata) {
+
+    // Get function pointer
+    void (*set_allocator)(trixi_alloc_callback_t, trixi_free_callback_t, void *) =
+        trixi_function_pointers[TRIXI_FPTR_SET_ALLOCATOR];
+
+    // Call function
+    set_allocator(alloc_fn, free_fn, userdata);
+}
+
+
 /**
  * @anchor trixi_eval_julia_api_c
  *
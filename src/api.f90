@@ -7,8 +7,30 @@
 !! @{
 
 module LibTrixi
+  use, intrinsic :: iso_c_binding, only: c_int
   implicit none
 
+  !> Log levels, see @ref trixi_set_log_sink
+  integer(c_int), parameter :: TRIXI_LOG_DEBUG = 0
+  integer(c_int), parameter :: TRIXI_LOG_INFO = 1
+  integer(c_int), parameter :: TRIXI_LOG_WARNING = 2
+  integer(c_int), parameter :: TRIXI_LOG_ERROR = 3
+
+  !> Access hints for buffer storage, see @ref trixi_set_buffer_storage
+  integer(c_int), parameter :: TRIXI_ACCESS_NORMAL = 0
+  integer(c_int), parameter :: TRIXI_ACCESS_SEQUENTIAL = 1
+  integer(c_int), parameter :: TRIXI_ACCESS_RANDOM = 2
+  integer(c_int), parameter :: TRIXI_ACCESS_WILLNEED = 3
+
+  !> Health check actions and status, see @ref trixi_set_health_check
+  integer(c_int), parameter :: TRIXI_HEALTH_REPORT = 0
+  integer(c_int), parameter :: TRIXI_HEALTH_STOP = 1
+  integer(c_int), parameter :: TRIXI_HEALTH_ROLLBACK = 2
+  integer(c_int), parameter :: TRIXI_HEALTH_OK = 0
+  integer(c_int), parameter :: TRIXI_HEALTH_PRESSURE = 1
+  integer(c_int), parameter :: TRIXI_HEALTH_DENSITY = 2
+  integer(c_int), parameter :: TRIXI_HEALTH_NONFINITE = 3
+
   interface
     !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
     !! Setup                                                                              !!
@@ -167,6 +189,48 @@ module LibTrixi
       character(kind=c_char), dimension(*), intent(in) :: libelixir
     end function
 
+    !>
+    !! @fn LibTrixi::trixi_initialize_simulation_f32_c::trixi_initialize_simulation_f32_c(libelexir, geometry_f64)
+    !!
+    !! @brief Set up Trixi simulation in single precision (C char pointer version)
+    !!
+    !! @param[in]  libelixir     Path to libelexir file.
+    !! @param[in]  geometry_f64  keep geometry in double precision if nonzero
+    !!
+    !! @return handle (integer) to Trixi simulation instance
+    !!
+    !! @see @ref trixi_initialize_simulation_f32
+    !!           "trixi_initialize_simulation_f32 (Fortran convenience version)"
+    !! @see @ref trixi_initialize_simulation_f32_api_c
+    !!           "trixi_initialize_simulation_f32 (C API)"
+    integer(c_int) function trixi_initialize_simulation_f32_c(libelixir, geometry_f64) &
+      bind(c, name='trixi_initialize_simulation_f32')
+      use, intrinsic :: iso_c_binding, only: c_char, c_int
+      character(kind=c_char), dimension(*), intent(in) :: libelixir
+      integer(c_int), value, intent(in) :: geometry_f64
+    end function
+
+    !>
+    !! @fn LibTrixi::trixi_get_setup_time_c::trixi_get_setup_time_c(handle, phase)
+    !!
+    !! @brief Return the wall time of an initialization phase (C char pointer version)
+    !!
+    !! @param[in]  handle  simulation handle
+    !! @param[in]  phase   name of the phase
+    !!
+    !! @return wall time of the phase in seconds on this rank, NaN if it was not recorded
+    !!
+    !! @see @ref trixi_get_setup_time
+    !!           "trixi_get_setup_time (Fortran convenience version)"
+    !! @see @ref trixi_get_setup_time_api_c
+    !!           "trixi_get_setup_time (C API)"
+    real(c_double) function trixi_get_setup_time_c(handle, phase) &
+      bind(c, name='trixi_get_setup_time')
+      use, intrinsic :: iso_c_binding, only: c_char, c_int, c_double
+      integer(c_int), value, intent(in) :: handle
+      character(kind=c_char), dimension(*), intent(in) :: phase
+    end function
+
     !>
     !! @fn LibTrixi::trixi_is_finished_c::trixi_is_finished_c(handle)
     !!
@@ -185,6 +249,24 @@ module LibTrixi
       integer(c_int), value, intent(in) :: handle
     end function
 
+    !>
+    !! @fn LibTrixi::trixi_is_preempted_c::trixi_is_preempted_c(handle)
+    !!
+    !! @brief Check if simulation was stopped by preemption (C integer version)
+    !!
+    !! @param[in]  handle  simulation handle
+    !!
+    !! @return 1 if preempted, 0 if not
+    !!
+    !! @see @ref trixi_is_preempted
+    !!           "trixi_is_preempted (Fortran convenience version)"
+    !! @see @ref trixi_is_preempted_api_c
+    !!           "trixi_is_preempted (C API)"
+    integer(c_int) function trixi_is_preempted_c(handle) bind(c, name='trixi_is_preempted')
+      use, intrinsic :: iso_c_binding, only: c_int
+      integer(c_int), value, intent(in) :: handle
+    end function
+
     !>
     !! @fn LibTrixi::trixi_step::trixi_step(handle)
     !!
@@ -198,6 +280,335 @@ module LibTrixi
       integer(c_int), value, intent(in) :: handle
     end subroutine
 
+    !>
+    !! @fn LibTrixi::trixi_scheduler_run::trixi_scheduler_run(nhandles, handles, sync_interval, coupling, userdata)
+    !!
+    !! @brief Advance several simulations with individual time steps to common sync times
+    !!
+    !! @param[in]  nhandles       number of simulation handles
+    !! @param[in]  handles        simulation handles
+    !! @param[in]  sync_interval  time between synchronization points
+    !! @param[in]  coupling       C function pointer to
+    !!                            `subroutine coupling(time, userdata) bind(c)`
+    !!                            (may be `c_null_funptr`)
+    !! @param[in]  userdata       pointer passed through to `coupling`
+    !!
+    !! @see @ref trixi_scheduler_run_api_c "trixi_scheduler_run (C API)"
+    subroutine trixi_scheduler_run(nhandles, handles, sync_interval, coupling, userdata) &
+      bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int, c_double, c_funptr, c_ptr
+      integer(c_int), value, intent(in) :: nhandles
+      integer(c_int), dimension(*), intent(in) :: handles
+      real(c_double), value, intent(in) :: sync_interval
+      type(c_funptr), value, intent(in) :: coupling
+      type(c_ptr), value, intent(in) :: userdata
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_set_polydeg::trixi_set_polydeg(handle, polydeg)
+    !!
+    !! @brief Change polynomial degree of the DG solver
+    !!
+    !! @param[in]  handle   simulation handle
+    !! @param[in]  polydeg  new polynomial degree
+    !!
+    !! @see @ref trixi_set_polydeg_api_c "trixi_set_polydeg (C API)"
+    subroutine trixi_set_polydeg(handle, polydeg) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int
+      integer(c_int), value, intent(in) :: handle
+      integer(c_int), value, intent(in) :: polydeg
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_set_amr_autotuning::trixi_set_amr_autotuning(handle, min_interval, max_interval, target_overhead)
+    !!
+    !! @brief Tune the AMR interval online
+    !!
+    !! @param[in]  handle           simulation handle
+    !! @param[in]  min_interval     smallest AMR interval, disables autotuning if not positive
+    !! @param[in]  max_interval     largest AMR interval
+    !! @param[in]  target_overhead  acceptable adaptation cost relative to the step cost
+    !!
+    !! @see @ref trixi_set_amr_autotuning_api_c "trixi_set_amr_autotuning (C API)"
+    subroutine trixi_set_amr_autotuning(handle, min_interval, max_interval, &
+                                        target_overhead) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int, c_double
+      integer(c_int), value, intent(in) :: handle
+      integer(c_int), value, intent(in) :: min_interval
+      integer(c_int), value, intent(in) :: max_interval
+      real(c_double), value, intent(in) :: target_overhead
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_get_amr_interval::trixi_get_amr_interval(handle)
+    !!
+    !! @brief Return current AMR interval
+    !!
+    !! @param[in]  handle  simulation handle
+    !!
+    !! @return Number of steps between two adaptations
+    !!
+    !! @see @ref trixi_get_amr_interval_api_c "trixi_get_amr_interval (C API)"
+    integer(c_int) function trixi_get_amr_interval(handle) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int
+      integer(c_int), value, intent(in) :: handle
+    end function
+
+    !>
+    !! @fn LibTrixi::trixi_set_straggler_watchdog::trixi_set_straggler_watchdog(handle, interval, threshold, report, userdata)
+    !!
+    !! @brief Enable or disable detection of slow ranks
+    !!
+    !! @param[in]  handle     simulation handle
+    !! @param[in]  interval   number of steps between checks (disable if not positive)
+    !! @param[in]  threshold  factor of the median compute time above which ranks are
+    !!                        reported
+    !! @param[in]  report     C function pointer to
+    !!                        `subroutine report(rank, compute_time, median_time, userdata)
+    !!                        bind(c)` (may be `c_null_funptr`)
+    !! @param[in]  userdata   pointer passed through to `report`
+    !!
+    !! @see @ref trixi_set_straggler_watchdog_api_c "trixi_set_straggler_watchdog (C API)"
+    subroutine trixi_set_straggler_watchdog(handle, interval, threshold, report, userdata) &
+      bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int, c_double, c_funptr, c_ptr
+      integer(c_int), value, intent(in) :: handle
+      integer(c_int), value, intent(in) :: interval
+      real(c_double), value, intent(in) :: threshold
+      type(c_funptr), value, intent(in) :: report
+      type(c_ptr), value, intent(in) :: userdata
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_set_preemption_c::trixi_set_preemption_c(handle, walltime_budget, handle_signals, checkpoint_directory)
+    !!
+    !! @brief Stop the simulation with a checkpoint before it is preempted (C char pointer
+    !!        version)
+    !!
+    !! @param[in]  handle                simulation handle
+    !! @param[in]  walltime_budget       available wall time in seconds (ignored if not
+    !!                                   positive)
+    !! @param[in]  handle_signals        stop on SIGTERM or SIGUSR1 if nonzero
+    !! @param[in]  checkpoint_directory  directory for restart and mesh files
+    !!
+    !! @see @ref trixi_set_preemption
+    !!           "trixi_set_preemption (Fortran convenience version)"
+    !! @see @ref trixi_set_preemption_api_c
+    !!           "trixi_set_preemption (C API)"
+    subroutine trixi_set_preemption_c(handle, walltime_budget, handle_signals, &
+                                      checkpoint_directory) &
+      bind(c, name='trixi_set_preemption')
+      use, intrinsic :: iso_c_binding, only: c_char, c_int, c_double
+      integer(c_int), value, intent(in) :: handle
+      real(c_double), value, intent(in) :: walltime_budget
+      integer(c_int), value, intent(in) :: handle_signals
+      character(kind=c_char), dimension(*), intent(in) :: checkpoint_directory
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_set_health_check::trixi_set_health_check(handle, interval, action, nreport)
+    !!
+    !! @brief Check the solution for non-finite or non-physical values
+    !!
+    !! @param[in]  handle    simulation handle
+    !! @param[in]  interval  number of steps between two checks (disabled if not positive)
+    !! @param[in]  action    action on failure, one of `TRIXI_HEALTH_{REPORT,STOP,ROLLBACK}`
+    !! @param[in]  nreport   maximum number of offending elements reported per rank, positive
+    !!
+    !! @see @ref trixi_set_health_check_api_c "trixi_set_health_check (C API)"
+    subroutine trixi_set_health_check(handle, interval, action, nreport) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int
+      integer(c_int), value, intent(in) :: handle
+      integer(c_int), value, intent(in) :: interval
+      integer(c_int), value, intent(in) :: action
+      integer(c_int), value, intent(in) :: nreport
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_get_health_status::trixi_get_health_status(handle)
+    !!
+    !! @brief Return the status found by the first failed health check
+    !!
+    !! @param[in]  handle  simulation handle
+    !!
+    !! @return One of `TRIXI_HEALTH_{OK,PRESSURE,DENSITY,NONFINITE}`
+    !!
+    !! @see @ref trixi_get_health_status_api_c "trixi_get_health_status (C API)"
+    integer(c_int) function trixi_get_health_status(handle) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int
+      integer(c_int), value, intent(in) :: handle
+    end function
+
+    !>
+    !! @fn LibTrixi::trixi_set_energy_accounting::trixi_set_energy_accounting(handle, enabled)
+    !!
+    !! @brief Enable or disable energy accounting for each step
+    !!
+    !! @param[in]  handle   simulation handle
+    !! @param[in]  enabled  measure energy if nonzero
+    !!
+    !! @see @ref trixi_set_energy_accounting_api_c "trixi_set_energy_accounting (C API)"
+    subroutine trixi_set_energy_accounting(handle, enabled) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int
+      integer(c_int), value, intent(in) :: handle
+      integer(c_int), value, intent(in) :: enabled
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_get_energy_stats::trixi_get_energy_stats(handle, energy, energy_per_step, energy_per_dof_update)
+    !!
+    !! @brief Return energy consumption since energy accounting was enabled
+    !!
+    !! @param[in]  handle                 simulation handle
+    !! @param[out] energy                 total energy in joules
+    !! @param[out] energy_per_step        energy per step in joules
+    !! @param[out] energy_per_dof_update  energy per degree of freedom and step in joules
+    !!
+    !! @return 1 if energy counters are available, 0 if not
+    !!
+    !! @see @ref trixi_get_energy_stats_api_c "trixi_get_energy_stats (C API)"
+    integer(c_int) function trixi_get_energy_stats(handle, energy, energy_per_step, &
+                                                   energy_per_dof_update) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int, c_double
+      integer(c_int), value, intent(in) :: handle
+      real(c_double), intent(out) :: energy
+      real(c_double), intent(out) :: energy_per_step
+      real(c_double), intent(out) :: energy_per_dof_update
+    end function
+
+    !>
+    !! @fn LibTrixi::trixi_place_numa::trixi_place_numa(handle)
+    !!
+    !! @brief Place simulation data on the NUMA nodes of the threads processing it
+    !!
+    !! @param[in]  handle  simulation handle
+    !!
+    !! @see @ref trixi_place_numa_api_c "trixi_place_numa (C API)"
+    subroutine trixi_place_numa(handle) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int
+      integer(c_int), value, intent(in) :: handle
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_get_numa_placement::trixi_get_numa_placement(handle, nnodes, pages, local_fraction)
+    !!
+    !! @brief Return NUMA placement statistics of simulation data
+    !!
+    !! @param[in]  handle          simulation handle
+    !! @param[in]  nnodes          size of pages, may be 0 to query the number of nodes
+    !! @param[out] pages           number of pages on each of the first nnodes NUMA nodes
+    !! @param[out] local_fraction  fraction of pages on the node of the processing thread
+    !!
+    !! @return Number of NUMA nodes holding pages (0 without NUMA support)
+    !!
+    !! @see @ref trixi_get_numa_placement_api_c "trixi_get_numa_placement (C API)"
+    integer(c_int) function trixi_get_numa_placement(handle, nnodes, pages, &
+                                                     local_fraction) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int, c_double
+      integer(c_int), value, intent(in) :: handle
+      integer(c_int), value, intent(in) :: nnodes
+      integer(c_int), dimension(*), intent(out) :: pages
+      real(c_double), intent(out) :: local_fraction
+    end function
+
+    !>
+    !! @fn LibTrixi::trixi_set_deferred_teardown::trixi_set_deferred_teardown(enabled, batch_size)
+    !!
+    !! @brief Defer teardown of finalized simulations
+    !!
+    !! @param[in]  enabled     defer teardown if nonzero, free memory at each finalization
+    !!                         if 0
+    !! @param[in]  batch_size  number of finalized simulations that are released together,
+    !!                         only on request if not positive
+    !!
+    !! @see @ref trixi_set_deferred_teardown_api_c "trixi_set_deferred_teardown (C API)"
+    subroutine trixi_set_deferred_teardown(enabled, batch_size) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int
+      integer(c_int), value, intent(in) :: enabled
+      integer(c_int), value, intent(in) :: batch_size
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_collect_garbage::trixi_collect_garbage()
+    !!
+    !! @brief Free memory of finalized simulations
+    !!
+    !! @see @ref trixi_collect_garbage_api_c "trixi_collect_garbage (C API)"
+    subroutine trixi_collect_garbage() bind(c)
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_set_background_compilation_c::trixi_set_background_compilation_c(trace_directory)
+    !!
+    !! @brief Compile methods of a simulation in the background during its setup (C char
+    !!        pointer version)
+    !!
+    !! @param[in]  trace_directory  directory for the trace files, disables background
+    !!                              compilation if empty
+    !!
+    !! @see @ref trixi_set_background_compilation
+    !!           "trixi_set_background_compilation (Fortran convenience version)"
+    !! @see @ref trixi_set_background_compilation_api_c
+    !!           "trixi_set_background_compilation (C API)"
+    subroutine trixi_set_background_compilation_c(trace_directory) &
+      bind(c, name='trixi_set_background_compilation')
+      use, intrinsic :: iso_c_binding, only: c_char
+      character(kind=c_char), dimension(*), intent(in) :: trace_directory
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_create_ensemble::trixi_create_ensemble(handle, nmembers)
+    !!
+    !! @brief Create an ensemble of copies of a simulation
+    !!
+    !! @param[in]  handle    simulation handle
+    !! @param[in]  nmembers  number of ensemble members
+    !!
+    !! @return handle to the ensemble
+    !!
+    !! @see @ref trixi_create_ensemble_api_c "trixi_create_ensemble (C API)"
+    integer(c_int) function trixi_create_ensemble(handle, nmembers) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int
+      integer(c_int), value, intent(in) :: handle
+      integer(c_int), value, intent(in) :: nmembers
+    end function
+
+    !>
+    !! @fn LibTrixi::trixi_reinitialize::trixi_reinitialize(handle, t0, tend)
+    !!
+    !! @brief Restart simulation from the initial condition
+    !!
+    !! @param[in]  handle  simulation handle
+    !! @param[in]  t0      new initial time
+    !! @param[in]  tend    new final time
+    !!
+    !! @see @ref trixi_reinitialize_api_c "trixi_reinitialize (C API)"
+    subroutine trixi_reinitialize(handle, t0, tend) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int, c_double
+      integer(c_int), value, intent(in) :: handle
+      real(c_double), value, intent(in) :: t0
+      real(c_double), value, intent(in) :: tend
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_set_initial_state::trixi_set_initial_state(handle, t0, tend, data)
+    !!
+    !! @brief Restart simulation from given conservative variables
+    !!
+    !! @param[in]  handle  simulation handle
+    !! @param[in]  t0      new initial time
+    !! @param[in]  tend    new final time
+    !! @param[in]  data    conservative variables, of size ndofs * nvariables
+    !!
+    !! @see @ref trixi_set_initial_state_api_c "trixi_set_initial_state (C API)"
+    subroutine trixi_set_initial_state(handle, t0, tend, data) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int, c_double
+      integer(c_int), value, intent(in) :: handle
+      real(c_double), value, intent(in) :: t0
+      real(c_double), value, intent(in) :: tend
+      real(c_double), dimension(*), intent(in) :: data
+    end subroutine
+
     !>
     !! @fn LibTrixi::trixi_finalize_simulation::trixi_finalize_simulation(handle)
     !!
@@ -323,6 +734,19 @@ module LibTrixi
       integer(c_int), value, intent(in) :: handle
     end function
 
+    !>
+    !! @fn LibTrixi::trixi_nmembers::trixi_nmembers(handle)
+    !!
+    !! @brief Return number of ensemble members (1 if the simulation is not an ensemble)
+    !!
+    !! @param[in]  handle  simulation handle
+    !!
+    !! @see @ref trixi_nmembers_api_c "trixi_nmembers (C API)"
+    integer(c_int) function trixi_nmembers(handle) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int
+      integer(c_int), value, intent(in) :: handle
+    end function
+
     !>
     !! @fn LibTrixi::trixi_nnodes::trixi_nnodes(handle)
     !!
@@ -391,6 +815,59 @@ module LibTrixi
       real(c_double), dimension(*), intent(out) :: data
     end subroutine
 
+    !>
+    !! @fn LibTrixi::trixi_load_primitive_vars_f32::trixi_load_primitive_vars_f32(handle, variable_id, data)
+    !!
+    !! @brief Load primitive variable in single precision
+    !!
+    !! @param[in]  handle       simulation handle
+    !! @param[in]  variable_id  index of variable
+    !! @param[out] data         primitive variable values for all degrees of freedom
+    !!
+    !! @see @ref trixi_load_primitive_vars_f32_api_c "trixi_load_primitive_vars_f32 (C API)"
+    subroutine trixi_load_primitive_vars_f32(handle, variable_id, data) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int, c_float
+      integer(c_int), value, intent(in) :: handle
+      integer(c_int), value, intent(in) :: variable_id
+      real(c_float), dimension(*), intent(out) :: data
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_load_member_primitive_vars::trixi_load_member_primitive_vars(handle, member, variable_id, data)
+    !!
+    !! @brief Load primitive variable of a single ensemble member
+    !!
+    !! @param[in]  handle       simulation handle
+    !! @param[in]  member       index of ensemble member
+    !! @param[in]  variable_id  index of variable
+    !! @param[out] data         primitive variable values for all degrees of freedom
+    !!
+    !! @see @ref trixi_load_member_primitive_vars_api_c "trixi_load_member_primitive_vars (C API)"
+    subroutine trixi_load_member_primitive_vars(handle, member, variable_id, data) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int, c_double
+      integer(c_int), value, intent(in) :: handle
+      integer(c_int), value, intent(in) :: member
+      integer(c_int), value, intent(in) :: variable_id
+      real(c_double), dimension(*), intent(out) :: data
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_store_member_conservative_vars::trixi_store_member_conservative_vars(handle, member, data)
+    !!
+    !! @brief Set conservative variables of a single ensemble member
+    !!
+    !! @param[in]  handle  simulation handle
+    !! @param[in]  member  index of ensemble member
+    !! @param[in]  data    conservative variables for all degrees of freedom
+    !!
+    !! @see @ref trixi_store_member_conservative_vars_api_c "trixi_store_member_conservative_vars (C API)"
+    subroutine trixi_store_member_conservative_vars(handle, member, data) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int, c_double
+      integer(c_int), value, intent(in) :: handle
+      integer(c_int), value, intent(in) :: member
+      real(c_double), dimension(*), intent(in) :: data
+    end subroutine
+
     !>
     !! @fn LibTrixi::trixi_get_simulation_time::trixi_get_simulation_time(handle)
     !!
@@ -423,6 +900,133 @@ module LibTrixi
       real(c_double), dimension(*), intent(out) :: data
     end subroutine
 
+    !>
+    !! @fn LibTrixi::trixi_load_element_averaged_primitive_vars_f32::trixi_load_element_averaged_primitive_vars_f32(handle, variable_id, data)
+    !!
+    !! @brief Load element averages for primitive variable in single precision
+    !!
+    !! @param[in]  handle       simulation handle
+    !! @param[in]  variable_id  index of variable
+    !! @param[out] data         averaged values for all elements
+    !!
+    !! @see @ref trixi_load_element_averaged_primitive_vars_f32_api_c "trixi_load_element_averaged_primitive_vars_f32 (C API)"
+    subroutine trixi_load_element_averaged_primitive_vars_f32(handle, variable_id, data) &
+      bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int, c_float
+      integer(c_int), value, intent(in) :: handle
+      integer(c_int), value, intent(in) :: variable_id
+      real(c_float), dimension(*), intent(out) :: data
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_define_output_variable_c::trixi_define_output_variable_c(handle, name, expression)
+    !!
+    !! @brief Define output variable given by Julia code (C char pointer version)
+    !!
+    !! @param[in]  handle      simulation handle
+    !! @param[in]  name        name of the variable (null-terminated)
+    !! @param[in]  expression  Julia code for the conversion (null-terminated)
+    !!
+    !! @return handle of the output variable
+    !!
+    !! @see @ref trixi_define_output_variable
+    !!           "trixi_define_output_variable (Fortran convenience version)"
+    !! @see @ref trixi_define_output_variable_api_c
+    !!           "trixi_define_output_variable (C API)"
+    integer(c_int) function trixi_define_output_variable_c(handle, name, expression) &
+      bind(c, name='trixi_define_output_variable')
+      use, intrinsic :: iso_c_binding, only: c_char, c_int
+      integer(c_int), value, intent(in) :: handle
+      character(kind=c_char), dimension(*), intent(in) :: name
+      character(kind=c_char), dimension(*), intent(in) :: expression
+    end function
+
+    !>
+    !! @fn LibTrixi::trixi_define_output_variable_callback_c::trixi_define_output_variable_callback_c(handle, name, func, userdata)
+    !!
+    !! @brief Define output variable given by a C function (C char pointer version)
+    !!
+    !! @param[in]  handle    simulation handle
+    !! @param[in]  name      name of the variable (null-terminated)
+    !! @param[in]  func      C function pointer to `real(c_double) function func(u,
+    !!                       nvariables, userdata) bind(c)`
+    !! @param[in]  userdata  pointer passed through to `func`
+    !!
+    !! @return handle of the output variable
+    !!
+    !! @see @ref trixi_define_output_variable_callback
+    !!           "trixi_define_output_variable_callback (Fortran convenience version)"
+    !! @see @ref trixi_define_output_variable_callback_api_c
+    !!           "trixi_define_output_variable_callback (C API)"
+    integer(c_int) function trixi_define_output_variable_callback_c(handle, name, func, &
+                                                                    userdata) &
+      bind(c, name='trixi_define_output_variable_callback')
+      use, intrinsic :: iso_c_binding, only: c_char, c_int, c_funptr, c_ptr
+      integer(c_int), value, intent(in) :: handle
+      character(kind=c_char), dimension(*), intent(in) :: name
+      type(c_funptr), value, intent(in) :: func
+      type(c_ptr), value, intent(in) :: userdata
+    end function
+
+    !>
+    !! @fn LibTrixi::trixi_load_variable::trixi_load_variable(handle, variable_handle, data)
+    !!
+    !! @brief Load output variable
+    !!
+    !! @param[in]  handle           simulation handle
+    !! @param[in]  variable_handle  handle of the output variable
+    !! @param[out] data             values for all degrees of freedom
+    !!
+    !! @see @ref trixi_load_variable_api_c "trixi_load_variable (C API)"
+    subroutine trixi_load_variable(handle, variable_handle, data) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int, c_double
+      integer(c_int), value, intent(in) :: handle
+      integer(c_int), value, intent(in) :: variable_handle
+      real(c_double), dimension(*), intent(out) :: data
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_set_element_ordering::trixi_set_element_ordering(handle, nelements, ordering)
+    !!
+    !! @brief Set the order of elements in all data exchanged with the host
+    !!
+    !! @param[in]  handle     simulation handle
+    !! @param[in]  nelements  number of local elements
+    !! @param[in]  ordering   position of each element in host data (starting at 1)
+    !!
+    !! @see @ref trixi_set_element_ordering_api_c "trixi_set_element_ordering (C API)"
+    subroutine trixi_set_element_ordering(handle, nelements, ordering) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int
+      integer(c_int), value, intent(in) :: handle
+      integer(c_int), value, intent(in) :: nelements
+      integer(c_int), dimension(*), intent(in) :: ordering
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_foreach_element_block::trixi_foreach_element_block(handle, block_size, nvars, variable_ids, callback, userdata)
+    !!
+    !! @brief Stream primitive variables in blocks of elements to a callback
+    !!
+    !! @param[in]  handle        simulation handle
+    !! @param[in]  block_size    maximum number of elements per block
+    !! @param[in]  nvars         number of variables
+    !! @param[in]  variable_ids  indices of primitive variables
+    !! @param[in]  callback      C function pointer to `subroutine callback(element_offset,
+    !!                           nelements, data, userdata) bind(c)`
+    !! @param[in]  userdata      pointer passed through to `callback`
+    !!
+    !! @see @ref trixi_foreach_element_block_api_c "trixi_foreach_element_block (C API)"
+    subroutine trixi_foreach_element_block(handle, block_size, nvars, variable_ids, &
+                                           callback, userdata) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int, c_funptr, c_ptr
+      integer(c_int), value, intent(in) :: handle
+      integer(c_int), value, intent(in) :: block_size
+      integer(c_int), value, intent(in) :: nvars
+      integer(c_int), dimension(*), intent(in) :: variable_ids
+      type(c_funptr), value, intent(in) :: callback
+      type(c_ptr), value, intent(in) :: userdata
+    end subroutine
+
     !>
     !! @fn LibTrixi::trixi_register_data::trixi_register_data(handle, variable_id, data)
     !!
@@ -442,6 +1046,256 @@ module LibTrixi
       real(c_double), dimension(*), intent(in) :: data
     end subroutine
 
+    !>
+    !! @fn LibTrixi::trixi_register_data_f32::trixi_register_data_f32(handle, index, size, data)
+    !!
+    !! @brief Store single precision data vector in current simulation's registry
+    !!
+    !! @param[in]  handle  simulation handle
+    !! @param[in]  index   index in registry where data vector will be stored
+    !! @param[in]  size    size of given data vector
+    !! @param[in]  data    data vector to store
+    !!
+    !! @see @ref trixi_register_data_f32_api_c "trixi_register_data_f32 (C API)"
+    subroutine trixi_register_data_f32(handle, index, size, data) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int, c_float
+      integer(c_int), value, intent(in) :: handle
+      integer(c_int), value, intent(in) :: index
+      integer(c_int), value, intent(in) :: size
+      real(c_float), dimension(*), intent(in) :: data
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_set_buffer_storage_c::trixi_set_buffer_storage_c(handle, directory, access_hint)
+    !!
+    !! @brief Place library-managed buffers in file-backed memory maps (C char pointer
+    !!        version)
+    !!
+    !! @param[in]  handle       simulation handle
+    !! @param[in]  directory    directory for the mapped files, empty for regular memory
+    !! @param[in]  access_hint  access hint passed to madvise, e.g., TRIXI_ACCESS_RANDOM
+    !!
+    !! @see @ref trixi_set_buffer_storage
+    !!           "trixi_set_buffer_storage (Fortran convenience version)"
+    !! @see @ref trixi_set_buffer_storage_api_c
+    !!           "trixi_set_buffer_storage (C API)"
+    subroutine trixi_set_buffer_storage_c(handle, directory, access_hint) &
+      bind(c, name='trixi_set_buffer_storage')
+      use, intrinsic :: iso_c_binding, only: c_char, c_int
+      integer(c_int), value, intent(in) :: handle
+      character(kind=c_char), dimension(*), intent(in) :: directory
+      integer(c_int), value, intent(in) :: access_hint
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_allocate_data::trixi_allocate_data(handle, index, size)
+    !!
+    !! @brief Allocate data vector in current simulation's registry
+    !!
+    !! @param[in]  handle  simulation handle
+    !! @param[in]  index   index in registry where data vector will be stored
+    !! @param[in]  size    size of data vector
+    !!
+    !! @return Pointer to the data vector, see `c_f_pointer`
+    !!
+    !! @see @ref trixi_allocate_data_api_c "trixi_allocate_data (C API)"
+    type(c_ptr) function trixi_allocate_data(handle, index, size) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int, c_ptr
+      integer(c_int), value, intent(in) :: handle
+      integer(c_int), value, intent(in) :: index
+      integer(c_int), value, intent(in) :: size
+    end function
+
+
+
+    !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+    !! Simulation output                                                                  !!
+    !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+    !>
+    !! @fn LibTrixi::trixi_save_vtkhdf_c::trixi_save_vtkhdf_c(handle, filename)
+    !!
+    !! @brief Write current solution to a VTKHDF file (C char pointer version)
+    !!
+    !! @param[in]  handle    simulation handle
+    !! @param[in]  filename  path of the file to be written (C char pointer)
+    !!
+    !! @see @ref trixi_save_vtkhdf       "trixi_save_vtkhdf (Fortran convenience version)"
+    !! @see @ref trixi_save_vtkhdf_api_c "trixi_save_vtkhdf (C API)"
+    subroutine trixi_save_vtkhdf_c(handle, filename) bind(c, name='trixi_save_vtkhdf')
+      use, intrinsic :: iso_c_binding, only: c_int, c_char
+      integer(c_int), value, intent(in) :: handle
+      character(kind=c_char), dimension(*), intent(in) :: filename
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_set_output_aggregation::trixi_set_output_aggregation(handle, enabled)
+    !!
+    !! @brief Enable or disable node-aggregated output
+    !!
+    !! @param[in]  handle   simulation handle
+    !! @param[in]  enabled  aggregate output if nonzero
+    !!
+    !! @see @ref trixi_set_output_aggregation_api_c "trixi_set_output_aggregation (C API)"
+    subroutine trixi_set_output_aggregation(handle, enabled) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int
+      integer(c_int), value, intent(in) :: handle
+      integer(c_int), value, intent(in) :: enabled
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_set_shm_publication_c::trixi_set_shm_publication_c(handle, name, interval, nvars, variable_ids, nslots)
+    !!
+    !! @brief Publish snapshots of the solution to shared memory (C char pointer version)
+    !!
+    !! @param[in]  handle        simulation handle
+    !! @param[in]  name          name of the segment (C char pointer)
+    !! @param[in]  interval      number of steps between snapshots, disabled if not positive
+    !! @param[in]  nvars         number of variables
+    !! @param[in]  variable_ids  indices of primitive variables
+    !! @param[in]  nslots        number of snapshots kept in the segment
+    !!
+    !! @see @ref trixi_set_shm_publication
+    !!           "trixi_set_shm_publication (Fortran convenience version)"
+    !! @see @ref trixi_set_shm_publication_api_c "trixi_set_shm_publication (C API)"
+    subroutine trixi_set_shm_publication_c(handle, name, interval, nvars, variable_ids, &
+                                           nslots) bind(c, name='trixi_set_shm_publication')
+      use, intrinsic :: iso_c_binding, only: c_int, c_char
+      integer(c_int), value, intent(in) :: handle
+      character(kind=c_char), dimension(*), intent(in) :: name
+      integer(c_int), value, intent(in) :: interval
+      integer(c_int), value, intent(in) :: nvars
+      integer(c_int), dimension(*), intent(in) :: variable_ids
+      integer(c_int), value, intent(in) :: nslots
+    end subroutine
+
+
+
+    !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+    !! Nesting                                                                            !!
+    !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+    !>
+    !! @fn LibTrixi::trixi_create_nesting::trixi_create_nesting(parent_handle, child_handle, relaxation_width, feedback_weight)
+    !!
+    !! @brief Couple a child simulation to a parent simulation
+    !!
+    !! @param[in]  parent_handle     simulation handle of the parent simulation
+    !! @param[in]  child_handle      simulation handle of the child simulation
+    !! @param[in]  relaxation_width  width of the relaxation zone (positive)
+    !! @param[in]  feedback_weight   weight of the child solution in the feedback
+    !!
+    !! @return handle to the nesting
+    !!
+    !! @see @ref trixi_create_nesting_api_c "trixi_create_nesting (C API)"
+    integer(c_int) function trixi_create_nesting(parent_handle, child_handle, &
+                                                 relaxation_width, feedback_weight) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int, c_double
+      integer(c_int), value, intent(in) :: parent_handle
+      integer(c_int), value, intent(in) :: child_handle
+      real(c_double), value, intent(in) :: relaxation_width
+      real(c_double), value, intent(in) :: feedback_weight
+    end function
+
+    !>
+    !! @fn LibTrixi::trixi_nesting_interpolate::trixi_nesting_interpolate(nesting_handle)
+    !!
+    !! @brief Interpolate parent solution to the child relaxation zone
+    !!
+    !! @param[in]  nesting_handle  nesting handle
+    !!
+    !! @see @ref trixi_nesting_interpolate_api_c "trixi_nesting_interpolate (C API)"
+    subroutine trixi_nesting_interpolate(nesting_handle) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int
+      integer(c_int), value, intent(in) :: nesting_handle
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_nesting_feedback::trixi_nesting_feedback(nesting_handle)
+    !!
+    !! @brief Feed child solution back to the parent simulation
+    !!
+    !! @param[in]  nesting_handle  nesting handle
+    !!
+    !! @see @ref trixi_nesting_feedback_api_c "trixi_nesting_feedback (C API)"
+    subroutine trixi_nesting_feedback(nesting_handle) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int
+      integer(c_int), value, intent(in) :: nesting_handle
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_finalize_nesting::trixi_finalize_nesting(nesting_handle)
+    !!
+    !! @brief Release a nesting
+    !!
+    !! @param[in]  nesting_handle  nesting handle
+    !!
+    !! @see @ref trixi_finalize_nesting_api_c "trixi_finalize_nesting (C API)"
+    subroutine trixi_finalize_nesting(nesting_handle) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int
+      integer(c_int), value, intent(in) :: nesting_handle
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_transfer_solution::trixi_transfer_solution(src_handle, dst_handle, l2_projection)
+    !!
+    !! @brief Transfer the solution of one simulation to another one on a different mesh
+    !!
+    !! @param[in]  src_handle     handle of the source simulation
+    !! @param[in]  dst_handle     handle of the destination simulation
+    !! @param[in]  l2_projection  L2-project instead of interpolating if nonzero
+    !!
+    !! @see @ref trixi_transfer_solution_api_c "trixi_transfer_solution (C API)"
+    subroutine trixi_transfer_solution(src_handle, dst_handle, l2_projection) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int
+      integer(c_int), value, intent(in) :: src_handle
+      integer(c_int), value, intent(in) :: dst_handle
+      integer(c_int), value, intent(in) :: l2_projection
+    end subroutine
+
+
+
+    !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+    !! Logging                                                                            !!
+    !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+    !>
+    !! @fn LibTrixi::trixi_set_log_sink::trixi_set_log_sink(sink, userdata, min_level, rank_stride, json)
+    !!
+    !! @brief Route all output through a user-provided sink
+    !!
+    !! @param[in]  sink         C function pointer to `subroutine sink(level, message,
+    !!                          userdata) bind(c)` (may be `c_null_funptr`), where `message`
+    !!                          is a null-terminated C string
+    !! @param[in]  userdata     pointer passed through to `sink`
+    !! @param[in]  min_level    minimum level of messages passed to `sink`
+    !! @param[in]  rank_stride  only every `rank_stride`-th rank emits messages (root only
+    !!                          if 0)
+    !! @param[in]  json         format messages as JSON lines if nonzero
+    !!
+    !! @see @ref trixi_set_log_sink_api_c "trixi_set_log_sink (C API)"
+    subroutine trixi_set_log_sink(sink, userdata, min_level, rank_stride, json) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_int, c_funptr, c_ptr
+      type(c_funptr), value, intent(in) :: sink
+      type(c_ptr), value, intent(in) :: userdata
+      integer(c_int), value, intent(in) :: min_level
+      integer(c_int), value, intent(in) :: rank_stride
+      integer(c_int), value, intent(in) :: json
+    end subroutine
+
+    !>
+    !! @fn LibTrixi::trixi_log_message_c::trixi_log_message_c(level, message)
+    !!
+    !! @brief Emit a message through the log sink (C char pointer version)
+    !!
+    !! @param[in]  level    message level
+    !! @param[in]  message  message (C char pointer)
+    !!
+    !! @see @ref trixi_log_message       "trixi_log_message (Fortran convenience version)"
+    !! @see @ref trixi_log_message_api_c "trixi_log_message (C API)"
+    subroutine trixi_log_message_c(level, message) bind(c, name='trixi_log_message')
+      use, intrinsic :: iso_c_binding, only: c_int, c_char
+      integer(c_int), value, intent(in) :: level
+      character(kind=c_char), dimension(*), intent(in) :: message
+    end subroutine
+
 
 
     !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -468,6 +1322,26 @@ module LibTrixi
     !! Misc                                                                               !!
     !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
+    !>
+    !! @fn LibTrixi::trixi_set_allocator::trixi_set_allocator(alloc_fn, free_fn, userdata)
+    !!
+    !! @brief Allocate library-managed buffers with a host allocator
+    !!
+    !! @param[in]  alloc_fn  C function pointer to `type(c_ptr) function alloc_fn(size,
+    !!                       userdata) bind(c)` with `size` of kind `c_size_t` (may be
+    !!                       `c_null_funptr` to use Julia's allocator again)
+    !! @param[in]  free_fn   C function pointer to `subroutine free_fn(ptr, userdata)
+    !!                       bind(c)`
+    !! @param[in]  userdata  pointer passed through to `alloc_fn` and `free_fn`
+    !!
+    !! @see @ref trixi_set_allocator_api_c "trixi_set_allocator (C API)"
+    subroutine trixi_set_allocator(alloc_fn, free_fn, userdata) bind(c)
+      use, intrinsic :: iso_c_binding, only: c_funptr, c_ptr
+      type(c_funptr), value, intent(in) :: alloc_fn
+      type(c_funptr), value, intent(in) :: free_fn
+      type(c_ptr), value, intent(in) :: userdata
+    end subroutine
+
     !>
     !! @fn LibTrixi::trixi_eval_julia_c::trixi_eval_julia_c(code)
     !!
@@ -615,6 +1489,51 @@ module LibTrixi
     trixi_initialize_simulation = trixi_initialize_simulation_c(trim(adjustl(libelixir)) // c_null_char)
   end function
 
+  !>
+  !! @brief Set up Trixi simulation in single precision (Fortran convenience version)
+  !!
+  !! @param[in]  libelixir     Path to libelexir file.
+  !! @param[in]  geometry_f64  keep geometry in double precision
+  !!
+  !! @return handle (integer) to Trixi simulation instance
+  !!
+  !! @see @ref trixi_initialize_simulation_f32_c::trixi_initialize_simulation_f32_c
+  !!           "trixi_initialize_simulation_f32_c (C char pointer version)"
+  !! @see @ref trixi_initialize_simulation_f32_api_c
+  !!           "trixi_initialize_simulation_f32 (C API)"
+  integer(c_int) function trixi_initialize_simulation_f32(libelixir, geometry_f64)
+    use, intrinsic :: iso_c_binding, only: c_int, c_null_char
+    character(len=*), intent(in) :: libelixir
+    logical, intent(in) :: geometry_f64
+    integer(c_int) :: geometry_f64_c
+
+    geometry_f64_c = 0
+    if (geometry_f64) geometry_f64_c = 1
+    trixi_initialize_simulation_f32 = &
+      trixi_initialize_simulation_f32_c(trim(adjustl(libelixir)) // c_null_char, &
+                                        geometry_f64_c)
+  end function
+
+  !>
+  !! @brief Return the wall time of an initialization phase (Fortran convenience version)
+  !!
+  !! @param[in]  handle  simulation handle
+  !! @param[in]  phase   name of the phase
+  !!
+  !! @return wall time of the phase in seconds on this rank, NaN if it was not recorded
+  !!
+  !! @see @ref trixi_get_setup_time_c::trixi_get_setup_time_c
+  !!           "trixi_get_setup_time_c (C char pointer version)"
+  !! @see @ref trixi_get_setup_time_api_c
+  !!           "trixi_get_setup_time (C API)"
+  real(c_double) function trixi_get_setup_time(handle, phase)
+    use, intrinsic :: iso_c_binding, only: c_int, c_double, c_null_char
+    integer(c_int), intent(in) :: handle
+    character(len=*), intent(in) :: phase
+
+    trixi_get_setup_time = trixi_get_setup_time_c(handle, trim(adjustl(phase)) // c_null_char)
+  end function
+
   !>
   !! @brief Check if simulation is finished (Fortran convenience version)
   !!
@@ -633,6 +1552,207 @@ module LibTrixi
     trixi_is_finished = trixi_is_finished_c(handle) == 1
   end function
 
+  !>
+  !! @brief Check if simulation was stopped by preemption (Fortran convenience version)
+  !!
+  !! @param[in]  handle  simulation handle
+  !!
+  !! @return true if preempted, false if not
+  !!
+  !! @see @ref trixi_is_preempted_c::trixi_is_preempted_c
+  !!           "trixi_is_preempted (C integer version)"
+  !! @see @ref trixi_is_preempted_api_c
+  !!           "trixi_is_preempted (C API)"
+  logical function trixi_is_preempted(handle)
+    use, intrinsic :: iso_c_binding, only: c_int
+    integer(c_int), intent(in) :: handle
+
+    trixi_is_preempted = trixi_is_preempted_c(handle) == 1
+  end function
+
+  !>
+  !! @brief Stop the simulation with a checkpoint before it is preempted (Fortran
+  !!        convenience version)
+  !!
+  !! @param[in]  handle                simulation handle
+  !! @param[in]  walltime_budget       available wall time in seconds (ignored if not
+  !!                                   positive)
+  !! @param[in]  handle_signals        stop on SIGTERM or SIGUSR1
+  !! @param[in]  checkpoint_directory  directory for restart and mesh files
+  !!
+  !! @see @ref trixi_set_preemption_c::trixi_set_preemption_c
+  !!           "trixi_set_preemption_c (C char pointer version)"
+  !! @see @ref trixi_set_preemption_api_c
+  !!           "trixi_set_preemption (C API)"
+  subroutine trixi_set_preemption(handle, walltime_budget, handle_signals, &
+                                  checkpoint_directory)
+    use, intrinsic :: iso_c_binding, only: c_int, c_double, c_null_char
+    integer(c_int), intent(in) :: handle
+    real(c_double), intent(in) :: walltime_budget
+    logical, intent(in) :: handle_signals
+    character(len=*), intent(in) :: checkpoint_directory
+    integer(c_int) :: handle_signals_c
+
+    handle_signals_c = 0
+    if (handle_signals) handle_signals_c = 1
+    call trixi_set_preemption_c(handle, walltime_budget, handle_signals_c, &
+                                trim(adjustl(checkpoint_directory)) // c_null_char)
+  end subroutine
+
+  !>
+  !! @brief Compile methods of a simulation in the background during its setup (Fortran
+  !!        convenience version)
+  !!
+  !! @param[in]  trace_directory  directory for the trace files, disables background
+  !!                              compilation if empty
+  !!
+  !! @see @ref trixi_set_background_compilation_c::trixi_set_background_compilation_c
+  !!           "trixi_set_background_compilation_c (C char pointer version)"
+  !! @see @ref trixi_set_background_compilation_api_c
+  !!           "trixi_set_background_compilation (C API)"
+  subroutine trixi_set_background_compilation(trace_directory)
+    use, intrinsic :: iso_c_binding, only: c_null_char
+    character(len=*), intent(in) :: trace_directory
+
+    call trixi_set_background_compilation_c(trim(adjustl(trace_directory)) // c_null_char)
+  end subroutine
+
+  !>
+  !! @brief Place library-managed buffers in file-backed memory maps (Fortran convenience
+  !!        version)
+  !!
+  !! @param[in]  handle       simulation handle
+  !! @param[in]  directory    directory for the mapped files, empty for regular memory
+  !! @param[in]  access_hint  access hint passed to madvise, e.g., TRIXI_ACCESS_RANDOM
+  !!
+  !! @see @ref trixi_set_buffer_storage_c::trixi_set_buffer_storage_c
+  !!           "trixi_set_buffer_storage_c (C char pointer version)"
+  !! @see @ref trixi_set_buffer_storage_api_c
+  !!           "trixi_set_buffer_storage (C API)"
+  subroutine trixi_set_buffer_storage(handle, directory, access_hint)
+    use, intrinsic :: iso_c_binding, only: c_int, c_null_char
+    integer(c_int), intent(in) :: handle
+    character(len=*), intent(in) :: directory
+    integer(c_int), intent(in) :: access_hint
+
+    call trixi_set_buffer_storage_c(handle, trim(adjustl(directory)) // c_null_char, &
+                                    access_hint)
+  end subroutine
+
+  !>
+  !! @brief Write current solution to a VTKHDF file (Fortran convenience version)
+  !!
+  !! @param[in]  handle    simulation handle
+  !! @param[in]  filename  path of the file to be written (Fortran string)
+  !!
+  !! @see @ref trixi_save_vtkhdf_c::trixi_save_vtkhdf_c
+  !!           "trixi_save_vtkhdf_c (C char pointer version)"
+  !! @see @ref trixi_save_vtkhdf_api_c
+  !!           "trixi_save_vtkhdf (C API)"
+  subroutine trixi_save_vtkhdf(handle, filename)
+    use, intrinsic :: iso_c_binding, only: c_int, c_null_char
+    integer(c_int), intent(in) :: handle
+    character(len=*), intent(in) :: filename
+
+    call trixi_save_vtkhdf_c(handle, trim(adjustl(filename)) // c_null_char)
+  end subroutine
+
+  !>
+  !! @brief Publish snapshots of the solution to shared memory (Fortran convenience version)
+  !!
+  !! @param[in]  handle        simulation handle
+  !! @param[in]  name          name of the segment (Fortran string)
+  !! @param[in]  interval      number of steps between snapshots, disabled if not positive
+  !! @param[in]  nvars         number of variables
+  !! @param[in]  variable_ids  indices of primitive variables
+  !! @param[in]  nslots        number of snapshots kept in the segment
+  !!
+  !! @see @ref trixi_set_shm_publication_c::trixi_set_shm_publication_c
+  !!           "trixi_set_shm_publication_c (C char pointer version)"
+  !! @see @ref trixi_set_shm_publication_api_c
+  !!           "trixi_set_shm_publication (C API)"
+  subroutine trixi_set_shm_publication(handle, name, interval, nvars, variable_ids, nslots)
+    use, intrinsic :: iso_c_binding, only: c_int, c_null_char
+    integer(c_int), intent(in) :: handle
+    character(len=*), intent(in) :: name
+    integer(c_int), intent(in) :: interval
+    integer(c_int), intent(in) :: nvars
+    integer(c_int), dimension(*), intent(in) :: variable_ids
+    integer(c_int), intent(in) :: nslots
+
+    call trixi_set_shm_publication_c(handle, trim(adjustl(name)) // c_null_char, interval, &
+                                     nvars, variable_ids, nslots)
+  end subroutine
+
+  !>
+  !! @brief Define output variable given by Julia code (Fortran convenience version)
+  !!
+  !! @param[in]  handle      simulation handle
+  !! @param[in]  name        name of the variable (Fortran string)
+  !! @param[in]  expression  Julia code for the conversion (Fortran string)
+  !!
+  !! @return handle of the output variable
+  !!
+  !! @see @ref trixi_define_output_variable_c::trixi_define_output_variable_c
+  !!           "trixi_define_output_variable_c (C char pointer version)"
+  !! @see @ref trixi_define_output_variable_api_c
+  !!           "trixi_define_output_variable (C API)"
+  integer(c_int) function trixi_define_output_variable(handle, name, expression)
+    use, intrinsic :: iso_c_binding, only: c_int, c_null_char
+    integer(c_int), intent(in) :: handle
+    character(len=*), intent(in) :: name
+    character(len=*), intent(in) :: expression
+
+    trixi_define_output_variable = &
+      trixi_define_output_variable_c(handle, trim(adjustl(name)) // c_null_char, &
+                                     trim(expression) // c_null_char)
+  end function
+
+  !>
+  !! @brief Define output variable given by a C function (Fortran convenience version)
+  !!
+  !! @param[in]  handle    simulation handle
+  !! @param[in]  name      name of the variable (Fortran string)
+  !! @param[in]  func      C function pointer to `real(c_double) function func(u,
+  !!                       nvariables, userdata) bind(c)`
+  !! @param[in]  userdata  pointer passed through to `func`
+  !!
+  !! @return handle of the output variable
+  !!
+  !! @see @ref trixi_define_output_variable_callback_c::trixi_define_output_variable_callback_c
+  !!           "trixi_define_output_variable_callback_c (C char pointer version)"
+  !! @see @ref trixi_define_output_variable_callback_api_c
+  !!           "trixi_define_output_variable_callback (C API)"
+  integer(c_int) function trixi_define_output_variable_callback(handle, name, func, userdata)
+    use, intrinsic :: iso_c_binding, only: c_int, c_null_char, c_funptr, c_ptr
+    integer(c_int), intent(in) :: handle
+    character(len=*), intent(in) :: name
+    type(c_funptr), intent(in) :: func
+    type(c_ptr), intent(in) :: userdata
+
+    trixi_define_output_variable_callback = &
+      trixi_define_output_variable_callback_c(handle, trim(adjustl(name)) // c_null_char, &
+                                              func, userdata)
+  end function
+
+  !>
+  !! @brief Emit a message through the log sink (Fortran convenience version)
+  !!
+  !! @param[in]  level    message level
+  !! @param[in]  message  message (Fortran string)
+  !!
+  !! @see @ref trixi_log_message_c::trixi_log_message_c
+  !!           "trixi_log_message_c (C char pointer version)"
+  !! @see @ref trixi_log_message_api_c
+  !!           "trixi_log_message (C API)"
+  subroutine trixi_log_message(level, message)
+    use, intrinsic :: iso_c_binding, only: c_int, c_null_char
+    integer(c_int), intent(in) :: level
+    character(len=*), intent(in) :: message
+
+    call trixi_log_message_c(level, trim(message) // c_null_char)
+  end subroutine
+
   !>
   !! @brief Execute Julia code (Fortran convenience version)
   !!
@@ -18,9 +18,6 @@ void update_depot_path(const char * project_directory, const char * depot_path)
         // If depot path is provided as an argument, set environment variable
         // JULIA_DEPOT_PATH to it
         setenv("JULIA_DEPOT_PATH", depot_path, 1);
-        if (show_debug_output()) {
-            printf("JULIA_DEPOT_PATH set to \"%s\"\n", depot_path);
-        }
     } else if (getenv("JULIA_DEPOT_PATH") == NULL) {
         // Otherwise, if environment variable is *not* already set, set it to
         // `project_directory` + `default_depot_path`
@@ -45,9 +42,6 @@ void update_depot_path(const char * project_directory, const char * depot_path)
 
         // Set environment variable
         setenv("JULIA_DEPOT_PATH", absolute_path, 1);
-        if (show_debug_output()) {
-            printf("JULIA_DEPOT_PATH set to \"%s\"\n", absolute_path);
-        }
     }
 }
 
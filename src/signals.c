@@ -0,0 +1,129 @@
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "signals.h"
+
+// Batch systems send SIGTERM or SIGUSR1 ahead of ending a job. Julia blocks all of these
+// signals in every thread and receives them with `sigwait` in its own signal listener
+// thread, where SIGTERM exits the process. Therefore, libtrixi owns a thread that waits for
+// them, too, as long as at least one simulation handles signals (see
+// `trixi_set_preemption`). The thread is started before Julia is initialized. On Linux, a
+// process-directed signal is offered to the threads of a process in the order of their
+// creation, such that this thread gets it ahead of Julia's signal listener whenever it is
+// waiting. Otherwise, the signals are left to Julia as before.
+
+
+// State of the signal thread, protected by `mutex`
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t state_changed = PTHREAD_COND_INITIALIZER;
+static pthread_t signal_thread;
+static int started = 0;
+static int watch_count = 0;     // number of simulations that handle signals
+static int waiting = 0;         // whether the thread is (about to be) in `sigwaitinfo`
+static int received = 0;        // last signal received that has not been taken yet
+
+
+static void preemption_signals(sigset_t * signals) {
+    sigemptyset(signals);
+    sigaddset(signals, SIGTERM);
+    sigaddset(signals, SIGUSR1);
+}
+
+
+static void * wait_for_signals(void * unused) {
+    (void) unused;
+
+    sigset_t signals;
+    preemption_signals(&signals);
+
+    pthread_mutex_lock(&mutex);
+    while (1) {
+        while (watch_count == 0) {
+            pthread_cond_wait(&state_changed, &mutex);
+        }
+        waiting = 1;
+        pthread_cond_broadcast(&state_changed);
+        pthread_mutex_unlock(&mutex);
+
+        siginfo_t info;
+        const int signum = sigwaitinfo(&signals, &info);
+
+        pthread_mutex_lock(&mutex);
+        waiting = 0;
+        if (signum < 0) {
+            continue;
+        }
+
+        // The thread is woken up with SIGUSR1 by `trixi_watch_signals` when the last
+        // simulation stops handling signals
+        const int wakeup = info.si_code == SI_TKILL && info.si_pid == getpid();
+        if (wakeup) {
+            continue;
+        }
+        if (watch_count > 0) {
+            received = signum;
+        } else {
+            // No simulation handles signals anymore: send it again, this time to Julia
+            kill(getpid(), signum);
+        }
+    }
+
+    return NULL;
+}
+
+
+void start_signal_thread() {
+    // The thread blocks all signals, such that it only receives the preemption signals
+    // while it waits for them
+    sigset_t all, previous;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &previous);
+
+    const int status = pthread_create(&signal_thread, NULL, wait_for_signals, NULL);
+
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+
+    if (status != 0) {
+        fprintf(stderr, "ERROR in %s:%d (%s): %s\n", __FILE__, __LINE__, __func__,
+                "could not start signal thread");
+        exit(1);
+    }
+    pthread_detach(signal_thread);
+    started = 1;
+}
+
+
+void trixi_watch_signals(int enable) {
+    pthread_mutex_lock(&mutex);
+    if (enable) {
+        watch_count += 1;
+        pthread_cond_broadcast(&state_changed);
+
+        // Only return once the signals are waited for
+        while (started && !waiting) {
+            pthread_cond_wait(&state_changed, &mutex);
+        }
+    } else if (watch_count > 0) {
+        watch_count -= 1;
+        if (watch_count == 0) {
+            received = 0;
+            if (started && waiting) {
+                pthread_kill(signal_thread, SIGUSR1);
+            }
+        }
+    }
+    pthread_mutex_unlock(&mutex);
+}
+
+
+int trixi_take_signal() {
+    pthread_mutex_lock(&mutex);
+    const int signum = received;
+    received = 0;
+    pthread_mutex_unlock(&mutex);
+
+    return signum;
+}
@@ -0,0 +1,16 @@
+#ifndef SIGNALS_H_
+#define SIGNALS_H_
+
+// Start the thread that waits for the preemption signals SIGTERM and SIGUSR1. This has to
+// be called before Julia is initialized (see `signals.c`)
+void start_signal_thread();
+
+// Wait for the preemption signals if `enable` is nonzero, leave them to Julia otherwise.
+// Requests are counted, i.e., each enabling call has to be matched by a disabling one
+void trixi_watch_signals(int enable);
+
+// Return the number of the last preemption signal received and clear it, or 0 if there
+// was none
+int trixi_take_signal();
+
+#endif // SIGNALS_H_
@@ -1,6 +1,8 @@
 #ifndef TRIXI_H_
 #define TRIXI_H_
 
+#include <stddef.h>
+
 /**
  * @addtogroup api_c C API
  * @{
@@ -19,12 +21,56 @@ const char* trixi_version_julia();
 const char* trixi_version_julia_extended();
 
 // Simulation control
+typedef void (*trixi_sync_callback_t)(double time, void * userdata);
+typedef void (*trixi_straggler_callback_t)(int rank, double compute_time, double median_time,
+                                           void * userdata);
 int trixi_initialize_simulation(const char * libelixir);
+int trixi_initialize_simulation_f32(const char * libelixir, int geometry_f64);
+double trixi_get_setup_time(int handle, const char * phase);
+void trixi_reinitialize(int handle, double t0, double tend);
+void trixi_set_initial_state(int handle, double t0, double tend, const double * data);
 void trixi_finalize_simulation(int handle);
 int trixi_is_finished(int handle);
+int trixi_is_preempted(int handle);
 void trixi_step(int handle);
+void trixi_scheduler_run(int nhandles, const int * handles, double sync_interval,
+                         trixi_sync_callback_t coupling, void * userdata);
+void trixi_set_polydeg(int handle, int polydeg);
+void trixi_set_amr_autotuning(int handle, int min_interval, int max_interval,
+                              double target_overhead);
+int trixi_get_amr_interval(int handle);
+void trixi_set_straggler_watchdog(int handle, int interval, double threshold,
+                                  trixi_straggler_callback_t report, void * userdata);
+void trixi_set_preemption(int handle, double walltime_budget, int handle_signals,
+                          const char * checkpoint_directory);
+enum {
+    TRIXI_HEALTH_REPORT = 0,
+    TRIXI_HEALTH_STOP = 1,
+    TRIXI_HEALTH_ROLLBACK = 2
+};
+enum {
+    TRIXI_HEALTH_OK = 0,
+    TRIXI_HEALTH_PRESSURE = 1,
+    TRIXI_HEALTH_DENSITY = 2,
+    TRIXI_HEALTH_NONFINITE = 3
+};
+void trixi_set_health_check(int handle, int interval, int action, int nreport);
+int trixi_get_health_status(int handle);
+void trixi_set_energy_accounting(int handle, int enabled);
+int trixi_get_energy_stats(int handle, double * energy, double * energy_per_step,
+                           double * energy_per_dof_update);
+void trixi_place_numa(int handle);
+int trixi_get_numa_placement(int handle, int nnodes, int * pages, double * local_fraction);
+void trixi_set_deferred_teardown(int enabled, int batch_size);
+void trixi_collect_garbage();
+void trixi_set_background_compilation(const char * trace_directory);
+int trixi_create_ensemble(int handle, int nmembers);
 
 // Simulation data
+typedef void (*trixi_block_callback_t)(int element_offset, int nelements,
+                                       const double * data, void * userdata);
+typedef double (*trixi_output_variable_callback_t)(const double * u, int nvariables,
+                                                   void * userdata);
 int trixi_ndims(int handle);
 int trixi_nelements(int handle);
 int trixi_nelementsglobal(int handle);
@@ -32,14 +78,65 @@ int trixi_ndofs(int handle);
 int trixi_ndofsglobal(int handle);
 int trixi_ndofselement(int handle);
 int trixi_nvariables(int handle);
+int trixi_nmembers(int handle);
 int trixi_nnodes(int handle);
 double trixi_calculate_dt(int handle);
 double trixi_get_simulation_time(int handle);
 void trixi_load_node_reference_coordinates(int handle, double* node_coords);
 void trixi_load_node_weights(int handle, double* node_weights);
 void trixi_load_primitive_vars(int handle, int variable_id, double * data);
+void trixi_load_primitive_vars_f32(int handle, int variable_id, float * data);
+void trixi_load_member_primitive_vars(int handle, int member, int variable_id,
+                                      double * data);
+void trixi_store_member_conservative_vars(int handle, int member, const double * data);
 void trixi_load_element_averaged_primitive_vars(int handle, int variable_id, double * data);
+void trixi_load_element_averaged_primitive_vars_f32(int handle, int variable_id,
+                                                    float * data);
+int trixi_define_output_variable(int handle, const char * name, const char * expression);
+int trixi_define_output_variable_callback(int handle, const char * name,
+                                          trixi_output_variable_callback_t func,
+                                          void * userdata);
+void trixi_load_variable(int handle, int variable_handle, double * data);
+void trixi_set_element_ordering(int handle, int nelements, const int * ordering);
+void trixi_foreach_element_block(int handle, int block_size, int nvars,
+                                 const int * variable_ids, trixi_block_callback_t callback,
+                                 void * userdata);
 void trixi_register_data(int handle, int index, int size, const double * data);
+void trixi_register_data_f32(int handle, int index, int size, const float * data);
+enum {
+    TRIXI_ACCESS_NORMAL = 0,
+    TRIXI_ACCESS_SEQUENTIAL = 1,
+    TRIXI_ACCESS_RANDOM = 2,
+    TRIXI_ACCESS_WILLNEED = 3
+};
+void trixi_set_buffer_storage(int handle, const char * directory, int access_hint);
+double * trixi_allocate_data(int handle, int index, int size);
+
+// Simulation output
+void trixi_save_vtkhdf(int handle, const char * filename);
+void trixi_set_output_aggregation(int handle, int enabled);
+void trixi_set_shm_publication(int handle, const char * name, int interval, int nvars,
+                               const int * variable_ids, int nslots);
+
+// Nesting
+int trixi_create_nesting(int parent_handle, int child_handle, double relaxation_width,
+                         double feedback_weight);
+void trixi_nesting_interpolate(int nesting_handle);
+void trixi_nesting_feedback(int nesting_handle);
+void trixi_finalize_nesting(int nesting_handle);
+void trixi_transfer_solution(int src_handle, int dst_handle, int l2_projection);
+
+// Logging
+enum {
+    TRIXI_LOG_DEBUG = 0,
+    TRIXI_LOG_INFO = 1,
+    TRIXI_LOG_WARNING = 2,
+    TRIXI_LOG_ERROR = 3
+};
+typedef void (*trixi_log_callback_t)(int level, const char * message, void * userdata);
+void trixi_set_log_sink(trixi_log_callback_t sink, void * userdata, int min_level,
+                        int rank_stride, int json);
+void trixi_log_message(int level, const char * message);
 
 // T8code
 #if !defined(T8_H) && !defined(T8_FOREST_GENERAL_H)
@@ -48,6 +145,10 @@ typedef struct t8_forest *t8_forest_t;
 t8_forest_t trixi_get_t8code_forest(int handle);
 
 // Misc
+typedef void * (*trixi_alloc_callback_t)(size_t size, void * userdata);
+typedef void (*trixi_free_callback_t)(void * ptr, void * userdata);
+void trixi_set_allocator(trixi_alloc_callback_t alloc_fn, trixi_free_callback_t free_fn,
+                         void * userdata);
 void trixi_eval_julia(const char * code);
 
 /**
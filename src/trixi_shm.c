@@ -0,0 +1,284 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "trixi_shm.h"
+
+
+// Number of attempts to find a slot that is not being written, before giving up on a
+// publisher that may have been terminated while writing
+static const int max_attempts = 1000000;
+
+
+struct trixi_shm_consumer {
+    char * name;
+    const unsigned char * base;
+    size_t size;
+};
+
+
+// Map the segment `name` read-only, returns 0 on success and -1 with `errno` set otherwise
+static int map_segment(const char * name, const unsigned char ** base, size_t * size) {
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+        close(fd);
+        return -1;
+    }
+    if ((size_t) status.st_size < sizeof(trixi_shm_header)) {
+        // the publisher has not sized the segment yet
+        close(fd);
+        errno = EAGAIN;
+        return -1;
+    }
+
+    void * ptr = mmap(NULL, status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) {
+        return -1;
+    }
+
+    // the publisher writes the magic number last, once the header is complete
+    const trixi_shm_header * header = ptr;
+    if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != TRIXI_SHM_MAGIC) {
+        munmap(ptr, status.st_size);
+        errno = EAGAIN;
+        return -1;
+    }
+    if (header->version != TRIXI_SHM_VERSION ||
+        header->slot_offset + header->nslots * header->slot_size >
+            (uint64_t) status.st_size) {
+        munmap(ptr, status.st_size);
+        errno = EPROTO;
+        return -1;
+    }
+
+    *base = ptr;
+    *size = status.st_size;
+
+    return 0;
+}
+
+
+/**
+ * @brief Open a shared-memory segment for reading snapshots
+ *
+ * @param[in]  name  name of the segment as passed to @ref trixi_set_shm_publication_api_c
+ *                   "trixi_set_shm_publication", with the suffix `.<rank>` if the
+ *                   simulation runs on several ranks
+ *
+ * @return consumer handle, or a null pointer with `errno` set if the segment does not exist
+ *         or is not complete yet (`EAGAIN`)
+ */
+trixi_shm_consumer * trixi_shm_open(const char * name) {
+
+    trixi_shm_consumer * consumer = malloc(sizeof(trixi_shm_consumer));
+    if (consumer == NULL) {
+        return NULL;
+    }
+
+    consumer->name = strdup(name);
+    if (consumer->name == NULL ||
+        map_segment(name, &consumer->base, &consumer->size) != 0) {
+        int error = errno;
+        free(consumer->name);
+        free(consumer);
+        errno = error;
+        return NULL;
+    }
+
+    return consumer;
+}
+
+
+/**
+ * @brief Unmap the segment and release the consumer
+ *
+ * @param[in]  consumer  consumer handle
+ */
+void trixi_shm_close(trixi_shm_consumer * consumer) {
+
+    if (consumer == NULL) {
+        return;
+    }
+
+    munmap((void *) consumer->base, consumer->size);
+    free(consumer->name);
+    free(consumer);
+}
+
+
+/**
+ * @brief Return the number of published variables
+ *
+ * @param[in]  consumer  consumer handle
+ */
+int trixi_shm_nvariables(const trixi_shm_consumer * consumer) {
+
+    const trixi_shm_header * header = (const trixi_shm_header *) consumer->base;
+    return header->nvariables;
+}
+
+
+/**
+ * @brief Return the indices of the published primitive variables
+ *
+ * @param[in]  consumer  consumer handle
+ */
+const int32_t * trixi_shm_variable_ids(const trixi_shm_consumer * consumer) {
+
+    return (const int32_t *) (consumer->base + sizeof(trixi_shm_header));
+}
+
+
+/**
+ * @brief Return 1 if the publisher will not publish further snapshots, 0 otherwise
+ *
+ * @param[in]  consumer  consumer handle
+ */
+int trixi_shm_is_closed(const trixi_shm_consumer * consumer) {
+
+    const trixi_shm_header * header = (const trixi_shm_header *) consumer->base;
+    return __atomic_load_n(&header->status, __ATOMIC_ACQUIRE) == TRIXI_SHM_CLOSED;
+}
+
+
+/**
+ * @brief Acquire the latest snapshot without copying it
+ *
+ * The data of the snapshot is read directly from the segment, variable `v` (counted from
+ * zero) of degree of freedom `i` is `data[v * stride + i]`. Since the publisher does not
+ * wait for consumers, the slot may be overwritten while it is read, which is the case if
+ * @ref trixi_shm_validate returns 0 after reading. If the publisher replaced the segment,
+ * e.g., because the mesh was refined, the new segment is mapped here, which invalidates all
+ * snapshots acquired before.
+ *
+ * @param[in]   consumer  consumer handle
+ * @param[out]  snapshot  latest snapshot
+ *
+ * @return `TRIXI_SHM_OK`, `TRIXI_SHM_EMPTY` if nothing was published yet, or
+ *         `TRIXI_SHM_ERROR` with `errno` set if a replaced segment cannot be mapped (yet)
+ *         or the latest slot is being written for too long (`EBUSY`)
+ */
+int trixi_shm_acquire(trixi_shm_consumer * consumer, trixi_shm_snapshot * snapshot) {
+
+    for (int attempt = 0; attempt < max_attempts; ++attempt) {
+        const trixi_shm_header * header = (const trixi_shm_header *) consumer->base;
+
+        if (__atomic_load_n(&header->status, __ATOMIC_ACQUIRE) == TRIXI_SHM_REPLACED) {
+            // keep the old segment until the new one is complete
+            const unsigned char * base;
+            size_t size;
+            if (map_segment(consumer->name, &base, &size) != 0) {
+                return TRIXI_SHM_ERROR;
+            }
+            munmap((void *) consumer->base, consumer->size);
+            consumer->base = base;
+            consumer->size = size;
+            continue;
+        }
+
+        uint64_t published = __atomic_load_n(&header->published, __ATOMIC_ACQUIRE);
+        if (published == 0) {
+            return TRIXI_SHM_EMPTY;
+        }
+
+        const trixi_shm_slot * slot = (const trixi_shm_slot *)
+            (consumer->base + header->slot_offset +
+             ((published - 1) % header->nslots) * header->slot_size);
+        uint64_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        if (sequence % 2 != 0) {
+            // the publisher has wrapped around and is writing this slot
+            continue;
+        }
+
+        snapshot->snapshot = slot->snapshot;
+        snapshot->time = slot->time;
+        snapshot->iter = slot->iter;
+        snapshot->mesh_epoch = slot->mesh_epoch;
+        snapshot->ndofs = slot->ndofs;
+        snapshot->nvariables = header->nvariables;
+        snapshot->data = (const double *) (slot + 1);
+        snapshot->stride = header->capacity;
+        snapshot->slot = slot;
+        snapshot->sequence = sequence;
+
+        if (trixi_shm_validate(snapshot)) {
+            return TRIXI_SHM_OK;
+        }
+    }
+
+    errno = EBUSY;
+    return TRIXI_SHM_ERROR;
+}
+
+
+/**
+ * @brief Check if a snapshot is still consistent
+ *
+ * @param[in]  snapshot  snapshot acquired by @ref trixi_shm_acquire
+ *
+ * @return 1 if the slot was not written since the snapshot was acquired, i.e., all data
+ *         read from it before this call is consistent, 0 otherwise
+ */
+int trixi_shm_validate(const trixi_shm_snapshot * snapshot) {
+
+    // order all reads of the snapshot before the read of the sequence number
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&snapshot->slot->sequence, __ATOMIC_RELAXED) ==
+           snapshot->sequence;
+}
+
+
+/**
+ * @brief Copy the latest consistent snapshot
+ *
+ * The variables are stored one after the other in `data`, i.e., variable `v` (counted from
+ * zero) of degree of freedom `i` is `data[v * snapshot->ndofs + i]`. Snapshots that are
+ * overwritten while they are copied are retried.
+ *
+ * @param[in]   consumer  consumer handle
+ * @param[out]  snapshot  metadata of the copied snapshot, its data pointer refers to the
+ *                        segment
+ * @param[out]  data      buffer for the values of all variables
+ * @param[in]   size      number of values that fit into `data`
+ *
+ * @return `TRIXI_SHM_OK`, `TRIXI_SHM_EMPTY` if nothing was published yet, or
+ *         `TRIXI_SHM_ERROR` with `errno` set, e.g., `ENOBUFS` if `data` is too small
+ */
+int trixi_shm_read(trixi_shm_consumer * consumer, trixi_shm_snapshot * snapshot,
+                   double * data, uint64_t size) {
+
+    for (;;) {
+        int ret = trixi_shm_acquire(consumer, snapshot);
+        if (ret != TRIXI_SHM_OK) {
+            return ret;
+        }
+
+        uint64_t ndofs = snapshot->ndofs;
+        if (ndofs > snapshot->stride || snapshot->nvariables * ndofs > size) {
+            if (!trixi_shm_validate(snapshot)) {
+                continue;
+            }
+            errno = ENOBUFS;
+            return TRIXI_SHM_ERROR;
+        }
+
+        for (int v = 0; v < snapshot->nvariables; ++v) {
+            memcpy(data + v * ndofs, snapshot->data + v * snapshot->stride,
+                   ndofs * sizeof(double));
+        }
+
+        if (trixi_shm_validate(snapshot)) {
+            return TRIXI_SHM_OK;
+        }
+    }
+}
@@ -0,0 +1,92 @@
+#ifndef TRIXI_SHM_H_
+#define TRIXI_SHM_H_
+
+#include <stdint.h>
+
+/**
+ * @addtogroup api_shm Shared-memory consumer API
+ *
+ * Read snapshots published by @ref trixi_set_shm_publication_api_c
+ * "trixi_set_shm_publication" from another process on the same compute node. This library
+ * does not depend on Julia or libtrixi.
+ *
+ * A segment starts with a @ref trixi_shm_header, followed by the ids of the published
+ * variables as `int32_t` and, at `slot_offset`, by `nslots` slots of `slot_size` bytes.
+ * Each slot starts with a @ref trixi_shm_slot, followed by the values of each variable for
+ * `capacity` degrees of freedom, of which the first `ndofs` are valid. The publisher
+ * increments the `sequence` of a slot before and after writing it, thus it is odd while
+ * the slot is written. A snapshot is consistent if the sequence is even and unchanged after
+ * reading it.
+ * @{
+*/
+
+#define TRIXI_SHM_MAGIC 0x4d48535849525254ULL
+#define TRIXI_SHM_VERSION 1
+
+// Status of a segment
+enum {
+    TRIXI_SHM_ACTIVE = 0,
+    TRIXI_SHM_REPLACED = 1,
+    TRIXI_SHM_CLOSED = 2
+};
+
+// Return codes of the consumer functions
+enum {
+    TRIXI_SHM_OK = 0,
+    TRIXI_SHM_EMPTY = 1,
+    TRIXI_SHM_ERROR = -1
+};
+
+typedef struct {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t nslots;
+    uint32_t nvariables;
+    uint32_t status;
+    uint64_t capacity;
+    uint64_t slot_offset;
+    uint64_t slot_size;
+    uint64_t published;
+    uint64_t reserved;
+} trixi_shm_header;
+
+typedef struct {
+    uint64_t sequence;
+    uint64_t snapshot;
+    double time;
+    int64_t iter;
+    int64_t mesh_epoch;
+    uint64_t ndofs;
+    uint64_t reserved[2];
+} trixi_shm_slot;
+
+typedef struct trixi_shm_consumer trixi_shm_consumer;
+
+typedef struct {
+    uint64_t snapshot;
+    double time;
+    int64_t iter;
+    int64_t mesh_epoch;
+    uint64_t ndofs;
+    int nvariables;
+    const double * data;
+    uint64_t stride;
+    const trixi_shm_slot * slot;
+    uint64_t sequence;
+} trixi_shm_snapshot;
+
+trixi_shm_consumer * trixi_shm_open(const char * name);
+void trixi_shm_close(trixi_shm_consumer * consumer);
+int trixi_shm_nvariables(const trixi_shm_consumer * consumer);
+const int32_t * trixi_shm_variable_ids(const trixi_shm_consumer * consumer);
+int trixi_shm_is_closed(const trixi_shm_consumer * consumer);
+int trixi_shm_acquire(trixi_shm_consumer * consumer, trixi_shm_snapshot * snapshot);
+int trixi_shm_validate(const trixi_shm_snapshot * snapshot);
+int trixi_shm_read(trixi_shm_consumer * consumer, trixi_shm_snapshot * snapshot,
+                   double * data, uint64_t size);
+
+/**
+ * @}
+ */
+
+#endif // ifndef TRIXI_SHM_H_
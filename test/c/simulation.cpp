@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include <mpi.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 extern "C" {
     #include "../src/trixi.h"
@@ -166,6 +169,47 @@ TEST(CInterfaceTest, SimulationRun) {
         FAIL() << "Test cannot be run with " << nranks << " ranks.";
     }
 
+    // Write solution to VTKHDF file (collectively)
+    const char * vtkhdf_path = "simulation_run.vtkhdf";
+    trixi_save_vtkhdf(handle, vtkhdf_path);
+    MPI_Barrier(comm);
+    struct stat vtkhdf_stat;
+    EXPECT_EQ(stat(vtkhdf_path, &vtkhdf_stat), 0);
+    EXPECT_GT(vtkhdf_stat.st_size, 0);
+
+    // Couple a second instance of the same simulation as child; since both are in the same
+    // state, nesting must not change the solution
+    int child_handle = trixi_initialize_simulation(libelixir_path);
+    for (int i = 0; i < 10; ++i) {
+        trixi_step(child_handle);
+    }
+    int nesting_handle = trixi_create_nesting(handle, child_handle, 0.1, 0.5);
+    EXPECT_EQ(nesting_handle, 1);
+    trixi_nesting_interpolate(nesting_handle);
+    trixi_nesting_feedback(nesting_handle);
+    std::vector<double> rho_nested(ndofs);
+    trixi_load_primitive_vars(child_handle, 1, rho_nested.data());
+    for (int i = 0; i < ndofs; ++i) {
+        EXPECT_NEAR(rho_nested[i], rho[i], 1e-12);
+    }
+    trixi_finalize_nesting(nesting_handle);
+    trixi_finalize_simulation(child_handle);
+
+    // SIGTERM is received by libtrixi and stops a simulation that handles signals with a
+    // checkpoint, instead of terminating the process
+    int preempted_handle = trixi_initialize_simulation(libelixir_path);
+    trixi_set_preemption(preempted_handle, 0.0, 1, "preemption_checkpoint");
+    trixi_step(preempted_handle);
+    EXPECT_EQ(trixi_is_preempted(preempted_handle), 0);
+    kill(getpid(), SIGTERM);
+    for (int i = 0; i < 100 && !trixi_is_preempted(preempted_handle); ++i) {
+        usleep(10000);
+        trixi_step(preempted_handle);
+    }
+    EXPECT_EQ(trixi_is_preempted(preempted_handle), 1);
+    EXPECT_EQ(trixi_is_finished(preempted_handle), 1);
+    trixi_finalize_simulation(preempted_handle);
+
     // Finalize Trixi simulation
     trixi_finalize_simulation(handle);
 
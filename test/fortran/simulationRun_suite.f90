@@ -24,7 +24,7 @@ module simulationRun_suite
     type(error_type), allocatable, intent(out) :: error
     integer :: handle, ndims, nelements, nelementsglobal, nvariables, ndofsglobal, &
                ndofselement, ndofs, size, nnodes, i
-    logical :: finished_status
+    logical :: finished_status, file_exists
     ! dp as defined in test-drive
     integer, parameter :: dp = selected_real_kind(15)
     real(dp) :: dt, time, integral
@@ -117,6 +117,11 @@ module simulationRun_suite
     call check(error, data(size), 1.0_dp)
     deallocate(data)
 
+    ! Write solution to VTKHDF file
+    call trixi_save_vtkhdf(handle, "simulation_run.vtkhdf")
+    inquire(file="simulation_run.vtkhdf", exist=file_exists)
+    call check(error, file_exists, .true.)
+
     ! Finalize Trixi simulation
     call trixi_finalize_simulation(handle)
     